@@ -0,0 +1,413 @@
+/* resdec - decompresses Nemesis and Kosinski files at build time and converts them to C header files */
+/* The output is tagged so the game copies it instead of decompressing it: */
+/* Nemesis - "RAWN", 16-bit tile count, tiles */
+/* Kosinski - "RAWK", 32-bit size, data */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define KOS_MAX 0x100000
+
+/* Nemesis decompressor (ported from the game's) */
+static const unsigned char *nem_source;
+static const unsigned char *nem_end;
+static unsigned char nem_dictionary[0x200];
+
+static unsigned char NemRead(void)
+{
+	/* Reads past the end return 0, the decompressor reads a little ahead */
+	if (nem_source >= nem_end)
+		return 0;
+	return *nem_source++;
+}
+
+static void NemPrepare(void)
+{
+	unsigned char d0, d1, d7;
+	size_t index;
+	unsigned int d5;
+
+	d7 = NemRead();
+
+	if (d7 == 0xFF)
+		return;
+
+	for (;;)
+	{
+		for (;;)
+		{
+			d0 = NemRead();
+
+			if (d0 < 0x80)
+				break;
+
+			if (d0 == 0xFF)
+				return;
+
+			d7 = d0;
+		}
+
+		d7 &= 0xF;
+		d7 |= d0 & 0x70;
+		d0 &= 0xF;
+
+		d1 = 8 - d0;
+
+		if (d1 == 0)
+		{
+			index = NemRead() * 2;
+
+			nem_dictionary[index] = d0;
+			nem_dictionary[index + 1] = d7;
+		}
+		else
+		{
+			index = ((size_t)NemRead() << d1) * 2;
+			d5 = (1 << d1) - 1;
+
+			do
+			{
+				if (index + 1 >= sizeof(nem_dictionary))
+					return;
+				nem_dictionary[index++] = d0;
+				nem_dictionary[index++] = d7;
+			} while (d5-- != 0);
+		}
+	}
+}
+
+static long NemDec(const unsigned char *in, long in_size, unsigned char **out)
+{
+	unsigned int header, remaining, d0, d1, d3, d5, d6;
+	unsigned long d2, d4;
+	size_t index;
+	int xor_mode;
+	unsigned char *destination;
+
+	if (in_size < 4)
+		return -1;
+
+	nem_source = in;
+	nem_end = in + in_size;
+	memset(nem_dictionary, 0, sizeof(nem_dictionary));
+
+	header = (NemRead() << 8);
+	header |= NemRead();
+	xor_mode = (header & 0x8000) != 0;
+	remaining = (header << 3) & 0xFFFF;
+
+	if ((*out = malloc(remaining * 4 + 1)) == NULL)
+		return -1;
+	destination = *out;
+
+	NemPrepare();
+
+	d5 = (NemRead() << 8);
+	d5 |= NemRead();
+	d6 = 0x10;
+	d0 = d1 = 0;
+	d2 = d4 = 0;
+	d3 = 8;
+
+	while (remaining != 0)
+	{
+		while (d0 != 0 && remaining != 0)
+		{
+			d0--;
+			d4 = ((d4 << 4) | d1) & 0xFFFFFFFFUL;
+
+			if (--d3 == 0)
+			{
+				if (xor_mode)
+					d4 = (d2 ^= d4);
+
+				*destination++ = (d4 >> 24) & 0xFF;
+				*destination++ = (d4 >> 16) & 0xFF;
+				*destination++ = (d4 >> 8) & 0xFF;
+				*destination++ = (d4 >> 0) & 0xFF;
+
+				remaining--;
+				d4 = 0;
+				d3 = 8;
+			}
+		}
+		if (remaining == 0)
+			break;
+
+		index = (d5 >> (d6 - 8)) & 0xFF;
+
+		if (index < 0xFC)
+		{
+			index *= 2;
+
+			d6 -= nem_dictionary[index];
+
+			if (d6 < 9)
+			{
+				d6 += 8;
+				d5 = ((d5 << 8) | NemRead()) & 0xFFFF;
+			}
+
+			d0 = d1 = nem_dictionary[index + 1];
+			d1 &= 0xF;
+			d0 &= 0xF0;
+		}
+		else
+		{
+			d6 -= 6;
+
+			if (d6 < 9)
+			{
+				d6 += 8;
+				d5 = ((d5 << 8) | NemRead()) & 0xFFFF;
+			}
+
+			d6 -= 7;
+
+			d0 = d1 = (d5 >> d6) & 0xFF;
+			d1 &= 0xF;
+			d0 &= 0x70;
+
+			if (d6 < 9)
+			{
+				d6 += 8;
+				d5 = ((d5 << 8) | NemRead()) & 0xFFFF;
+			}
+		}
+
+		d0 >>= 4;
+		++d0;
+	}
+
+	return (long)(destination - *out);
+}
+
+/* Kosinski decompressor (ported from the game's) */
+static const unsigned char *kos_source;
+static const unsigned char *kos_end;
+static unsigned int kos_field;
+static unsigned int kos_bits;
+
+static int KosRead(unsigned char *byte)
+{
+	if (kos_source >= kos_end)
+		return -1;
+	*byte = *kos_source++;
+	return 0;
+}
+
+static int KosRefresh(void)
+{
+	unsigned char lo, hi;
+	if (KosRead(&lo) || KosRead(&hi))
+		return -1;
+	kos_field = lo | (hi << 8);
+	kos_bits = 16;
+	return 0;
+}
+
+static int KosBit(void)
+{
+	int bit = kos_field & 1;
+
+	kos_field >>= 1;
+
+	if (--kos_bits == 0 && KosRefresh())
+		return -1;
+
+	return bit;
+}
+
+static long KosDec(const unsigned char *in, long in_size, unsigned char **out)
+{
+	unsigned char *destination;
+	unsigned char d0, d1;
+	unsigned long length;
+	long offset;
+	int bit;
+
+	kos_source = in;
+	kos_end = in + in_size;
+
+	if ((*out = malloc(KOS_MAX)) == NULL)
+		return -1;
+	destination = *out;
+
+	if (KosRefresh())
+		return -1;
+
+	for (;;)
+	{
+		if ((bit = KosBit()) < 0)
+			return -1;
+
+		if (bit)
+		{
+			if (destination >= *out + KOS_MAX || KosRead(destination))
+				return -1;
+			destination++;
+		}
+		else
+		{
+			length = 0;
+
+			if ((bit = KosBit()) < 0)
+				return -1;
+
+			if (!bit)
+			{
+				if ((bit = KosBit()) < 0)
+					return -1;
+				if (bit)
+					length += 2;
+
+				if ((bit = KosBit()) < 0)
+					return -1;
+				if (bit)
+					++length;
+
+				++length;
+
+				if (KosRead(&d0))
+					return -1;
+				offset = -0x100 + d0;
+			}
+			else
+			{
+				if (KosRead(&d0) || KosRead(&d1))
+					return -1;
+
+				offset = -0x2000 + (((d1 & 0xF8) << 5) | d0);
+				length = d1 & 7;
+
+				if (length != 0)
+				{
+					++length;
+				}
+				else
+				{
+					if (KosRead(&d0))
+						return -1;
+					length = d0;
+
+					if (length == 0)
+						break;
+
+					if (length == 1)
+						continue;
+				}
+			}
+
+			if (destination + offset < *out || destination + length + 1 > *out + KOS_MAX)
+				return -1;
+
+			do
+			{
+				*destination = destination[offset];
+				++destination;
+			} while (length-- != 0);
+		}
+	}
+
+	return (long)(destination - *out);
+}
+
+/* Header output (same format as bin2h) */
+static void WriteHeader(FILE *out_file, const unsigned char *tag, size_t tag_size, const unsigned char *data, long size)
+{
+	long i, total = (long)tag_size + size;
+
+	setvbuf(out_file, NULL, _IOFBF, 0x10000);
+
+	for (i = 0; i < total; ++i)
+	{
+		unsigned char byte = (i < (long)tag_size) ? tag[i] : data[i - (long)tag_size];
+
+		if (i == total - 1)
+			fprintf(out_file, "%d\n", byte);
+		else if (i % 64 == 64-1)
+			fprintf(out_file, "%d,\n", byte);
+		else
+			fprintf(out_file, "%d,", byte);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *in_file, *out_file;
+	long in_file_size, out_size;
+	unsigned char *in_file_buffer;
+	unsigned char *out_buffer = NULL;
+	unsigned char tag[8];
+	size_t tag_size;
+	int nemesis;
+
+	if (argc <= 3 || (strcmp(argv[1], "nem") != 0 && strcmp(argv[1], "kos") != 0))
+	{
+		printf("Usage: resdec <nem/kos> <in> <out>\n");
+		return 1;
+	}
+	nemesis = strcmp(argv[1], "nem") == 0;
+
+	/* Read compressed file */
+	if ((in_file = fopen(argv[2], "rb")) == NULL)
+	{
+		printf("Couldn't open '%s'\n", argv[2]);
+		return 1;
+	}
+
+	fseek(in_file, 0, SEEK_END);
+	in_file_size = ftell(in_file);
+	rewind(in_file);
+	if ((in_file_buffer = malloc(in_file_size + 1)) == NULL || fread(in_file_buffer, 1, in_file_size, in_file) < (size_t)in_file_size)
+	{
+		printf("Couldn't read '%s'\n", argv[2]);
+		fclose(in_file);
+		return 1;
+	}
+	fclose(in_file);
+
+	/* Decompress and tag */
+	if (nemesis)
+	{
+		out_size = NemDec(in_file_buffer, in_file_size, &out_buffer);
+		memcpy(tag, "RAWN", 4);
+		tag[4] = (unsigned char)((out_size / 0x20) >> 8);
+		tag[5] = (unsigned char)(out_size / 0x20);
+		tag_size = 6;
+	}
+	else
+	{
+		out_size = KosDec(in_file_buffer, in_file_size, &out_buffer);
+		memcpy(tag, "RAWK", 4);
+		tag[4] = (unsigned char)(out_size >> 24);
+		tag[5] = (unsigned char)(out_size >> 16);
+		tag[6] = (unsigned char)(out_size >> 8);
+		tag[7] = (unsigned char)out_size;
+		tag_size = 8;
+	}
+	free(in_file_buffer);
+
+	if (out_size < 0)
+	{
+		printf("Couldn't decompress '%s'\n", argv[2]);
+		free(out_buffer);
+		return 1;
+	}
+
+	/* Write header */
+	if ((out_file = fopen(argv[3], "w")) == NULL)
+	{
+		printf("Couldn't open '%s'\n", argv[3]);
+		free(out_buffer);
+		return 1;
+	}
+
+	WriteHeader(out_file, tag, tag_size, out_buffer, out_size);
+
+	fclose(out_file);
+	free(out_buffer);
+	return 0;
+}
@@ -0,0 +1,185 @@
+/* respack - packs resource files into a resource pack, and writes the headers that refer to them */
+/* Pack - "SCPK", 32-bit entry count, index of 0x40 byte entries sorted by name (name, 32-bit offset, 32-bit size), data aligned to 0x10 bytes (all little endian) */
+/* Name header - "RESP", name, 0 (in bin2h's format, compiled in where the resource's data would be) */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PACK_NAME  0x38
+#define PACK_ENTRY 0x40
+#define PACK_ALIGN 0x10
+
+typedef struct
+{
+	const char *name;
+	unsigned char *data;
+	long size;
+	unsigned long offset;
+} Entry;
+
+static int CompareEntry(const void *a, const void *b)
+{
+	return strcmp(((const Entry*)a)->name, ((const Entry*)b)->name);
+}
+
+static void Write32(unsigned char *p, unsigned long v)
+{
+	p[0] = (unsigned char)v;
+	p[1] = (unsigned char)(v >> 8);
+	p[2] = (unsigned char)(v >> 16);
+	p[3] = (unsigned char)(v >> 24);
+}
+
+static unsigned char *ReadFile(const char *path, long *size)
+{
+	FILE *in_file;
+	unsigned char *buffer;
+
+	if ((in_file = fopen(path, "rb")) == NULL)
+		return NULL;
+
+	fseek(in_file, 0, SEEK_END);
+	*size = ftell(in_file);
+	rewind(in_file);
+	if (*size < 0 || (buffer = malloc(*size + 1)) == NULL || fread(buffer, 1, *size, in_file) < (size_t)*size)
+	{
+		fclose(in_file);
+		return NULL;
+	}
+	fclose(in_file);
+	return buffer;
+}
+
+/* Name header (same format as bin2h) */
+static int WriteName(const char *name, const char *out_path)
+{
+	FILE *out_file;
+	size_t i;
+
+	if ((out_file = fopen(out_path, "w")) == NULL)
+	{
+		printf("Couldn't open '%s'\n", out_path);
+		return 1;
+	}
+
+	fprintf(out_file, "%d,%d,%d,%d,", 'R', 'E', 'S', 'P');
+	for (i = 0; name[i] != '\0'; ++i)
+		fprintf(out_file, "%d,", (unsigned char)name[i]);
+	fprintf(out_file, "0\n");
+
+	fclose(out_file);
+	return 0;
+}
+
+/* Pack */
+static int WritePack(const char *out_path, const char *in_dir, char **names, int count)
+{
+	FILE *out_file;
+	Entry *entries;
+	unsigned char *index;
+	unsigned long offset;
+	size_t index_size;
+	char path[0x400];
+	char tmp_path[0x400];
+	int i;
+
+	if ((entries = malloc(sizeof(Entry) * (count + 1))) == NULL)
+		return 1;
+
+	/* Read resources */
+	for (i = 0; i < count; ++i)
+	{
+		if (strlen(names[i]) >= PACK_NAME || strlen(in_dir) + strlen(names[i]) + 2 > sizeof(path))
+		{
+			printf("Name '%s' is too long\n", names[i]);
+			return 1;
+		}
+		sprintf(path, "%s/%s", in_dir, names[i]);
+
+		entries[i].name = names[i];
+		if ((entries[i].data = ReadFile(path, &entries[i].size)) == NULL)
+		{
+			printf("Couldn't read '%s'\n", path);
+			return 1;
+		}
+	}
+
+	/* Sort them by name, so the game can binary search the index */
+	qsort(entries, count, sizeof(Entry), CompareEntry);
+
+	/* Lay out data after the index */
+	index_size = 8 + (size_t)count * PACK_ENTRY;
+	if ((index = calloc(index_size, 1)) == NULL)
+		return 1;
+	memcpy(index, "SCPK", 4);
+	Write32(index + 4, count);
+
+	offset = (index_size + PACK_ALIGN - 1) & ~(unsigned long)(PACK_ALIGN - 1);
+	for (i = 0; i < count; ++i)
+	{
+		unsigned char *entry = index + 8 + (size_t)i * PACK_ENTRY;
+		entries[i].offset = offset;
+		strcpy((char*)entry, entries[i].name);
+		Write32(entry + PACK_NAME, offset);
+		Write32(entry + PACK_NAME + 4, entries[i].size);
+		offset = (offset + entries[i].size + PACK_ALIGN - 1) & ~(unsigned long)(PACK_ALIGN - 1);
+	}
+
+	/* Write pack to a temporary file, so a running game that has the old pack mapped never sees a partly written one */
+	if (strlen(out_path) + 5 > sizeof(tmp_path))
+	{
+		printf("Path '%s' is too long\n", out_path);
+		return 1;
+	}
+	sprintf(tmp_path, "%s.tmp", out_path);
+	if ((out_file = fopen(tmp_path, "wb")) == NULL)
+	{
+		printf("Couldn't open '%s'\n", tmp_path);
+		return 1;
+	}
+
+	fwrite(index, 1, index_size, out_file);
+	offset = index_size;
+	for (i = 0; i < count; ++i)
+	{
+		while (offset < entries[i].offset)
+		{
+			fputc(0, out_file);
+			++offset;
+		}
+		fwrite(entries[i].data, 1, entries[i].size, out_file);
+		offset += entries[i].size;
+		free(entries[i].data);
+	}
+
+	if (ferror(out_file) | fclose(out_file))
+	{
+		printf("Couldn't write '%s'\n", tmp_path);
+		remove(tmp_path);
+		return 1;
+	}
+	free(index);
+	free(entries);
+
+	/* Replace the old pack in one step (rename can't replace an existing file on Windows, so remove it first there) */
+	if (rename(tmp_path, out_path) != 0 && (remove(out_path) != 0 || rename(tmp_path, out_path) != 0))
+	{
+		printf("Couldn't replace '%s'\n", out_path);
+		remove(tmp_path);
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc >= 4 && strcmp(argv[1], "name") == 0)
+		return WriteName(argv[2], argv[argc - 1]);
+	if (argc >= 4 && strcmp(argv[1], "pack") == 0)
+		return WritePack(argv[2], argv[3], argv + 4, argc - 4);
+
+	printf("Usage: respack name <name> [in] <out>\n       respack pack <out> <in dir> <names...>\n");
+	return 1;
+}
@@ -0,0 +1,18 @@
+#include "../Joypad.h"
+
+//Backend input interface
+int Input_HandleEvents()
+{
+	return 0;
+}
+
+uint8_t Input_GetState1()
+{
+	//No input (use a trace to play back input)
+	return 0;
+}
+
+uint8_t Input_GetState2()
+{
+	return 0;
+}
@@ -0,0 +1,19 @@
+#include "../VDP.h"
+
+//Backend render interface
+//The headless backend runs as fast as possible and never presents the screen (for traces and benchmarking)
+int Render_Init(const MD_Header *header)
+{
+	(void)header;
+	return 0;
+}
+
+void Render_Quit()
+{
+	
+}
+
+void Render_Screen(const uint32_t *screen)
+{
+	(void)screen;
+}
@@ -0,0 +1,13 @@
+#include "../MegaDrive.h"
+
+//System interface
+int System_Init(const MD_Header *header)
+{
+	(void)header;
+	return 0;
+}
+
+void System_Quit()
+{
+	
+}
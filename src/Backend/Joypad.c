@@ -1,5 +1,7 @@
 #include "Joypad.h"
 
+#include "Trace.h"
+
 //Backend input interface
 uint8_t Input_GetState1();
 uint8_t Input_GetState2();
@@ -7,10 +9,10 @@ uint8_t Input_GetState2();
 //Joypad information
 uint8_t Joypad_GetState1()
 {
-	return Input_GetState1();
+	return Trace_Input(0, Input_GetState1());
 }
 
 uint8_t Joypad_GetState2()
 {
-	return Input_GetState2();
+	return Trace_Input(1, Input_GetState2());
 }
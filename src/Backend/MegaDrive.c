@@ -1,6 +1,7 @@
 #include "MegaDrive.h"
 
 #include "VDP.h"
+#include "Trace.h"
 
 //System backend interface
 int System_Init(const MD_Header *header);
@@ -20,13 +21,17 @@ int MegaDrive_Start(const MD_Header *header)
 	}
 	
 	//Quit MegaDrive subsystems
-	MegaDrive_Quit();
+	if (MegaDrive_Quit())
+		result = -1;
 	return result;
 }
 
-void MegaDrive_Quit()
+int MegaDrive_Quit()
 {
 	//Quit MegaDrive subsystems
 	VDP_Quit();
 	System_Quit();
+	
+	//Finish trace (fails if the frames didn't match the golden trace)
+	return Trace_Close();
 }
@@ -0,0 +1,268 @@
+#if defined(__unix__) || defined(__APPLE__)
+	#define _POSIX_C_SOURCE 200112L
+	#define NET_POSIX
+#endif
+
+#include "Net.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef NET_POSIX
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <arpa/inet.h>
+	#include <netdb.h>
+	#include <poll.h>
+	#include <unistd.h>
+#endif
+
+//Network constants
+#define NET_PACKET_MAX 0x200
+#define NET_SIM_QUEUE  0x40
+
+//Network clock
+uint32_t Net_Ticks()
+{
+	#ifdef NET_POSIX
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (uint32_t)ts.tv_sec * 1000 + (uint32_t)(ts.tv_nsec / 1000000);
+	#else
+		return (uint32_t)((uint64_t)clock() * 1000 / CLOCKS_PER_SEC);
+	#endif
+}
+
+//UDP transport
+#ifdef NET_POSIX
+typedef struct
+{
+	NetTransport net;
+	int sock;
+	struct sockaddr_in remote;
+} NetUDP;
+
+static int NetUDP_Send(NetTransport *net, const void *data, size_t len)
+{
+	NetUDP *udp = (NetUDP*)net;
+	if (sendto(udp->sock, data, len, 0, (const struct sockaddr*)&udp->remote, sizeof(udp->remote)) < 0)
+		return -1;
+	return 0;
+}
+
+static long NetUDP_Recv(NetTransport *net, void *data, size_t len, int timeout)
+{
+	NetUDP *udp = (NetUDP*)net;
+	
+	//Wait for a datagram
+	struct pollfd pfd = {udp->sock, POLLIN, 0};
+	int ready = poll(&pfd, 1, timeout);
+	if (ready < 0)
+		return -1;
+	if (ready == 0)
+		return 0;
+	
+	//Read datagram (ignore anything that isn't from our peer)
+	struct sockaddr_in from;
+	socklen_t from_len = sizeof(from);
+	ssize_t got = recvfrom(udp->sock, data, len, 0, (struct sockaddr*)&from, &from_len);
+	if (got < 0)
+		return -1;
+	if (from.sin_port != udp->remote.sin_port || from.sin_addr.s_addr != udp->remote.sin_addr.s_addr)
+		return 0;
+	return (long)got;
+}
+
+static void NetUDP_Close(NetTransport *net)
+{
+	NetUDP *udp = (NetUDP*)net;
+	close(udp->sock);
+	free(udp);
+}
+#endif
+
+NetTransport *Net_OpenUDP(uint16_t port, const char *host, uint16_t remote_port)
+{
+	#ifdef NET_POSIX
+		//Allocate transport
+		NetUDP *udp = malloc(sizeof(NetUDP));
+		if (udp == NULL)
+		{
+			printf("Net_OpenUDP: Failed to allocate transport\n");
+			return NULL;
+		}
+		udp->net.send = NetUDP_Send;
+		udp->net.recv = NetUDP_Recv;
+		udp->net.close = NetUDP_Close;
+		
+		//Resolve remote address
+		struct addrinfo hints, *res;
+		memset(&hints, 0, sizeof(hints));
+		hints.ai_family = AF_INET;
+		hints.ai_socktype = SOCK_DGRAM;
+		if (getaddrinfo(host, NULL, &hints, &res) != 0)
+		{
+			printf("Net_OpenUDP: Failed to resolve %s\n", host);
+			free(udp);
+			return NULL;
+		}
+		memcpy(&udp->remote, res->ai_addr, sizeof(udp->remote));
+		udp->remote.sin_port = htons(remote_port);
+		freeaddrinfo(res);
+		
+		//Open and bind socket
+		if ((udp->sock = socket(AF_INET, SOCK_DGRAM, 0)) < 0)
+		{
+			printf("Net_OpenUDP: Failed to open socket\n");
+			free(udp);
+			return NULL;
+		}
+		
+		struct sockaddr_in local;
+		memset(&local, 0, sizeof(local));
+		local.sin_family = AF_INET;
+		local.sin_addr.s_addr = htonl(INADDR_ANY);
+		local.sin_port = htons(port);
+		if (bind(udp->sock, (const struct sockaddr*)&local, sizeof(local)) < 0)
+		{
+			printf("Net_OpenUDP: Failed to bind port %u\n", port);
+			close(udp->sock);
+			free(udp);
+			return NULL;
+		}
+		
+		return &udp->net;
+	#else
+		(void)port;
+		(void)host;
+		(void)remote_port;
+		printf("Net_OpenUDP: UDP isn't supported on this platform\n");
+		return NULL;
+	#endif
+}
+
+//Latency and jitter simulator
+//Holds received datagrams back for 'latency' +/- 'jitter' milliseconds (which may reorder them), and drops 'loss' percent of sent datagrams
+typedef struct
+{
+	uint32_t time;
+	size_t len;
+	uint8_t data[NET_PACKET_MAX];
+} NetSimPacket;
+
+typedef struct
+{
+	NetTransport net;
+	NetTransport *inner;
+	
+	unsigned int latency, jitter, loss;
+	uint32_t seed;
+	
+	NetSimPacket queue[NET_SIM_QUEUE];
+	size_t queue_len;
+} NetSim;
+
+static uint32_t NetSim_Random(NetSim *sim)
+{
+	//xorshift32
+	sim->seed ^= sim->seed << 13;
+	sim->seed ^= sim->seed >> 17;
+	sim->seed ^= sim->seed << 5;
+	return sim->seed;
+}
+
+static int NetSim_Send(NetTransport *net, const void *data, size_t len)
+{
+	NetSim *sim = (NetSim*)net;
+	if ((NetSim_Random(sim) % 100) < sim->loss)
+		return 0;
+	return sim->inner->send(sim->inner, data, len);
+}
+
+static void NetSim_Pump(NetSim *sim, int timeout)
+{
+	//Queue datagrams from the inner transport with their delivery time
+	long got;
+	uint8_t data[NET_PACKET_MAX];
+	while ((got = sim->inner->recv(sim->inner, data, sizeof(data), timeout)) > 0)
+	{
+		timeout = 0;
+		if (sim->queue_len >= NET_SIM_QUEUE)
+			continue;
+		
+		NetSimPacket *packet = &sim->queue[sim->queue_len++];
+		packet->time = Net_Ticks() + sim->latency;
+		if (sim->jitter != 0)
+			packet->time += NetSim_Random(sim) % (sim->jitter * 2 + 1) - sim->jitter;
+		packet->len = (size_t)got;
+		memcpy(packet->data, data, packet->len);
+	}
+}
+
+static long NetSim_Recv(NetTransport *net, void *data, size_t len, int timeout)
+{
+	NetSim *sim = (NetSim*)net;
+	uint32_t start = Net_Ticks();
+	
+	while (1)
+	{
+		//Deliver the earliest due datagram
+		NetSim_Pump(sim, 0);
+		
+		uint32_t now = Net_Ticks();
+		size_t due = sim->queue_len;
+		for (size_t i = 0; i < sim->queue_len; i++)
+			if ((int32_t)(now - sim->queue[i].time) >= 0 && (due == sim->queue_len || (int32_t)(sim->queue[i].time - sim->queue[due].time) < 0))
+				due = i;
+		
+		if (due != sim->queue_len)
+		{
+			NetSimPacket *packet = &sim->queue[due];
+			size_t got = (packet->len < len) ? packet->len : len;
+			memcpy(data, packet->data, got);
+			*packet = sim->queue[--sim->queue_len];
+			return (long)got;
+		}
+		
+		//Wait for more datagrams
+		int32_t left = (int32_t)timeout - (int32_t)(now - start);
+		if (left <= 0)
+			return 0;
+		NetSim_Pump(sim, (left > 1) ? 1 : left);
+	}
+}
+
+static void NetSim_Close(NetTransport *net)
+{
+	NetSim *sim = (NetSim*)net;
+	sim->inner->close(sim->inner);
+	free(sim);
+}
+
+NetTransport *Net_OpenSim(NetTransport *inner, unsigned int latency, unsigned int jitter, unsigned int loss)
+{
+	//Allocate transport
+	NetSim *sim = malloc(sizeof(NetSim));
+	if (sim == NULL)
+	{
+		printf("Net_OpenSim: Failed to allocate transport\n");
+		inner->close(inner);
+		return NULL;
+	}
+	sim->net.send = NetSim_Send;
+	sim->net.recv = NetSim_Recv;
+	sim->net.close = NetSim_Close;
+	
+	//Initialize simulator
+	sim->inner = inner;
+	sim->latency = latency;
+	sim->jitter = (jitter > latency) ? latency : jitter;
+	sim->loss = loss;
+	sim->seed = 0x2545F491;
+	sim->queue_len = 0;
+	
+	return &sim->net;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+//Network transport
+typedef struct NetTransport
+{
+	//Sends a datagram, returns 0 on success
+	int (*send)(struct NetTransport *net, const void *data, size_t len);
+	//Receives a datagram, waiting up to 'timeout' milliseconds, returns its length, 0 if none arrived, or -1 on error
+	long (*recv)(struct NetTransport *net, void *data, size_t len, int timeout);
+	//Closes and frees the transport
+	void (*close)(struct NetTransport *net);
+} NetTransport;
+
+//Network interface
+uint32_t Net_Ticks();
+
+NetTransport *Net_OpenUDP(uint16_t port, const char *host, uint16_t remote_port);
+NetTransport *Net_OpenSim(NetTransport *inner, unsigned int latency, unsigned int jitter, unsigned int loss);
@@ -0,0 +1,247 @@
+#if defined(__unix__) || defined(__APPLE__)
+	#define _POSIX_C_SOURCE 200112L
+	#define RESPACK_POSIX
+#endif
+
+#include "ResPack.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef RESPACK_POSIX
+	#include <sys/types.h>
+	#include <sys/stat.h>
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+//Resource pack format
+//"SCPK", 32-bit entry count, then an index of 0x40 byte entries sorted by name (name, 32-bit offset, 32-bit size), then the data (all little endian)
+#define RESPACK_NAME  0x38
+#define RESPACK_ENTRY 0x40
+#define RESPACK_PATH  0x400
+#define RESPACK_REQUIRED 0x100
+
+static const uint8_t *respack_data;
+static size_t respack_size;
+static size_t respack_entries;
+
+static char respack_path[RESPACK_PATH];
+#ifdef RESPACK_POSIX
+	static struct stat respack_stat;
+#endif
+
+//Resources the game needs from every pack
+static struct
+{
+	const char *name;
+	size_t max_size;
+	ResPack_CheckFunc check;
+} respack_required[RESPACK_REQUIRED];
+static size_t respack_required_num;
+
+static uint32_t ResPack_Read32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static const uint8_t *ResPack_Find(const uint8_t *data, size_t entries, const char *name, size_t *size)
+{
+	//Find entry (the index is sorted by name)
+	size_t lo = 0, hi = entries;
+	while (lo < hi)
+	{
+		size_t mid = (lo + hi) / 2;
+		const uint8_t *entry = data + 8 + mid * RESPACK_ENTRY;
+		int cmp = strcmp(name, (const char*)entry);
+		if (cmp == 0)
+		{
+			if (size != NULL)
+				*size = ResPack_Read32(entry + RESPACK_NAME + 4);
+			return data + ResPack_Read32(entry + RESPACK_NAME);
+		}
+		if (cmp < 0)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	return NULL;
+}
+
+int ResPack_Require(const uint8_t *res, size_t max_size, ResPack_CheckFunc check)
+{
+	//Untagged resources are compiled in
+	if (res == NULL || memcmp(res, "RESP", 4))
+		return 0;
+	
+	if (respack_required_num >= RESPACK_REQUIRED)
+	{
+		printf("ResPack_Require: Too many required resources\n");
+		return -1;
+	}
+	respack_required[respack_required_num].name = (const char*)res + 4;
+	respack_required[respack_required_num].max_size = max_size;
+	respack_required[respack_required_num].check = check;
+	respack_required_num++;
+	return 0;
+}
+
+static int ResPack_Check(const char *path, const uint8_t *data, size_t size)
+{
+	//Check header and index
+	if (size < 8 || memcmp(data, "SCPK", 4))
+		return -1;
+	size_t entries = ResPack_Read32(data + 4);
+	if (entries > (size - 8) / RESPACK_ENTRY)
+		return -1;
+	
+	//Check every entry's data is in the pack
+	for (size_t i = 0; i < entries; i++)
+	{
+		const uint8_t *entry = data + 8 + i * RESPACK_ENTRY;
+		size_t offset = ResPack_Read32(entry + RESPACK_NAME);
+		size_t length = ResPack_Read32(entry + RESPACK_NAME + 4);
+		if (entry[RESPACK_NAME - 1] != '\0' || offset > size || length > size - offset)
+			return -1;
+	}
+	
+	//Check every required resource is there and fits where it's loaded to
+	for (size_t i = 0; i < respack_required_num; i++)
+	{
+		size_t length;
+		const uint8_t *res = ResPack_Find(data, entries, respack_required[i].name, &length);
+		if (res == NULL)
+		{
+			printf("ResPack_Check: %s is missing %s\n", path, respack_required[i].name);
+			return -1;
+		}
+		if (length > respack_required[i].max_size || (respack_required[i].check != NULL && !respack_required[i].check(res, length)))
+		{
+			printf("ResPack_Check: %s has an invalid %s\n", path, respack_required[i].name);
+			return -1;
+		}
+	}
+	return 0;
+}
+
+int ResPack_Open(const char *path)
+{
+	const uint8_t *data;
+	size_t size;
+	
+	#ifdef RESPACK_POSIX
+		//Map pack, its pages are only read in once they're used
+		int fd = open(path, O_RDONLY);
+		if (fd < 0)
+		{
+			printf("ResPack_Open: Failed to open %s\n", path);
+			return -1;
+		}
+		
+		struct stat st;
+		if (fstat(fd, &st) < 0 || st.st_size <= 0)
+		{
+			printf("ResPack_Open: Failed to read %s\n", path);
+			close(fd);
+			return -1;
+		}
+		size = (size_t)st.st_size;
+		
+		void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (map == MAP_FAILED)
+		{
+			printf("ResPack_Open: Failed to map %s\n", path);
+			return -1;
+		}
+		data = (const uint8_t*)map;
+	#else
+		//Read pack
+		FILE *fp = fopen(path, "rb");
+		if (fp == NULL)
+		{
+			printf("ResPack_Open: Failed to open %s\n", path);
+			return -1;
+		}
+		
+		fseek(fp, 0, SEEK_END);
+		long length = ftell(fp);
+		rewind(fp);
+		uint8_t *buffer;
+		if (length <= 0 || (buffer = malloc((size_t)length)) == NULL || fread(buffer, 1, (size_t)length, fp) != (size_t)length)
+		{
+			printf("ResPack_Open: Failed to read %s\n", path);
+			fclose(fp);
+			return -1;
+		}
+		fclose(fp);
+		data = buffer;
+		size = (size_t)length;
+	#endif
+	
+	if (ResPack_Check(path, data, size))
+	{
+		printf("ResPack_Open: %s isn't a valid resource pack\n", path);
+		#ifdef RESPACK_POSIX
+			munmap((void*)data, size);
+		#else
+			free((void*)data);
+		#endif
+		return -1;
+	}
+	
+	//Use the new pack
+	//The old one is left mapped, savestates and caches can still point into it
+	respack_data = data;
+	respack_size = size;
+	respack_entries = ResPack_Read32(data + 4);
+	
+	if (path != respack_path)
+	{
+		strncpy(respack_path, path, RESPACK_PATH - 1);
+		respack_path[RESPACK_PATH - 1] = '\0';
+	}
+	#ifdef RESPACK_POSIX
+		stat(respack_path, &respack_stat);
+	#endif
+	return 0;
+}
+
+int ResPack_Reload()
+{
+	//Open the pack again if it's been replaced, returns 1 if it was
+	#ifdef RESPACK_POSIX
+		struct stat st;
+		if (respack_data == NULL || stat(respack_path, &st) < 0)
+			return 0;
+		if (st.st_mtime == respack_stat.st_mtime && st.st_size == respack_stat.st_size && st.st_ino == respack_stat.st_ino)
+			return 0;
+		if (ResPack_Open(respack_path))
+		{
+			//Keep the old pack, and don't try this version again
+			respack_stat = st;
+			return 0;
+		}
+		return 1;
+	#else
+		return 0;
+	#endif
+}
+
+const uint8_t *ResPack_Get(const uint8_t *res, size_t *size)
+{
+	//Untagged resources are compiled in
+	if (res == NULL || memcmp(res, "RESP", 4))
+		return res;
+	const char *name = (const char*)res + 4;
+	
+	//Find entry
+	const uint8_t *data = ResPack_Find(respack_data, respack_entries, name, size);
+	if (data != NULL)
+		return data;
+	
+	printf("ResPack_Get: %s isn't in the resource pack\n", name);
+	return NULL;
+}
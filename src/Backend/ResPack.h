@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//Resource pack interface
+//Resources built into the pack are compiled in as a "RESP" tag followed by their name, ResPack_Get looks them up in the pack
+//Packs missing a required resource, or with one that's too large or fails its check, are rejected
+typedef bool (*ResPack_CheckFunc)(const uint8_t *data, size_t size);
+
+int ResPack_Require(const uint8_t *res, size_t max_size, ResPack_CheckFunc check);
+int ResPack_Open(const char *path);
+int ResPack_Reload();
+
+const uint8_t *ResPack_Get(const uint8_t *res, size_t *size);
@@ -0,0 +1,133 @@
+#if defined(__unix__) || defined(__APPLE__)
+	#define _POSIX_C_SOURCE 200112L
+	#define THREAD_POSIX
+#endif
+
+#include "Thread.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef THREAD_POSIX
+	#include <pthread.h>
+#endif
+
+//Thread constants
+#define THREAD_WORKERS 4
+
+//Job pool
+#ifdef THREAD_POSIX
+struct ThreadJob
+{
+	void (*func)(void *arg);
+	void *arg;
+	bool done;
+	struct ThreadJob *next;
+};
+
+static pthread_mutex_t job_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_queued = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t job_finished = PTHREAD_COND_INITIALIZER;
+static ThreadJob *job_head, *job_tail;
+static unsigned int job_workers;
+
+static void *Thread_Worker(void *arg)
+{
+	(void)arg;
+	
+	pthread_mutex_lock(&job_mutex);
+	for (;;)
+	{
+		//Wait for a job
+		while (job_head == NULL)
+			pthread_cond_wait(&job_queued, &job_mutex);
+		
+		ThreadJob *job = job_head;
+		if ((job_head = job->next) == NULL)
+			job_tail = NULL;
+		
+		//Run job
+		pthread_mutex_unlock(&job_mutex);
+		job->func(job->arg);
+		pthread_mutex_lock(&job_mutex);
+		
+		job->done = true;
+		pthread_cond_broadcast(&job_finished);
+	}
+	return NULL;
+}
+#endif
+
+ThreadJob *Thread_StartJob(void (*func)(void *arg), void *arg)
+{
+	#ifdef THREAD_POSIX
+		ThreadJob *job = malloc(sizeof(ThreadJob));
+		if (job != NULL)
+		{
+			job->func = func;
+			job->arg = arg;
+			job->done = false;
+			job->next = NULL;
+			
+			pthread_mutex_lock(&job_mutex);
+			
+			//Start another worker until the pool is full
+			if (job_workers < THREAD_WORKERS)
+			{
+				pthread_t thread;
+				if (pthread_create(&thread, NULL, Thread_Worker, NULL) == 0)
+				{
+					pthread_detach(thread);
+					job_workers++;
+				}
+			}
+			
+			//Queue job
+			if (job_workers != 0)
+			{
+				if (job_tail != NULL)
+					job_tail->next = job;
+				else
+					job_head = job;
+				job_tail = job;
+				pthread_cond_signal(&job_queued);
+				pthread_mutex_unlock(&job_mutex);
+				return job;
+			}
+			
+			pthread_mutex_unlock(&job_mutex);
+			free(job);
+		}
+	#endif
+	
+	//Run here instead
+	func(arg);
+	return NULL;
+}
+
+void Thread_WaitJob(ThreadJob *job)
+{
+	if (job == NULL)
+		return;
+	
+	#ifdef THREAD_POSIX
+		pthread_mutex_lock(&job_mutex);
+		while (!job->done)
+			pthread_cond_wait(&job_finished, &job_mutex);
+		pthread_mutex_unlock(&job_mutex);
+		free(job);
+	#endif
+}
+
+//Thread clock
+uint64_t Thread_Micros()
+{
+	#ifdef THREAD_POSIX
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)(ts.tv_nsec / 1000);
+	#else
+		return (uint64_t)clock() * 1000000 / CLOCKS_PER_SEC;
+	#endif
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stdint.h>
+
+//Thread interface
+//Jobs run on a small pool of worker threads, on platforms without threads (or if a job can't be queued) Thread_StartJob runs it itself before returning NULL
+typedef struct ThreadJob ThreadJob;
+
+ThreadJob *Thread_StartJob(void (*func)(void *arg), void *arg);
+void Thread_WaitJob(ThreadJob *job);
+
+//Thread clock (wall time, process CPU time would add up every thread)
+uint64_t Thread_Micros();
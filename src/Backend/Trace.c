@@ -0,0 +1,233 @@
+#include "Trace.h"
+
+#include "Constants.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+//Trace hash constants (64-bit multiply-xorshift, processes two pixels at a time)
+#define TRACE_HASH_SEED  UINT64_C(0xCBF29CE484222325)
+#define TRACE_HASH_PRIME UINT64_C(0x9E3779B97F4A7C15)
+
+//Trace frame
+typedef struct
+{
+	uint64_t hash;
+	uint8_t input[2];
+} TraceFrame;
+
+//Trace state
+static TraceMode trace_mode;
+static FILE *trace_file;
+
+static TraceFrame *trace_frames;
+static unsigned long trace_frames_len;
+
+static unsigned long trace_frame, trace_limit;
+static unsigned long trace_mismatches;
+static uint8_t trace_input[2];
+
+static uint64_t trace_hash;
+static unsigned long trace_repeat, trace_softlock;
+static bool trace_softlocked;
+
+//Trace interface
+int Trace_Open(TraceMode mode, const char *path, unsigned long frames)
+{
+	trace_mode = mode;
+	trace_limit = frames;
+	trace_frame = 0;
+	trace_mismatches = 0;
+	trace_repeat = 0;
+	trace_softlocked = false;
+	
+	switch (mode)
+	{
+		case TraceMode_None:
+			break;
+		case TraceMode_Record:
+			//Open trace for writing
+			if ((trace_file = fopen(path, "w")) == NULL)
+			{
+				printf("Trace_Open: Failed to open %s for writing\n", path);
+				return -1;
+			}
+			break;
+		case TraceMode_Verify:
+		case TraceMode_Play:
+		{
+			//Read golden trace or movie
+			FILE *fp = fopen(path, "r");
+			if (fp == NULL)
+			{
+				printf("Trace_Open: Failed to open %s for reading\n", path);
+				return -1;
+			}
+			
+			unsigned long cap = 0, frame;
+			uint64_t hash;
+			unsigned int input1, input2;
+			while (fscanf(fp, "%lu %" SCNx64 " %x %x", &frame, &hash, &input1, &input2) == 4)
+			{
+				if (frame != trace_frames_len)
+				{
+					printf("Trace_Open: %s is out of order at frame %lu\n", path, frame);
+					fclose(fp);
+					return -1;
+				}
+				if (trace_frames_len >= cap)
+				{
+					cap = cap ? (cap << 1) : 0x1000;
+					TraceFrame *frames_new = realloc(trace_frames, cap * sizeof(TraceFrame));
+					if (frames_new == NULL)
+					{
+						printf("Trace_Open: Failed to allocate trace\n");
+						fclose(fp);
+						return -1;
+					}
+					trace_frames = frames_new;
+				}
+				trace_frames[trace_frames_len].hash = hash;
+				trace_frames[trace_frames_len].input[0] = input1;
+				trace_frames[trace_frames_len].input[1] = input2;
+				trace_frames_len++;
+			}
+			fclose(fp);
+			
+			//Stop once the trace runs out
+			if (trace_limit == 0 || trace_limit > trace_frames_len)
+				trace_limit = trace_frames_len;
+			break;
+		}
+	}
+	return 0;
+}
+
+int Trace_Close()
+{
+	int result = 0;
+	
+	switch (trace_mode)
+	{
+		case TraceMode_None:
+			break;
+		case TraceMode_Record:
+			if (trace_file != NULL)
+			{
+				printf("Trace: Recorded %lu frames\n", trace_frame);
+				fclose(trace_file);
+				trace_file = NULL;
+			}
+			break;
+		case TraceMode_Play:
+			free(trace_frames);
+			trace_frames = NULL;
+			trace_frames_len = 0;
+			break;
+		case TraceMode_Verify:
+			if (trace_mismatches != 0 || trace_frame < trace_limit)
+			{
+				printf("Trace: FAILED, %lu of %lu frames mismatched (%lu frames expected)\n", trace_mismatches, trace_frame, trace_limit);
+				result = -1;
+			}
+			else
+			{
+				printf("Trace: OK, %lu frames matched\n", trace_frame);
+			}
+			free(trace_frames);
+			trace_frames = NULL;
+			trace_frames_len = 0;
+			break;
+	}
+	
+	trace_mode = TraceMode_None;
+	return result;
+}
+
+uint64_t Trace_Hash(const uint32_t *screen, size_t pitch)
+{
+	uint64_t hash = TRACE_HASH_SEED;
+	for (size_t y = 0; y < SCREEN_HEIGHT; y++, screen += pitch)
+	{
+		const uint32_t *from = screen;
+		for (size_t x = 0; x < SCREEN_WIDTH; x += 2, from += 2)
+		{
+			hash ^= ((uint64_t)from[0] << 32) | from[1];
+			hash *= TRACE_HASH_PRIME;
+			hash ^= hash >> 29;
+		}
+	}
+	return hash;
+}
+
+//Returns non-zero once the trace is finished
+int Trace_Frame(const uint32_t *screen, size_t pitch)
+{
+	if (trace_mode == TraceMode_None && trace_limit == 0 && trace_softlock == 0)
+		return 0;
+	
+	//Hash frame
+	uint64_t hash = Trace_Hash(screen, pitch);
+	
+	//Check for soft-locks
+	if (trace_frame != 0 && hash == trace_hash)
+		trace_repeat++;
+	else
+		trace_repeat = 0;
+	trace_hash = hash;
+	
+	switch (trace_mode)
+	{
+		case TraceMode_None:
+		case TraceMode_Play:
+			break;
+		case TraceMode_Record:
+			fprintf(trace_file, "%lu %016" PRIX64 " %02X %02X\n", trace_frame, hash, trace_input[0], trace_input[1]);
+			break;
+		case TraceMode_Verify:
+			if (trace_frame < trace_frames_len && hash != trace_frames[trace_frame].hash)
+			{
+				if (trace_mismatches++ == 0)
+					printf("Trace: First divergence at frame %lu (expected %016" PRIX64 ", got %016" PRIX64 ")\n", trace_frame, trace_frames[trace_frame].hash, hash);
+			}
+			break;
+	}
+	
+	//Advance frame
+	trace_frame++;
+	if (trace_softlock != 0 && trace_repeat >= trace_softlock)
+	{
+		trace_softlocked = true;
+		return 1;
+	}
+	return trace_frame >= trace_limit && trace_limit != 0;
+}
+
+//Records or plays back joypad state
+uint8_t Trace_Input(size_t pad, uint8_t state)
+{
+	switch (trace_mode)
+	{
+		case TraceMode_Verify:
+		case TraceMode_Play:
+			if (trace_frame < trace_frames_len)
+				return trace_frames[trace_frame].input[pad];
+			return 0;
+		default:
+			return trace_input[pad] = state;
+	}
+}
+
+//Stops once the screen hasn't changed for 'frames' frames (0 to disable)
+void Trace_SetSoftlock(unsigned long frames)
+{
+	trace_softlock = frames;
+}
+
+void Trace_Result(TraceResult *result)
+{
+	result->frames = trace_frame;
+	result->hash = trace_hash;
+	result->softlock = trace_softlocked;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//Trace modes
+typedef enum
+{
+	TraceMode_None,   //Only hash frames (for benchmarking)
+	TraceMode_Record, //Write frame hashes and input to a golden trace
+	TraceMode_Verify, //Play back input from a golden trace and compare frame hashes against it
+	TraceMode_Play,   //Play back input from a trace (a movie) without comparing frame hashes
+} TraceMode;
+
+//Trace result
+typedef struct
+{
+	unsigned long frames; //Frames run
+	uint64_t hash;        //Hash of the last frame
+	bool softlock;        //Stopped because the screen didn't change for the soft-lock limit
+} TraceResult;
+
+//Trace interface
+int Trace_Open(TraceMode mode, const char *path, unsigned long frames);
+int Trace_Close();
+void Trace_SetSoftlock(unsigned long frames);
+void Trace_Result(TraceResult *result);
+
+uint64_t Trace_Hash(const uint32_t *screen, size_t pitch);
+int Trace_Frame(const uint32_t *screen, size_t pitch);
+uint8_t Trace_Input(size_t pad, uint8_t state);
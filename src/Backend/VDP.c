@@ -1,6 +1,7 @@
 #include "VDP.h"
 
 #include "MegaDrive.h"
+#include "Trace.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -39,6 +40,8 @@ static int16_t vdp_hint_pos;
 
 static MD_Vector vdp_hint, vdp_vint;
 
+static unsigned int vdp_frame_flags;
+
 //VDP interface
 int VDP_Init(const MD_Header *header)
 {
@@ -47,6 +50,8 @@ int VDP_Init(const MD_Header *header)
 		return -1;
 	
 	//Initialize VDP state
+	vdp_vram_p = vdp_vram;
+	vdp_cram_p = &vdp_cram[0][0];
 	vdp_plane_a_location = 0;
 	vdp_plane_b_location = 0;
 	vdp_sprite_location  = 0;
@@ -57,6 +62,7 @@ int VDP_Init(const MD_Header *header)
 	vdp_vscroll_a = 0;
 	vdp_vscroll_b = 0;
 	vdp_hint_pos = -1;
+	vdp_frame_flags = VDP_FRAME_DRAW | VDP_FRAME_EVENTS;
 	
 	vdp_hint = header->h_interrupt;
 	vdp_vint = header->v_interrupt;
@@ -95,6 +101,25 @@ void VDP_WriteVRAM(const uint8_t *data, size_t len)
 	vdp_vram_p += len;
 }
 
+void VDP_UpdateVRAM(const uint8_t *data, size_t len)
+{
+	#ifdef VDP_SANITY
+	if ((vdp_vram_p - vdp_vram) >= VRAM_SIZE || (vdp_vram_p - vdp_vram + len) > VRAM_SIZE)
+	{
+		puts("VDP_UpdateVRAM: Out-of-bounds");
+		return;
+	}
+	#endif
+	//Only write the tiles that differ from what's already in VRAM
+	for (size_t i = 0; i < len; i += 0x20)
+	{
+		size_t tile_len = (len - i < 0x20) ? (len - i) : 0x20;
+		if (memcmp(vdp_vram_p + i, data + i, tile_len))
+			memcpy(vdp_vram_p + i, data + i, tile_len);
+	}
+	vdp_vram_p += len;
+}
+
 void VDP_FillVRAM(uint8_t data, size_t len)
 {
 	#ifdef VDP_SANITY
@@ -229,11 +254,72 @@ void VDP_SetVScroll(int16_t scroll_a, int16_t scroll_b)
 	vdp_vscroll_b = scroll_b;
 }
 
+void VDP_SetFrameFlags(unsigned int flags)
+{
+	vdp_frame_flags = flags;
+}
+
 void VDP_SetHIntPosition(int16_t pos)
 {
 	vdp_hint_pos = pos;
 }
 
+//VDP savestate
+typedef struct
+{
+	uint8_t vram[VRAM_SIZE];
+	uint16_t cram[4][16];
+	size_t vram_off, cram_off;
+	size_t plane_a_location, plane_b_location, sprite_location, hscroll_location;
+	size_t plane_w, plane_h;
+	uint8_t background_colour;
+	int16_t vscroll_a, vscroll_b;
+	int16_t hint_pos;
+} VDP_State;
+
+size_t VDP_StateSize()
+{
+	return sizeof(VDP_State);
+}
+
+void VDP_SaveState(void *to)
+{
+	VDP_State *state = (VDP_State*)to;
+	memcpy(state->vram, vdp_vram, sizeof(vdp_vram));
+	memcpy(state->cram, vdp_cram, sizeof(vdp_cram));
+	state->vram_off = vdp_vram_p - vdp_vram;
+	state->cram_off = vdp_cram_p - &vdp_cram[0][0];
+	state->plane_a_location = vdp_plane_a_location;
+	state->plane_b_location = vdp_plane_b_location;
+	state->sprite_location = vdp_sprite_location;
+	state->hscroll_location = vdp_hscroll_location;
+	state->plane_w = vdp_plane_w;
+	state->plane_h = vdp_plane_h;
+	state->background_colour = vdp_background_colour;
+	state->vscroll_a = vdp_vscroll_a;
+	state->vscroll_b = vdp_vscroll_b;
+	state->hint_pos = vdp_hint_pos;
+}
+
+void VDP_LoadState(const void *from)
+{
+	const VDP_State *state = (const VDP_State*)from;
+	memcpy(vdp_vram, state->vram, sizeof(vdp_vram));
+	memcpy(vdp_cram, state->cram, sizeof(vdp_cram));
+	vdp_vram_p = vdp_vram + state->vram_off;
+	vdp_cram_p = &vdp_cram[0][0] + state->cram_off;
+	vdp_plane_a_location = state->plane_a_location;
+	vdp_plane_b_location = state->plane_b_location;
+	vdp_sprite_location = state->sprite_location;
+	vdp_hscroll_location = state->hscroll_location;
+	vdp_plane_w = state->plane_w;
+	vdp_plane_h = state->plane_h;
+	vdp_background_colour = state->background_colour;
+	vdp_vscroll_a = state->vscroll_a;
+	vdp_vscroll_b = state->vscroll_b;
+	vdp_hint_pos = state->hint_pos;
+}
+
 //VDP rendering
 #define SCREEN_PITCH SCREEN_WIDTH + (VDP_INTERNAL_PAD * 2)
 
@@ -242,8 +328,8 @@ void VDP_SetHIntPosition(int16_t pos)
 static uint32_t vdp_screen_internal[SCREEN_HEIGHT][SCREEN_PITCH];
 static uint8_t vdp_mask_internal[SCREEN_HEIGHT][SCREEN_PITCH];
 
-static uint32_t *vdp_screen;
-static uint8_t *vdp_mask;
+static uint32_t *const vdp_screen = &vdp_screen_internal[0][VDP_INTERNAL_PAD];
+static uint8_t *const vdp_mask = &vdp_mask_internal[0][VDP_INTERNAL_PAD];
 
 static uint32_t vdp_screen_pal[4][16];
 
@@ -471,12 +557,8 @@ static inline void VDP_RefreshPalette()
 		*pal_to++ = VDP_GetColour(i);
 }
 
-void VDP_Render()
+static void VDP_Draw()
 {
-	//Get VDP screen pointer
-	vdp_screen = &vdp_screen_internal[0][VDP_INTERNAL_PAD];
-	vdp_mask = &vdp_mask_internal[0][VDP_INTERNAL_PAD];
-	
 	//Calculate sprite cache
 	memset(vdp_sprite_cache, 0, sizeof(vdp_sprite_cache));
 	
@@ -546,18 +628,56 @@ void VDP_Render()
 		for (size_t y = 0; y < SCREEN_HEIGHT; y++, scache++, hscroll += 2, to += SCREEN_PITCH, tom += SCREEN_PITCH)
 			VDP_DrawScanline(y, to, tom, scache, hscroll);
 	}
+}
+
+static void VDP_Skip()
+{
+	//Send horizontal interrupt without drawing (same as VDP_Draw)
+	if (vdp_hint_pos >= 0 && vdp_hint_pos < SCREEN_HEIGHT)
+	{
+		size_t y = 0;
+		while (y < (size_t)vdp_hint_pos && y < SCREEN_HEIGHT)
+		{
+			y = ((size_t)vdp_hint_pos < SCREEN_HEIGHT) ? (size_t)vdp_hint_pos : SCREEN_HEIGHT;
+			vdp_hint();
+		}
+	}
+}
+
+void VDP_Present()
+{
+	//Hash screen for tracing
+	int trace_done = Trace_Frame(vdp_screen, SCREEN_PITCH);
+	
+	//Render screen
+	Render_Screen(vdp_screen);
+	
+	if (trace_done)
+	{
+		//Trace is finished
+		exit(MegaDrive_Quit() ? EXIT_FAILURE : EXIT_SUCCESS);
+	}
+}
+
+void VDP_Render()
+{
+	//Draw screen (skipped for hidden frames, which only send the interrupts)
+	if (vdp_frame_flags & VDP_FRAME_DRAW)
+		VDP_Draw();
+	else
+		VDP_Skip();
 	
 	//Send vertical interrupt
 	vdp_vint();
 	
-	//Render screen
-	Render_Screen(vdp_screen);
+	//Present screen
+	if (vdp_frame_flags & VDP_FRAME_DRAW)
+		VDP_Present();
 	
 	//Handle events
-	if (Input_HandleEvents())
+	if ((vdp_frame_flags & VDP_FRAME_EVENTS) && Input_HandleEvents())
 	{
 		//Game should close
-		MegaDrive_Quit();
-		exit(0);
+		exit(MegaDrive_Quit() ? EXIT_FAILURE : EXIT_SUCCESS);
 	}
 }
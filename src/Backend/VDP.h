@@ -52,12 +52,17 @@
 #define SPRITE_X_AND   0x1FF
 #define SPRITE_X_SHIFT 0
 
+//VDP frame flags
+#define VDP_FRAME_DRAW   (1 << 0) //Draw and present the screen
+#define VDP_FRAME_EVENTS (1 << 1) //Handle backend events
+
 //VDP interface
 int VDP_Init(const MD_Header *header);
 void VDP_Quit();
 
 void VDP_SeekVRAM(size_t offset);
 void VDP_WriteVRAM(const uint8_t *data, size_t len);
+void VDP_UpdateVRAM(const uint8_t *data, size_t len);
 void VDP_FillVRAM(uint8_t data, size_t len);
 
 void VDP_SeekCRAM(size_t offset);
@@ -72,5 +77,11 @@ void VDP_SetPlaneSize(size_t w, size_t h);
 void VDP_SetBackgroundColour(uint8_t index);
 void VDP_SetVScroll(int16_t scroll_a, int16_t scroll_b);
 void VDP_SetHIntPosition(int16_t pos);
+void VDP_SetFrameFlags(unsigned int flags);
+
+size_t VDP_StateSize();
+void VDP_SaveState(void *to);
+void VDP_LoadState(const void *from);
 
 void VDP_Render();
+void VDP_Present();
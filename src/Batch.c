@@ -0,0 +1,311 @@
+#if defined(__unix__) || defined(__APPLE__)
+	#define _POSIX_C_SOURCE 200809L
+	#define BATCH_POSIX
+#endif
+
+#include "Batch.h"
+
+#include "Game.h"
+#include "Level.h"
+
+#include "Backend/Trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#ifdef BATCH_POSIX
+	#include <time.h>
+	#include <signal.h>
+	#include <sys/types.h>
+	#include <sys/wait.h>
+	#include <unistd.h>
+#endif
+
+//Batch constants
+#define BATCH_SOFTLOCK 3600 //Frames without the screen changing before a job counts as soft-locked
+#define BATCH_TIMEOUT  900  //Seconds before a job counts as hung
+#define BATCH_WORKERS  64
+
+//Batch job
+typedef struct
+{
+	char movie[256]; //Empty for no input
+	int level;       //-1 to boot normally
+	unsigned long frames;
+} BatchJob;
+
+//Batch result (written by the worker right before it exits)
+typedef struct
+{
+	TraceResult trace;
+	uint16_t level;
+	uint8_t mode;
+	uint16_t ring_num;
+	uint32_t score_num;
+	LevelTime time;
+	uint8_t lives_num;
+	uint32_t ms;
+} BatchResult;
+
+#ifdef BATCH_POSIX
+//Worker state
+static int batch_fd = -1;
+static uint32_t batch_start;
+
+static uint32_t Batch_Ticks()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)ts.tv_sec * 1000 + (uint32_t)(ts.tv_nsec / 1000000);
+}
+
+static void Batch_Report()
+{
+	//Send result to the runner
+	BatchResult result;
+	memset(&result, 0, sizeof(result));
+	Trace_Result(&result.trace);
+	result.level = ram.level_id;
+	result.mode = ram.gamemode;
+	result.ring_num = ram.rings;
+	result.score_num = ram.score;
+	result.time = ram.time;
+	result.lives_num = ram.lives;
+	result.ms = Batch_Ticks() - batch_start;
+	
+	if (write(batch_fd, &result, sizeof(result)) != (ssize_t)sizeof(result))
+		puts("Batch_Report: Failed to write result");
+	close(batch_fd);
+}
+
+//Job list
+static BatchJob *Batch_Read(const char *path, size_t *jobs_len)
+{
+	FILE *fp = fopen(path, "r");
+	if (fp == NULL)
+	{
+		printf("Batch_Read: Failed to open %s\n", path);
+		return NULL;
+	}
+	
+	//Read jobs, one per line
+	//<movie or -> <level ID or -> <frames>
+	BatchJob *jobs = NULL;
+	size_t cap = 0;
+	*jobs_len = 0;
+	
+	char line[512];
+	unsigned long line_i = 0;
+	while (fgets(line, sizeof(line), fp) != NULL)
+	{
+		line_i++;
+		
+		char movie[256], level[32];
+		unsigned long frames;
+		if (line[0] == '#' || sscanf(line, "%255s %31s %lu", movie, level, &frames) != 3)
+		{
+			if (line[0] != '#' && line[strspn(line, " \t\r\n")] != '\0')
+				printf("Batch_Read: %s:%lu isn't a job, skipping it\n", path, line_i);
+			continue;
+		}
+		
+		if (*jobs_len >= cap)
+		{
+			cap = cap ? (cap << 1) : 0x40;
+			BatchJob *jobs_new = realloc(jobs, cap * sizeof(BatchJob));
+			if (jobs_new == NULL)
+			{
+				puts("Batch_Read: Failed to allocate jobs");
+				free(jobs);
+				fclose(fp);
+				return NULL;
+			}
+			jobs = jobs_new;
+		}
+		
+		BatchJob *job = &jobs[(*jobs_len)++];
+		strcpy(job->movie, strcmp(movie, "-") ? movie : "");
+		job->level = strcmp(level, "-") ? (int)strtol(level, NULL, 0) : -1;
+		job->frames = frames;
+	}
+	
+	fclose(fp);
+	return jobs;
+}
+#endif
+
+//Batch interface
+//Runs each job in a forked worker process, 'workers' at a time, and prints their results
+//Workers share everything loaded before the fork with the runner (copy-on-write), 'run' starts the game in the worker
+int Batch_Run(const char *path, unsigned int workers, int (*run)())
+{
+	#ifdef BATCH_POSIX
+		//Read jobs
+		size_t jobs_len;
+		BatchJob *jobs = Batch_Read(path, &jobs_len);
+		if (jobs == NULL)
+			return -1;
+		
+		if (workers == 0)
+			workers = 1;
+		if (workers > BATCH_WORKERS)
+			workers = BATCH_WORKERS;
+		
+		//Worker state
+		struct
+		{
+			pid_t pid;
+			int fd;
+			size_t job;
+			unsigned long jobs, frames;
+			uint32_t ms;
+		} worker[BATCH_WORKERS];
+		for (unsigned int i = 0; i < workers; i++)
+		{
+			worker[i].pid = 0;
+			worker[i].jobs = worker[i].frames = 0;
+			worker[i].ms = 0;
+		}
+		
+		unsigned long ok = 0, failed = 0, crashed = 0, softlocked = 0;
+		size_t next = 0, running = 0;
+		
+		while (next < jobs_len || running != 0)
+		{
+			//Start jobs on idle workers
+			for (unsigned int i = 0; i < workers && next < jobs_len; i++)
+			{
+				if (worker[i].pid != 0)
+					continue;
+				
+				int fds[2];
+				fflush(stdout);
+				if (pipe(fds) < 0)
+				{
+					puts("Batch_Run: Failed to create pipe");
+					next = jobs_len;
+					break;
+				}
+				
+				pid_t pid = fork();
+				if (pid < 0)
+				{
+					puts("Batch_Run: Failed to fork worker");
+					close(fds[0]);
+					close(fds[1]);
+					next = jobs_len;
+					break;
+				}
+				if (pid == 0)
+				{
+					//Worker, set up job and run the game
+					const BatchJob *job = &jobs[next];
+					close(fds[0]);
+					batch_fd = fds[1];
+					batch_start = Batch_Ticks();
+					
+					if (Trace_Open(job->movie[0] ? TraceMode_Play : TraceMode_None, job->movie, job->frames))
+						exit(EXIT_FAILURE);
+					Trace_SetSoftlock(BATCH_SOFTLOCK);
+					start_level = job->level;
+					
+					atexit(Batch_Report);
+					alarm(BATCH_TIMEOUT);
+					exit(run() ? EXIT_FAILURE : EXIT_SUCCESS);
+				}
+				
+				close(fds[1]);
+				worker[i].pid = pid;
+				worker[i].fd = fds[0];
+				worker[i].job = next++;
+				running++;
+			}
+			
+			if (running == 0)
+				break;
+			
+			//Wait for a worker to finish
+			int status;
+			pid_t pid = wait(&status);
+			if (pid < 0)
+				break;
+			
+			unsigned int i;
+			for (i = 0; i < workers; i++)
+				if (worker[i].pid == pid)
+					break;
+			if (i == workers)
+				continue;
+			
+			BatchResult result;
+			bool reported = read(worker[i].fd, &result, sizeof(result)) == (ssize_t)sizeof(result);
+			close(worker[i].fd);
+			worker[i].pid = 0;
+			running--;
+			
+			//Print result
+			const BatchJob *job = &jobs[worker[i].job];
+			printf("Batch: Job %lu (%s, ", (unsigned long)worker[i].job, job->movie[0] ? job->movie : "no movie");
+			if (job->level >= 0)
+				printf("level %04X): ", job->level);
+			else
+				printf("boot): ");
+			
+			if (WIFSIGNALED(status) || !reported)
+			{
+				if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM)
+					printf("HUNG after %u seconds\n", BATCH_TIMEOUT);
+				else if (WIFSIGNALED(status))
+					printf("CRASHED (signal %d)\n", WTERMSIG(status));
+				else
+					printf("FAILED to start\n");
+				if (WIFSIGNALED(status))
+					crashed++;
+				else
+					failed++;
+				continue;
+			}
+			
+			if (result.trace.softlock)
+			{
+				printf("SOFT-LOCKED at frame %lu, ", result.trace.frames);
+				softlocked++;
+			}
+			else if (WEXITSTATUS(status) != EXIT_SUCCESS)
+			{
+				printf("FAILED, ");
+				failed++;
+			}
+			else
+			{
+				printf("OK, ");
+				ok++;
+			}
+			
+			unsigned long fps = result.ms ? (result.trace.frames * 1000 / result.ms) : 0;
+			printf("%lu frames, hash %016" PRIX64 ", gamemode %02X, level %04X, lives %u, rings %u, score %lu, time %u:%02u:%02u, %lu fps\n",
+				result.trace.frames, result.trace.hash, result.mode, result.level, result.lives_num, result.ring_num, (unsigned long)result.score_num * 10,
+				result.time.min, result.time.sec, result.time.frame, fps);
+			
+			worker[i].jobs++;
+			worker[i].frames += result.trace.frames;
+			worker[i].ms += result.ms;
+		}
+		
+		//Print summary
+		for (unsigned int i = 0; i < workers; i++)
+			printf("Batch: Worker %u ran %lu jobs, %lu frames, %lu fps\n", i, worker[i].jobs, worker[i].frames, worker[i].ms ? (worker[i].frames * 1000 / worker[i].ms) : 0);
+		printf("Batch: %lu jobs, %lu OK, %lu failed, %lu crashed, %lu soft-locked\n", (unsigned long)jobs_len, ok, failed, crashed, softlocked);
+		
+		free(jobs);
+		return (ok == jobs_len) ? 0 : -1;
+	#else
+		(void)path;
+		(void)workers;
+		(void)run;
+		puts("Batch_Run: Batch runs aren't supported on this platform");
+		return -1;
+	#endif
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+//Batch interface
+int Batch_Run(const char *path, unsigned int workers, int (*run)());
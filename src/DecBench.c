@@ -0,0 +1,342 @@
+#include "DecBench.h"
+
+#include "Kosinski.h"
+#include "Nemesis.h"
+#include "Level.h"
+#include "PLC.h"
+#include "GM_Sega.h"
+#include "GM_Title.h"
+#include "GM_Level.h"
+#ifdef SCP_SPLASH
+	#include "GM_SSRG.h"
+#endif
+
+#include "Backend/ResPack.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//Decompressor benchmark
+//Every resource is decompressed with both the original and the fast decompressor, which have to match, then each is timed
+#define DEC_BENCH_BUFFER 0x40000 //Largest Nemesis output (0xFFFF longwords)
+#define DEC_BENCH_ROUNDS 5
+#define DEC_BENCH_ART    0x100
+
+typedef void (*DecBench_Func)(const uint8_t *source, uint8_t *destination);
+
+static void DecBench_KosDecRef(const uint8_t *source, uint8_t *destination)
+{
+	KosDecRef(source, destination);
+}
+
+static void DecBench_KosDec(const uint8_t *source, uint8_t *destination)
+{
+	KosDec(source, destination);
+}
+
+static double DecBench_Time(DecBench_Func func, const uint8_t *source, uint8_t *buffer, size_t size, unsigned long iterations)
+{
+	//Get speed in MB/s, from the fastest of a few rounds so other processes don't skew it as much
+	double best = 0.0;
+	for (int round = 0; round < DEC_BENCH_ROUNDS; round++)
+	{
+		clock_t start = clock();
+		for (unsigned long i = 0; i < iterations; i++)
+			func(source, buffer);
+		double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+		
+		double speed = (seconds > 0.0) ? ((double)size * iterations / seconds / 1000000.0) : 0.0;
+		if (speed > best)
+			best = speed;
+	}
+	return best;
+}
+
+static int DecBench_Kosinski(const char *name, const uint8_t *source, uint8_t *buffer_ref, uint8_t *buffer, unsigned long iterations)
+{
+	if (KosRawSize(source) != 0)
+	{
+		printf("%s: decompressed at build time, skipped\n", name);
+		return 0;
+	}
+	
+	//Compare outputs
+	size_t size = KosDecRef(source, buffer_ref) - buffer_ref;
+	if ((size_t)(KosDec(source, buffer) - buffer) != size || memcmp(buffer_ref, buffer, size))
+	{
+		printf("%s: MISMATCH\n", name);
+		return -1;
+	}
+	
+	//Time decompressors
+	double speed_ref = DecBench_Time(DecBench_KosDecRef, source, buffer_ref, size, iterations);
+	double speed = DecBench_Time(DecBench_KosDec, source, buffer, size, iterations);
+	printf("%s: 0x%lX bytes, original %.1f MB/s, fast %.1f MB/s\n", name, (unsigned long)size, speed_ref, speed);
+	return 0;
+}
+
+static int DecBench_Nemesis(const char *name, const uint8_t *source, uint8_t *buffer_ref, uint8_t *buffer, unsigned long iterations)
+{
+	if (NemRawSize(source) != 0)
+	{
+		printf("%s: decompressed at build time, skipped\n", name);
+		return 0;
+	}
+	
+	//Compare outputs
+	size_t size = ((((source[0] << 8) | source[1]) << 3) & 0xFFFF) * 4;
+	NemDecToRAMRef(source, buffer_ref);
+	NemDecToRAM(source, buffer);
+	if (memcmp(buffer_ref, buffer, size))
+	{
+		printf("%s: MISMATCH\n", name);
+		return -1;
+	}
+	
+	//Time decompressors
+	double speed_ref = DecBench_Time(NemDecToRAMRef, source, buffer_ref, size, iterations);
+	double speed = DecBench_Time(NemDecToRAM, source, buffer, size, iterations);
+	printf("%s: 0x%lX bytes, original %.1f MB/s, fast %.1f MB/s\n", name, (unsigned long)size, speed_ref, speed);
+	return 0;
+}
+
+//Game modes that load art directly instead of through PLCs
+static const struct
+{
+	const char *name;
+	const uint8_t *(*get_art)(size_t i);
+} dec_bench_modes[] = {
+	{"Sega", GM_Sega_GetArt},
+	{"Title", GM_Title_GetArt},
+	{"Level", GM_Level_GetArt},
+	#ifdef SCP_SPLASH
+		{"SSRG", GM_SSRG_GetArt},
+	#endif
+};
+
+static bool DecBench_Seen(const uint8_t **seen, size_t *seen_num, const uint8_t *art)
+{
+	//Check if art was already benchmarked, and remember it if not
+	for (size_t i = 0; i < *seen_num; i++)
+		if (seen[i] == art)
+			return true;
+	if (*seen_num == DEC_BENCH_ART)
+		return true;
+	seen[(*seen_num)++] = art;
+	return false;
+}
+
+int DecBench_Run(unsigned long iterations)
+{
+	static const char *zone_names[ZoneId_Num] = {"GHZ", "LZ", "MZ", "SLZ", "SYZ", "SBZ", "EndZ", "SS"};
+	
+	//Allocate output buffers
+	uint8_t *buffer_ref = malloc(DEC_BENCH_BUFFER);
+	uint8_t *buffer = malloc(DEC_BENCH_BUFFER);
+	if (buffer_ref == NULL || buffer == NULL)
+	{
+		printf("DecBench_Run: Failed to allocate buffers\n");
+		free(buffer_ref);
+		free(buffer);
+		return -1;
+	}
+	
+	//Benchmark the chunk maps (zones can share them)
+	int result = 0;
+	char name[0x20];
+	for (size_t i = 0; i < ZoneId_Num; i++)
+	{
+		const uint8_t *map256 = ResPack_Get(level_header[i].map256, NULL);
+		if (map256 == NULL)
+			continue;
+		
+		size_t j = 0;
+		while (j < i && ResPack_Get(level_header[j].map256, NULL) != map256)
+			j++;
+		if (j != i)
+			continue;
+		
+		sprintf(name, "Map256/%s", zone_names[i]);
+		if (DecBench_Kosinski(name, map256, buffer_ref, buffer, iterations))
+			result = -1;
+	}
+	
+	//Benchmark the art loaded by PLCs (lists can share art)
+	static const uint8_t *seen[DEC_BENCH_ART];
+	size_t seen_num = 0;
+	for (size_t i = 0; i < PlcId_Num; i++)
+	{
+		const uint8_t *art;
+		for (size_t j = 0; (art = PLC_GetArt(i, j)) != NULL; j++)
+		{
+			if (DecBench_Seen(seen, &seen_num, art))
+				continue;
+			sprintf(name, "PLC 0x%02X art %u", (unsigned int)i, (unsigned int)j);
+			if (DecBench_Nemesis(name, art, buffer_ref, buffer, iterations))
+				result = -1;
+		}
+	}
+	
+	//Benchmark the art game modes load directly
+	for (size_t i = 0; i < (sizeof(dec_bench_modes) / sizeof(*dec_bench_modes)); i++)
+	{
+		const uint8_t *art;
+		for (size_t j = 0; (art = dec_bench_modes[i].get_art(j)) != NULL; j++)
+		{
+			if (DecBench_Seen(seen, &seen_num, art))
+				continue;
+			sprintf(name, "%s art %u", dec_bench_modes[i].name, (unsigned int)j);
+			if (DecBench_Nemesis(name, art, buffer_ref, buffer, iterations))
+				result = -1;
+		}
+	}
+	
+	free(buffer_ref);
+	free(buffer);
+	return result;
+}
+
+//Decompressor fuzzing
+//Mutated copies of the Kosinski streams that KosCheck accepts are decompressed by both decompressors into buffers of exactly the size it gave,
+//followed by guard bytes that neither may touch, and have to match
+#define DEC_FUZZ_GUARD 0x40
+#define DEC_FUZZ_MAX   0x100000 //Largest output to decompress, mutations can make much larger ones
+
+static uint32_t DecFuzz_Random(uint32_t *seed)
+{
+	//xorshift32, so runs are the same everywhere
+	uint32_t x = *seed;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return *seed = x;
+}
+
+static bool DecFuzz_Guarded(const uint8_t *buffer, size_t size)
+{
+	for (size_t i = 0; i < DEC_FUZZ_GUARD; i++)
+		if (buffer[size + i] != 0xA5)
+			return false;
+	return true;
+}
+
+static int DecFuzz_Kosinski(const char *name, const uint8_t *source, unsigned long iterations, uint32_t *seed)
+{
+	if (KosRawSize(source) != 0)
+	{
+		printf("%s: decompressed at build time, skipped\n", name);
+		return 0;
+	}
+	
+	//Get the original stream
+	size_t dec_size;
+	size_t size = KosCheck(source, SIZE_MAX, &dec_size);
+	if (size == 0)
+	{
+		printf("%s: KosCheck rejected the original stream\n", name);
+		return -1;
+	}
+	
+	uint8_t *stream = malloc(size);
+	if (stream == NULL)
+	{
+		printf("DecFuzz_Kosinski: Failed to allocate stream\n");
+		return -1;
+	}
+	
+	int result = 0;
+	unsigned long accepted = 0;
+	for (unsigned long i = 0; i < iterations && result == 0; i++)
+	{
+		//Flip bits, replace bytes or cut the stream short
+		memcpy(stream, source, size);
+		size_t stream_size = size;
+		
+		unsigned int mutations = 1 + DecFuzz_Random(seed) % 4;
+		for (unsigned int j = 0; j < mutations; j++)
+		{
+			uint32_t r = DecFuzz_Random(seed);
+			size_t at = (r >> 8) % stream_size;
+			switch (r & 3)
+			{
+				case 0:
+				case 1:
+					stream[at] ^= 1 << ((r >> 2) & 7);
+					break;
+				case 2:
+					stream[at] = r >> 24;
+					break;
+				case 3:
+					stream_size = at + 1;
+					break;
+			}
+		}
+		
+		//Decompress the streams KosCheck accepts
+		if (KosCheck(stream, stream_size, &dec_size) == 0 || dec_size > DEC_FUZZ_MAX)
+			continue;
+		accepted++;
+		
+		uint8_t *cut = malloc(stream_size); //Exactly the stream's size, so memory checkers catch reads past it
+		uint8_t *buffer_ref = malloc(dec_size + DEC_FUZZ_GUARD);
+		uint8_t *buffer = malloc(dec_size + DEC_FUZZ_GUARD);
+		if (cut == NULL || buffer_ref == NULL || buffer == NULL)
+		{
+			printf("DecFuzz_Kosinski: Failed to allocate buffers\n");
+			result = -1;
+		}
+		else
+		{
+			memcpy(cut, stream, stream_size);
+			memset(buffer_ref + dec_size, 0xA5, DEC_FUZZ_GUARD);
+			memset(buffer + dec_size, 0xA5, DEC_FUZZ_GUARD);
+			
+			size_t size_ref = KosDecRef(cut, buffer_ref) - buffer_ref;
+			size_t size_fast = KosDec(cut, buffer) - buffer;
+			if (size_ref != dec_size || size_fast != dec_size || !DecFuzz_Guarded(buffer_ref, dec_size) || !DecFuzz_Guarded(buffer, dec_size) || memcmp(buffer_ref, buffer, dec_size))
+			{
+				printf("%s: MISMATCH on mutation %lu\n", name, i);
+				result = -1;
+			}
+		}
+		free(cut);
+		free(buffer_ref);
+		free(buffer);
+	}
+	
+	if (result == 0)
+		printf("%s: %lu of %lu mutations accepted by KosCheck, all matched\n", name, accepted, iterations);
+	free(stream);
+	return result;
+}
+
+int DecBench_Fuzz(unsigned long iterations)
+{
+	static const char *zone_names[ZoneId_Num] = {"GHZ", "LZ", "MZ", "SLZ", "SYZ", "SBZ", "EndZ", "SS"};
+	
+	//Fuzz the chunk maps (zones can share them)
+	uint32_t seed = 0x5C9D3A71;
+	int result = 0;
+	char name[0x20];
+	for (size_t i = 0; i < ZoneId_Num; i++)
+	{
+		const uint8_t *map256 = ResPack_Get(level_header[i].map256, NULL);
+		if (map256 == NULL)
+			continue;
+		
+		size_t j = 0;
+		while (j < i && ResPack_Get(level_header[j].map256, NULL) != map256)
+			j++;
+		if (j != i)
+			continue;
+		
+		sprintf(name, "Map256/%s", zone_names[i]);
+		if (DecFuzz_Kosinski(name, map256, iterations, &seed))
+			result = -1;
+	}
+	return result;
+}
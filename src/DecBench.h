@@ -0,0 +1,5 @@
+#pragma once
+
+//Decompressor benchmark interface
+int DecBench_Run(unsigned long iterations);
+int DecBench_Fuzz(unsigned long iterations);
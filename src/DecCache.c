@@ -0,0 +1,214 @@
+#include "DecCache.h"
+
+#include "Kosinski.h"
+#include "Nemesis.h"
+
+#include "Backend/VDP.h"
+#include "Backend/Thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//Decompression cache
+//Decompressed data is kept, keyed by its source pointer, so loading the same zone again (restarts, demos, acts) skips decompression
+//The least recently used data is dropped once the cache would go over its memory cap
+#define DEC_CACHE_ENTRIES 0x40
+#define DEC_CACHE_CAP     0x400000 //Default memory cap in bytes
+
+typedef struct
+{
+	const uint8_t *source;
+	uint8_t *data;
+	size_t size;
+	uint32_t use; //Last use, for eviction
+} DecCacheEntry;
+
+static DecCacheEntry dec_cache[DEC_CACHE_ENTRIES];
+static size_t dec_cache_cap = DEC_CACHE_CAP;
+static size_t dec_cache_used;
+static uint32_t dec_cache_clock;
+static unsigned long dec_cache_hits, dec_cache_misses;
+
+static void DecCache_Evict(DecCacheEntry *entry)
+{
+	free(entry->data);
+	dec_cache_used -= entry->size;
+	entry->source = NULL;
+	entry->data = NULL;
+	entry->size = 0;
+}
+
+void DecCache_SetCap(size_t cap)
+{
+	//Drop everything, the new cap applies from now on
+	for (size_t i = 0; i < DEC_CACHE_ENTRIES; i++)
+		if (dec_cache[i].source != NULL)
+			DecCache_Evict(&dec_cache[i]);
+	dec_cache_cap = cap;
+}
+
+void DecCache_PrintStats()
+{
+	printf("DecCache: %lu hits, %lu misses, %lu of %lu bytes used\n", dec_cache_hits, dec_cache_misses, (unsigned long)dec_cache_used, (unsigned long)dec_cache_cap);
+}
+
+static const DecCacheEntry *DecCache_Find(const uint8_t *source)
+{
+	//Find cached data
+	for (size_t i = 0; i < DEC_CACHE_ENTRIES; i++)
+	{
+		if (dec_cache[i].source == source)
+		{
+			dec_cache[i].use = ++dec_cache_clock;
+			dec_cache_hits++;
+			return &dec_cache[i];
+		}
+	}
+	dec_cache_misses++;
+	return NULL;
+}
+
+static DecCacheEntry *DecCache_LRU()
+{
+	//Get the least recently used entry holding data (there's always one while any memory is used)
+	DecCacheEntry *entry = NULL;
+	for (size_t i = 0; i < DEC_CACHE_ENTRIES; i++)
+		if (dec_cache[i].source != NULL && (entry == NULL || dec_cache[i].use < entry->use))
+			entry = &dec_cache[i];
+	return entry;
+}
+
+static void DecCache_Add(const uint8_t *source, const uint8_t *data, size_t size)
+{
+	if (size == 0 || size > dec_cache_cap)
+		return;
+	
+	//Evict the least recently used data until there's room
+	while (dec_cache_used + size > dec_cache_cap)
+		DecCache_Evict(DecCache_LRU());
+	
+	//Take a free entry, or the least recently used one if they're all taken
+	DecCacheEntry *entry = NULL;
+	for (size_t i = 0; i < DEC_CACHE_ENTRIES && entry == NULL; i++)
+		if (dec_cache[i].source == NULL)
+			entry = &dec_cache[i];
+	if (entry == NULL)
+		DecCache_Evict(entry = DecCache_LRU());
+	
+	//Store data
+	if ((entry->data = malloc(size)) == NULL)
+		return;
+	memcpy(entry->data, data, size);
+	entry->source = source;
+	entry->size = size;
+	entry->use = ++dec_cache_clock;
+	dec_cache_used += size;
+}
+
+//Prefetching
+//KosDecPrefetch starts decompressing data on a worker thread ahead of time, KosDecCached then waits for it instead of decompressing it itself
+static struct
+{
+	const uint8_t *source;
+	uint8_t *data;
+	size_t size;
+	ThreadJob *job;
+} dec_prefetch;
+
+static void KosDecPrefetch_Work(void *arg)
+{
+	(void)arg;
+	dec_prefetch.size = KosDec(dec_prefetch.source, dec_prefetch.data) - dec_prefetch.data;
+}
+
+static void KosDecPrefetch_Drop()
+{
+	Thread_WaitJob(dec_prefetch.job);
+	free(dec_prefetch.data);
+	dec_prefetch.source = NULL;
+	dec_prefetch.data = NULL;
+	dec_prefetch.job = NULL;
+}
+
+void KosDecPrefetch(const uint8_t *source, size_t capacity)
+{
+	//Raw and cached data is copied quickly anyway
+	if (source == NULL || source == dec_prefetch.source || KosRawSize(source) != 0)
+		return;
+	for (size_t i = 0; i < DEC_CACHE_ENTRIES; i++)
+		if (dec_cache[i].source == source)
+			return;
+	
+	//Start decompressing to a staging buffer
+	KosDecPrefetch_Drop();
+	if ((dec_prefetch.data = malloc(capacity)) == NULL)
+		return;
+	dec_prefetch.source = source;
+	dec_prefetch.job = Thread_StartJob(KosDecPrefetch_Work, NULL);
+}
+
+void KosDecCached(const uint8_t *source, void *destination)
+{
+	//Raw data is copied as fast as the cache would
+	if (KosRawSize(source) != 0)
+	{
+		KosDec(source, destination);
+		return;
+	}
+	
+	//Copy prefetched data once it's ready
+	if (source == dec_prefetch.source)
+	{
+		Thread_WaitJob(dec_prefetch.job);
+		dec_prefetch.job = NULL;
+		memcpy(destination, dec_prefetch.data, dec_prefetch.size);
+		dec_cache_misses++;
+		DecCache_Add(source, dec_prefetch.data, dec_prefetch.size);
+		KosDecPrefetch_Drop();
+		return;
+	}
+	
+	//Copy cached data
+	const DecCacheEntry *entry = DecCache_Find(source);
+	if (entry != NULL)
+	{
+		memcpy(destination, entry->data, entry->size);
+		return;
+	}
+	
+	//Decompress and cache
+	size_t size = KosDec(source, destination) - (uint8_t*)destination;
+	DecCache_Add(source, destination, size);
+}
+
+void NemDecCached(const uint8_t *source)
+{
+	//Raw art is copied as fast as the cache would
+	if (NemRawSize(source) != 0)
+	{
+		NemDec(source);
+		return;
+	}
+	
+	//Write cached data to VRAM
+	const DecCacheEntry *entry = DecCache_Find(source);
+	if (entry != NULL)
+	{
+		VDP_WriteVRAM(entry->data, entry->size);
+		return;
+	}
+	
+	//Decompress to RAM, then cache and write to VRAM (the header holds the tile count, which the decompressor turns into a 16-bit longword count)
+	size_t size = ((((source[0] << 8) | source[1]) << 3) & 0xFFFF) * 4;
+	uint8_t *data;
+	if (size == 0 || (data = malloc(size)) == NULL)
+	{
+		NemDec(source);
+		return;
+	}
+	NemDecToRAM(source, data);
+	VDP_WriteVRAM(data, size);
+	DecCache_Add(source, data, size);
+	free(data);
+}
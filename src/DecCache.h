@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+//Decompression cache interface
+void DecCache_SetCap(size_t cap);
+void DecCache_PrintStats();
+
+void KosDecPrefetch(const uint8_t *source, size_t capacity);
+void KosDecCached(const uint8_t *source, void *destination);
+void NemDecCached(const uint8_t *source);
@@ -5,10 +5,6 @@
 
 #include <stddef.h>
 
-//Demo state
-uint16_t btn_pushtime1;
-uint8_t btn_pushtime2;
-
 //Demos
 static const uint8_t demo_intro_ghz[] = {
 	#include "Resource/Demo/IntroGHZ.h"
@@ -73,40 +69,40 @@ const uint8_t *ending_demo_ptr[] = {
 //Demo playback
 void MoveSonicInDemo()
 {
-	if (!demo)
+	if (!ram.demo)
 		return;
 	
 	//Return to title screen if start is pressed
-	if (demo >= 0 && (jpad1_hold1 & JPAD_START))
-		gamemode = GameMode_Title;
+	if (ram.demo >= 0 && (ram.jpad1_hold1 & JPAD_START))
+		ram.gamemode = GameMode_Title;
 	
 	//Get demo data
 	const uint8_t *demo_data;
-	if (demo < 0)
-		demo_data = ending_demo_ptr[credits_num - 1];
+	if (ram.demo < 0)
+		demo_data = ending_demo_ptr[ram.credits_num - 1];
 	else
-		demo_data = intro_demo_ptr[(gamemode == GameMode_Special) ? 6 : LEVEL_ZONE(level_id)];
+		demo_data = intro_demo_ptr[(ram.gamemode == GameMode_Special) ? 6 : LEVEL_ZONE(ram.level_id)];
 	
 	//Offset demo address
-	demo_data += btn_pushtime1;
+	demo_data += ram.btn_pushtime1;
 	
 	//Apply input onto joypad state
 	uint8_t d0 = demo_data[0];
 	uint8_t d1 = d0;
 	#ifdef SCP_REV00
-		uint8_t d2 = jpad1_hold1;
+		uint8_t d2 = ram.jpad1_hold1;
 	#else
 		uint8_t d2 = 0; //Fix the infamous demo playback bug
 	#endif
 	d0 ^= d2;
-	jpad1_hold1 = d1;
+	ram.jpad1_hold1 = d1;
 	d0 &= d1;
-	jpad1_press1 = d0;
+	ram.jpad1_press1 = d0;
 	
 	//Handle demo timer
-	if (--btn_pushtime2 == 0xFF)
+	if (--ram.btn_pushtime2 == 0xFF)
 	{
-		btn_pushtime2 = demo_data[3];
-		btn_pushtime1 += 2;
+		ram.btn_pushtime2 = demo_data[3];
+		ram.btn_pushtime1 += 2;
 	}
 }
@@ -1,10 +1,8 @@
 #pragma once
 
-#include <stdint.h>
+#include "RAM.h"
 
-//Demo state
-extern uint16_t btn_pushtime1;
-extern uint8_t btn_pushtime2;
+#include <stdint.h>
 
 //Demos
 extern const uint8_t *intro_demo_ptr[];
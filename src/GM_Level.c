@@ -8,14 +8,21 @@
 #include "LevelCollision.h"
 #include "SpecialStage.h"
 #include "Object/Sonic.h"
+#include "Object/Ring.h"
 #include "Video.h"
 #include "Palette.h"
 #include "PaletteCycle.h"
 #include "Nemesis.h"
+#include "DecCache.h"
 #include "PLC.h"
 #include "Demo.h"
 #include "HUD.h"
+#include "RunAhead.h"
+#include "Rollback.h"
 
+#include "Backend/Thread.h"
+
+#include <stdio.h>
 #include <string.h>
 
 //Title card art
@@ -24,167 +31,236 @@ static const uint8_t art_titlecard[] = {
 	,0,
 };
 
+//Load timing
+//With level_load_time set, the time each stage of loading a level takes is printed, up to the end of the level's first frame
+bool level_load_time;
+
+static bool load_timing;
+static uint64_t load_time_start, load_time_stage;
+
+static void GM_Level_LoadTime(const char *stage)
+{
+	if (!load_timing)
+		return;
+	uint64_t now = Thread_Micros();
+	printf("GM_Level: %-16s %9.3f ms\n", stage, (now - load_time_stage) / 1000.0);
+	load_time_stage = now;
+}
+
+//Level frame
+static bool GM_Level_Frame()
+{
+	//Run frame
+	ram.vbla_routine = 0x08;
+	WaitForVBla();
+	ram.frame_count++;
+	
+	MoveSonicInDemo();
+	//LZWaterFeatures();
+	
+	//Run game
+	ExecuteObjects();
+	#ifndef SCP_REV00
+		//Restart level gamemode if restart flag set
+		if (ram.restart)
+			return true;
+	#endif
+	
+	//Setup video and load PLCs
+	if (ram.debug_use || player->routine < 6)
+		DeformLayers();
+	BuildSprites(NULL);
+	ObjPosLoad();
+	PaletteCycle();
+	RunPLC();
+	
+	//Other level stuff
+	SynchroAnimate();
+	SignpostArtLoad();
+	return false;
+}
+
+static bool GM_Level_AheadFrame()
+{
+	GM_Level_Frame();
+	return ram.restart || ram.gamemode != GameMode_Level;
+}
+
+const uint8_t *GM_Level_GetArt(size_t i)
+{
+	//Get the i-th art loaded directly instead of through a PLC
+	static const uint8_t *const art[] = {art_titlecard};
+	return (i < (sizeof(art) / sizeof(*art))) ? art[i] : NULL;
+}
+
 //Level gamemode
 void GM_Level()
 {
 	GM_Level_Branch:;
+	if ((load_timing = level_load_time))
+		load_time_start = load_time_stage = Thread_Micros();
+	
 	//Set 'title card' flag
-	gamemode |= 0x80;
+	ram.gamemode |= 0x80;
 	
-	if (demo >= 0)
+	if (ram.demo >= 0)
 		{;} //sfx	bgm_Fade,0,1,1 ; fade out music //TODO
 	
 	//Clear the pattern load queue and fade out
 	ClearPLC();
+	LevelDataReload();
+	LevelDataPrefetch();
 	PaletteFadeOut();
+	GM_Level_LoadTime("fade out");
 	
 	//Load art if not in credits
-	if (demo >= 0)
+	if (ram.demo >= 0)
 	{
 		//Load title card art
 		VDP_SeekVRAM(0xB000);
-		NemDec(art_titlecard);
+		NemDecCached(art_titlecard);
 		
 		//Load level art and general art
-		if (level_header[LEVEL_ZONE(level_id)].plc1 != 0)
-			AddPLC(level_header[LEVEL_ZONE(level_id)].plc1);
+		if (level_header[LEVEL_ZONE(ram.level_id)].plc1 != 0)
+			AddPLC(level_header[LEVEL_ZONE(ram.level_id)].plc1);
 		AddPLC(PlcId_Main2);
+		GM_Level_LoadTime("title card art");
 	}
 	
 	//Clear object memory
-	memset(objects, 0, sizeof(objects));
+	ClearObjects();
 	
 	//Clear F628 to F680
-	vbla_routine = 0;
-	pcyc_num = 0;
-	pcyc_time = 0;
-	random_seed.v = 0;
-	pause = false;
-	hbla_pal = 0;
-	wtr_pos1 = 0;
-	wtr_pos2 = 0;
-	wtr_pos3 = 0;
-	wtr_routine = 0;
-	wtr_state = 0;
-	memset(pcyc_buffer, 0, sizeof(pcyc_buffer));
+	ram.vbla_routine = 0;
+	ram.pcyc_num = 0;
+	ram.pcyc_time = 0;
+	ram.random_seed.v = 0;
+	ram.pause = false;
+	ram.hbla_pal = 0;
+	ram.wtr_pos1 = 0;
+	ram.wtr_pos2 = 0;
+	ram.wtr_pos3 = 0;
+	ram.wtr_routine = 0;
+	ram.wtr_state = 0;
+	memset(ram.pcyc_buffer, 0, sizeof(ram.pcyc_buffer));
 	
 	//Clear F700 to F800
-	scrpos_x.v = 0;
-	scrpos_y.v = 0;
-	bg_scrpos_x.v = 0;
-	bg_scrpos_y.v = 0;
-	bg2_scrpos_x.v = 0;
-	bg2_scrpos_y.v = 0;
-	bg3_scrpos_x.v = 0;
-	bg3_scrpos_y.v = 0;
-	
-	limit_left1 = 0;
-	limit_right1 = 0;
-	limit_top1 = 0;
-	limit_btm1 = 0;
-	limit_left2 = 0;
-	limit_right2 = 0;
-	limit_top2 = 0;
-	limit_btm2 = 0;
-	limit_left3 = 0;
-	
-	scrshift_x = 0;
-	scrshift_y = 0;
-	
-	look_shift = 0;
-	dle_routine = 0;
-	nobgscroll = false;
-	
-	fg_xblock = 0;
-	fg_yblock = 0;
-	bg1_xblock = 0;
-	bg1_yblock = 0;
-	bg2_xblock = 0;
-	bg2_yblock = 0;
-	bg3_xblock = 0;
-	bg3_yblock = 0;
-	
-	fg_scroll_flags = 0;
-	bg1_scroll_flags = 0;
-	bg2_scroll_flags = 0;
-	bg3_scroll_flags = 0;
-	bgscrollvert = false;
-	sonspeed_max = 0;
-	sonspeed_acc = 0;
-	sonspeed_dec = 0;
-	sonframe_num = 0;
-	sonframe_chg = 0;
-	angle_buffer0 = 0;
-	angle_buffer1 = 0;
-	
-	opl_routine = 0;
-	opl_screen = 0;
-	opl_ptr0 = NULL;
-	opl_ptr4 = NULL;
-	opl_ptr8 = NULL;
-	opl_ptrC = NULL;
-	
-	ss_angle.v = 0;
-	ss_rotate = 0;
-	btn_pushtime1 = 0;
-	btn_pushtime2 = 0;
-	pal_chgspeed = 0;
-	coll_index = NULL;
-	palss_num = 0;
-	palss_time = 0;
-	
-	btn_pushtime1 = 0;
-	btn_pushtime2 = 0;
-	obj31_ypos = 0;
-	boss_status = 0;
-	track_pos.v = 0;
-	lock_screen = 0;
-	memset(level_schunks, 0, sizeof(level_schunks));
-	memset(level_anim, 0, sizeof(level_anim));
-	gfx_big_ring = 0;
-	convey_rev = 0;
-	memset(obj63, 0, sizeof(obj63));
-	tunnel_mode = 0;
-	lock_multi = 0;
-	tunnel_allow = 0;
-	jump_only = 0;
-	obj6B = 0;
-	lock_ctrl = false;
-	big_ring = 0;
-	item_bonus = 0;
-	time_bonus = 0;
-	ring_bonus = 0;
-	endact_bonus = 0;
-	sonicend = 0;
-	lz_deform = 0;
-	memset(f_switch, 0, sizeof(f_switch));
-	
-	scroll_block1_size = 0;
-	scroll_block2_size = 0;
-	scroll_block3_size = 0;
-	scroll_block4_size = 0;
+	ram.scrpos_x.v = 0;
+	ram.scrpos_y.v = 0;
+	ram.bg_scrpos_x.v = 0;
+	ram.bg_scrpos_y.v = 0;
+	ram.bg2_scrpos_x.v = 0;
+	ram.bg2_scrpos_y.v = 0;
+	ram.bg3_scrpos_x.v = 0;
+	ram.bg3_scrpos_y.v = 0;
+	
+	ram.limit_left1 = 0;
+	ram.limit_right1 = 0;
+	ram.limit_top1 = 0;
+	ram.limit_btm1 = 0;
+	ram.limit_left2 = 0;
+	ram.limit_right2 = 0;
+	ram.limit_top2 = 0;
+	ram.limit_btm2 = 0;
+	ram.limit_left3 = 0;
+	
+	ram.scrshift_x = 0;
+	ram.scrshift_y = 0;
+	
+	ram.look_shift = 0;
+	ram.dle_routine = 0;
+	ram.nobgscroll = false;
+	
+	ram.fg_xblock = 0;
+	ram.fg_yblock = 0;
+	ram.bg1_xblock = 0;
+	ram.bg1_yblock = 0;
+	ram.bg2_xblock = 0;
+	ram.bg2_yblock = 0;
+	ram.bg3_xblock = 0;
+	ram.bg3_yblock = 0;
+	
+	ram.fg_scroll_flags = 0;
+	ram.bg1_scroll_flags = 0;
+	ram.bg2_scroll_flags = 0;
+	ram.bg3_scroll_flags = 0;
+	ram.bgscrollvert = false;
+	ram.sonspeed_max = 0;
+	ram.sonspeed_acc = 0;
+	ram.sonspeed_dec = 0;
+	ram.sonframe_num = 0;
+	ram.sonframe_chg = 0;
+	ram.angle_buffer[0] = 0;
+	ram.angle_buffer[1] = 0;
+	
+	ram.opl_routine = 0;
+	ram.opl_screen = 0;
+	ram.opl_ptr0 = NULL;
+	ram.opl_ptr4 = NULL;
+	ram.opl_ptr8 = NULL;
+	ram.opl_ptrC = NULL;
+	
+	ram.ss_angle.v = 0;
+	ram.ss_rotate = 0;
+	ram.btn_pushtime1 = 0;
+	ram.btn_pushtime2 = 0;
+	ram.pal_chgspeed = 0;
+	ram.coll_index = NULL;
+	ram.palss_num = 0;
+	ram.palss_time = 0;
+	
+	ram.btn_pushtime1 = 0;
+	ram.btn_pushtime2 = 0;
+	ram.obj31_ypos = 0;
+	ram.boss_status = 0;
+	ram.track_pos.v = 0;
+	ram.lock_screen = 0;
+	memset(ram.level_schunks, 0, sizeof(ram.level_schunks));
+	memset(ram.level_anim, 0, sizeof(ram.level_anim));
+	ram.gfx_big_ring = 0;
+	ram.convey_rev = 0;
+	memset(ram.obj63, 0, sizeof(ram.obj63));
+	ram.tunnel_mode = 0;
+	ram.lock_multi = 0;
+	ram.tunnel_allow = 0;
+	ram.jump_only = 0;
+	ram.obj6B = 0;
+	ram.lock_ctrl = false;
+	ram.big_ring = 0;
+	ram.item_bonus = 0;
+	ram.time_bonus = 0;
+	ram.ring_bonus = 0;
+	ram.endact_bonus = 0;
+	ram.sonicend = 0;
+	ram.lz_deform = 0;
+	memset(ram.f_switch, 0, sizeof(ram.f_switch));
+	
+	ram.scroll_block1_size = 0;
+	ram.scroll_block2_size = 0;
+	ram.scroll_block3_size = 0;
+	ram.scroll_block4_size = 0;
 	
 	//FE60 to FF80
-	memset(oscillatory.state, 0, sizeof(oscillatory.state));
-	memset(sprite_anim, 0, sizeof(sprite_anim));
-	sprite_anim_3buf = 0;
-	
-	limit_top_db = 0;
-	limit_btm_db = 0;
-	
-	scrpos_x_dup.v = 0;
-	scrpos_y_dup.v = 0;
-	bg_scrpos_x_dup.v = 0;
-	bg_scrpos_y_dup.v = 0;
-	bg2_scrpos_x_dup.v = 0;
-	bg2_scrpos_y_dup.v = 0;
-	bg3_scrpos_x_dup.v = 0;
-	bg3_scrpos_y_dup.v = 0;
-	
-	fg_scroll_flags_dup = 0;
-	bg1_scroll_flags_dup = 0;
-	bg2_scroll_flags_dup = 0;
-	bg3_scroll_flags_dup = 0;
+	memset(ram.oscillatory.state, 0, sizeof(ram.oscillatory.state));
+	memset(ram.sprite_anim, 0, sizeof(ram.sprite_anim));
+	ram.sprite_anim_3buf = 0;
+	
+	ram.limit_top_db = 0;
+	ram.limit_btm_db = 0;
+	
+	ram.scrpos_x_dup.v = 0;
+	ram.scrpos_y_dup.v = 0;
+	ram.bg_scrpos_x_dup.v = 0;
+	ram.bg_scrpos_y_dup.v = 0;
+	ram.bg2_scrpos_x_dup.v = 0;
+	ram.bg2_scrpos_y_dup.v = 0;
+	ram.bg3_scrpos_x_dup.v = 0;
+	ram.bg3_scrpos_y_dup.v = 0;
+	
+	ram.fg_scroll_flags_dup = 0;
+	ram.bg1_scroll_flags_dup = 0;
+	ram.bg2_scroll_flags_dup = 0;
+	ram.bg3_scroll_flags_dup = 0;
 	
 	//Clear screen
 	ClearScreen();
@@ -197,198 +273,210 @@ void GM_Level()
 	VDP_SetBackgroundColour(0x20); //Line 2, entry 0
 	
 	//Load water
-	hbla_pos = (SCREEN_HEIGHT - 1);
-	if (LEVEL_ZONE(level_id) == ZoneId_LZ)
+	ram.hbla_pos = (SCREEN_HEIGHT - 1);
+	if (LEVEL_ZONE(ram.level_id) == ZoneId_LZ)
 	{
 		//TODO
 	}
-	air = 30;
+	ram.air = 30;
 	
 	//Load Sonic's palette
 	PalLoad2(PalId_Sonic);
-	if (LEVEL_ZONE(level_id) == ZoneId_LZ)
-		PalLoad3_Water((LEVEL_ACT(level_id) == 3) ? PalId_SonicSBZ : PalId_SonicLZ);
-	if (last_lamp)
+	if (LEVEL_ZONE(ram.level_id) == ZoneId_LZ)
+		PalLoad3_Water((LEVEL_ACT(ram.level_id) == 3) ? PalId_SonicSBZ : PalId_SonicLZ);
+	if (ram.last_lamp)
 		{;}//move.b	($FFFFFE53).w,(f_wtr_state).w //TODO
 	
-	if (demo >= 0)
+	if (ram.demo >= 0)
 	{
 		//Load music
 		//TODO
 		
 		//Start title card
-		objects[2].type = ObjId_TitleCard;
+		ram.objects[2].type = ObjId_TitleCard;
 		
 		do
 		{
 			//Run game and load PLCs
-			vbla_routine = 0x0C;
+			ram.vbla_routine = 0x0C;
 			WaitForVBla();
 			ExecuteObjects();
 			BuildSprites(NULL);
 			RunPLC();
-		} while (objects[4].pos.s.x != objects[4].scratch.u16[4] || plc_buffer[0].art != NULL);
+		} while (ram.objects[4].pos.s.x != ram.objects[4].scratch.u16[4] || ram.plc_buffer[0].art != NULL);
 		
 		//Initialize HUD
 		HUD_Base();
+		GM_Level_LoadTime("title card");
 	}
 	
 	//Load level
 	PalLoad1(PalId_Sonic);
 	LevelSizeLoad();
 	DeformLayers();
-	fg_scroll_flags |= SCROLL_FLAG_LEFT; //OK
+	ram.fg_scroll_flags |= SCROLL_FLAG_LEFT; //OK
+	GM_Level_LoadTime("level size");
 	LevelDataLoad();
+	GM_Level_LoadTime("level data");
 	LoadTilesFromStart();
+	GM_Level_LoadTime("tiles");
 	FloorLog_Unk();
 	ColIndexLoad();
+	GM_Level_LoadTime("collision");
 	
 	//Create player and HUD objects
 	player->type = ObjId_Sonic;
-	if (demo >= 0)
-		objects[1].type = ObjId_HUD;
+	if (ram.demo >= 0)
+		ram.objects[1].type = ObjId_HUD;
 	
 	//Handle debug mode cheat
-	if (debug_cheat && (jpad1_hold1 & JPAD_A))
-		debug_mode = true;
-	jpad1_hold2 = 0;
-	jpad1_press2 = 0;
-	jpad1_hold1 = 0;
-	jpad1_press1 = 0;
+	if (ram.debug_cheat && (ram.jpad1_hold1 & JPAD_A))
+		ram.debug_mode = true;
+	ram.jpad1_hold2 = 0;
+	ram.jpad1_press2 = 0;
+	ram.jpad1_hold1 = 0;
+	ram.jpad1_press1 = 0;
 	
 	//Load level objects
 	ObjPosLoad();
+	if (stress_objects)
+		StressRings(stress_objects);
 	ExecuteObjects();
 	BuildSprites(NULL);
+	GM_Level_LoadTime("objects");
 	
 	//Initialize game state
-	if (!last_lamp)
+	if (!ram.last_lamp)
 	{
-		rings = 0;
-		time.pad = time.min = time.sec = time.frame = 0;
-		life_num = 0;
+		ram.rings = 0;
+		ram.time.pad = ram.time.min = ram.time.sec = ram.time.frame = 0;
+		ram.life_num = 0;
 	}
 	
-	time_over = false;
-	shield = false;
-	invincibility = false;
-	shoes = false;
-	debug_use = false;
-	restart = false;
-	frame_count = 0;
+	ram.time_over = false;
+	ram.shield = false;
+	ram.invincibility = false;
+	ram.shoes = false;
+	ram.debug_use = false;
+	ram.restart = false;
+	ram.frame_count = 0;
 	
 	//OscillateNumInit();
 	
-	score_count = true;
-	ring_count = true;
-	time_count = true;
+	ram.score_count = true;
+	ram.ring_count = true;
+	ram.time_count = true;
 	
 	//Initialize demo
-	btn_pushtime1 = 0;
+	ram.btn_pushtime1 = 0;
 	
 	const uint8_t *demo_data;
-	if (demo < 0)
-		demo_data = ending_demo_ptr[credits_num - 1];
+	if (ram.demo < 0)
+		demo_data = ending_demo_ptr[ram.credits_num - 1];
 	else
-		demo_data = intro_demo_ptr[LEVEL_ZONE(level_id)];
-	btn_pushtime2 = demo_data[1] - 1;
-	if (demo < 0)
-		demo_length = (credits_num == 4) ? 510 : 540; //Credits length
+		demo_data = intro_demo_ptr[LEVEL_ZONE(ram.level_id)];
+	ram.btn_pushtime2 = demo_data[1] - 1;
+	if (ram.demo < 0)
+		ram.demo_length = (ram.credits_num == 4) ? 510 : 540; //Credits length
 	else
-		demo_length = 1800; //Demo length
+		ram.demo_length = 1800; //Demo length
 	
 	//Load level's water palette
-	if (LEVEL_ZONE(level_id) == ZoneId_LZ)
-		PalLoad4_Water((LEVEL_ACT(level_id) == 3) ? PalId_LZWater : PalId_SBZ3Water);
+	if (LEVEL_ZONE(ram.level_id) == ZoneId_LZ)
+		PalLoad4_Water((LEVEL_ACT(ram.level_id) == 3) ? PalId_LZWater : PalId_SBZ3Water);
 	
 	//Wait for 4 frames
 	for (int i = 0; i < 4; i++)
 	{
-		vbla_routine = 0x08;
+		ram.vbla_routine = 0x08;
 		WaitForVBla();
 	}
 	
 	//Fade into level
 	PaletteFadeIn_At(0x10, 0x30);
+	GM_Level_LoadTime("fade in");
 	
 	//Tell title card to move away
-	objects[2].routine += 2;
-	objects[3].routine += 4;
-	objects[4].routine += 4;
-	objects[5].routine += 4;
+	ram.objects[2].routine += 2;
+	ram.objects[3].routine += 4;
+	ram.objects[4].routine += 4;
+	ram.objects[5].routine += 4;
 	
 	//Load missing art in credits demos
-	if (demo < 0)
+	if (ram.demo < 0)
 	{
 		AddPLC(PlcId_Explode);
-		AddPLC(PlcId_GHZAnimals + LEVEL_ZONE(level_id));
+		AddPLC(PlcId_GHZAnimals + LEVEL_ZONE(ram.level_id));
 	}
 	
 	//Enter level loop
-	gamemode &= 0x7F;
+	ram.gamemode &= 0x7F;
 	while (1)
 	{
-		//Run frame
-		vbla_routine = 0x08;
-		WaitForVBla();
-		frame_count++;
-		
-		MoveSonicInDemo();
-		//LZWaterFeatures();
-		
-		//Run game
-		ExecuteObjects();
-		#ifndef SCP_REV00
-			//Restart level gamemode if restart flag set
-			if (restart)
-				goto GM_Level_Branch;
-		#endif
+		//Run frame (hidden when running ahead, the speculative frame is presented instead)
+		bool restart_now;
+		if (rollback_active && ram.gamemode == GameMode_Level)
+		{
+			//Netplay frames roll back instead of running ahead
+			restart_now = Rollback_Frame(GM_Level_Frame);
+		}
+		else
+		{
+			bool run_ahead = runahead_frames != 0 && ram.gamemode == GameMode_Level;
+			if (run_ahead)
+				VDP_SetFrameFlags(VDP_FRAME_EVENTS);
+			
+			restart_now = GM_Level_Frame();
+			
+			if (run_ahead)
+				RunAhead(GM_Level_AheadFrame, !ram.restart && ram.gamemode == GameMode_Level);
+		}
 		
-		//Setup video and load PLCs
-		if (debug_use || player->routine < 6)
-			DeformLayers();
-		BuildSprites(NULL);
-		ObjPosLoad();
-		PaletteCycle();
-		RunPLC();
+		//Report the total load time once the first frame has run
+		if (load_timing)
+		{
+			GM_Level_LoadTime("first frame");
+			printf("GM_Level: %-16s %9.3f ms\n", "total", (load_time_stage - load_time_start) / 1000.0);
+			load_timing = false;
+		}
 		
-		//Other level stuff
-		SynchroAnimate();
-		SignpostArtLoad();
+		//Restart level gamemode if restart flag set
+		if (restart_now)
+			goto GM_Level_Branch;
 		
 		//Check if level loop should end
-		if (gamemode != GameMode_Demo)
+		if (ram.gamemode != GameMode_Demo)
 		{
 			#ifdef SCP_REV00
 				//Restart level gamemode if restart flag set
-				if (restart)
+				if (ram.restart)
 					goto GM_Level_Branch;
 			#endif
 			
 			//Break if exited the level gamemode
-			if (gamemode != GameMode_Level)
+			if (ram.gamemode != GameMode_Level)
 				break;
 		}
 		else
 		{
 			//Begin to fade if restart flag set or demo ended
-			if (restart || !demo_length)
+			if (ram.restart || !ram.demo_length)
 			{
 				//Get next game mode
-				if (gamemode == GameMode_Demo) //I HATE YOU
-					gamemode = (demo < 0) ? GameMode_Credits : GameMode_Sega;
+				if (ram.gamemode == GameMode_Demo) //I HATE YOU
+					ram.gamemode = (ram.demo < 0) ? GameMode_Credits : GameMode_Sega;
 				
 				//Prepare fade
-				demo_length = 60;
-				palette_fade.ind = 0;
-				palette_fade.len = 0x40;
-				pal_chgspeed = 0;
+				ram.demo_length = 60;
+				ram.palette_fade.ind = 0;
+				ram.palette_fade.len = 0x40;
+				ram.pal_chgspeed = 0;
 				
 				//Fade loop
 				do
 				{
 					//Run frame
-					vbla_routine = 0x08;
+					ram.vbla_routine = 0x08;
 					WaitForVBla();
 					
 					MoveSonicInDemo();
@@ -399,18 +487,18 @@ void GM_Level()
 					ObjPosLoad();
 					
 					//Fade
-					if (--pal_chgspeed < 0)
+					if (--ram.pal_chgspeed < 0)
 					{
-						pal_chgspeed = 2;
+						ram.pal_chgspeed = 2;
 						FadeOut_ToBlack();
 					}
-				} while (demo_length);
+				} while (ram.demo_length);
 				break;
 			}
-			else if (gamemode != GameMode_Demo) //Condition never met
+			else if (ram.gamemode != GameMode_Demo) //Condition never met
 			{
 				//Go to SEGA game mode
-				gamemode = GameMode_Sega;
+				ram.gamemode = GameMode_Sega;
 				break;
 			}
 		}
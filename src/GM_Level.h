@@ -1,3 +1,12 @@
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//Level gamemode globals
+extern bool level_load_time;
+
+//Level gamemode
 void GM_Level();
+const uint8_t *GM_Level_GetArt(size_t i);
@@ -13,8 +13,8 @@
 #include <string.h>
 
 //SSRG memory
-#define ssrg_scroll_fg (*(int16_t*)(buffer0000 + 0x7800))
-#define ssrg_scroll_bg (*(int16_t*)(buffer0000 + 0x7808))
+#define ssrg_scroll_fg (*(int16_t*)(ram.buffer0000 + 0x7800))
+#define ssrg_scroll_bg (*(int16_t*)(ram.buffer0000 + 0x7808))
 
 //SSRG assets
 static const uint8_t art_link[] = {
@@ -83,7 +83,7 @@ static void SRG_ScrollFG()
 	int16_t *bufp;
 	
 	//Scroll FG
-	bufp = &hscroll_buffer[115][0];
+	bufp = &ram.hscroll_buffer[115][0];
 	
 	int16_t scroll_fg = ssrg_scroll_fg + 0x30;
 	if (scroll_fg < 0xF7)
@@ -95,7 +95,7 @@ static void SRG_ScrollFG()
 	}
 	
 	//Scroll BG
-	bufp = &hscroll_buffer[0][0];
+	bufp = &ram.hscroll_buffer[0][0];
 	
 	int16_t scroll_bg = ssrg_scroll_bg;
 	for (int i = 0; i < SCREEN_HEIGHT; i++)
@@ -114,7 +114,7 @@ static void SRG_DrawFG()
 		
 		//Get scroll offsets
 		size_t offset = MAP_PLANE(VRAM_FG, 2, 14) + PLANE_WIDEADD + PLANE_TALLADD + scroll_off;
-		const uint8_t *mapp = buffer0000 + scroll_off;
+		const uint8_t *mapp = ram.buffer0000 + scroll_off;
 		
 		//Write plane data
 		for (int i = 0; i < 3; i++)
@@ -143,14 +143,14 @@ static void SRG_DrawFG()
 			add = 0x0000; //White
 		else
 			add = 0x2000; //Grey
-		CopyTilemap_Add(buffer0000, 0xC704 + PLANE_WIDEADD, 35, 3, add);
+		CopyTilemap_Add(ram.buffer0000, 0xC704 + PLANE_WIDEADD, 35, 3, add);
 	}
 }
 
 static void UpdateScrollPositions(Object *obj)
 {
 	ssrg_scroll_bg = obj->pos.s.x;
-	vid_bg_scrpos_y_dup = -obj->pos.s.y;
+	ram.vid_bg_scrpos_y_dup = -obj->pos.s.y;
 }
 
 //SSRG objects
@@ -316,10 +316,10 @@ static void Obj_Square(Object *obj)
 		uint16_t width, height;
 		uint32_t pad;
 	} map_ram_data[] = {
-		{&buffer0000[0x4000], MAP_PLANE(VRAM_BG, 2, 2), 0x000B, 0x000B, 0},
-		{&buffer0000[0x4120], MAP_PLANE(VRAM_BG, 0, 0), 0x000F, 0x000F, 0},
-		{&buffer0000[0x4320], MAP_PLANE(VRAM_BG, 0, 0), 0x0010, 0x0010, 0},
-		{&buffer0000[0x4562], MAP_PLANE(VRAM_BG, 0, 0), 0x000F, 0x000F, 0},
+		{&ram.buffer0000[0x4000], MAP_PLANE(VRAM_BG, 2, 2), 0x000B, 0x000B, 0},
+		{&ram.buffer0000[0x4120], MAP_PLANE(VRAM_BG, 0, 0), 0x000F, 0x000F, 0},
+		{&ram.buffer0000[0x4320], MAP_PLANE(VRAM_BG, 0, 0), 0x0010, 0x0010, 0},
+		{&ram.buffer0000[0x4562], MAP_PLANE(VRAM_BG, 0, 0), 0x000F, 0x000F, 0},
 	};
 	
 	switch (obj->routine)
@@ -361,14 +361,14 @@ static void Obj_Square(Object *obj)
 				obj->ysp = -0x400;
 				
 				//Knock 'SSRG' text
-				objects[0].xsp = 0x300;
-				objects[0].ysp = -0x400;
-				objects[1].xsp = 0x300;
-				objects[1].ysp = -0x300;
-				objects[2].xsp = 0x300;
-				objects[2].ysp = -0x200;
-				objects[3].xsp = 0x300;
-				objects[3].ysp = -0x100;
+				ram.objects[0].xsp = 0x300;
+				ram.objects[0].ysp = -0x400;
+				ram.objects[1].xsp = 0x300;
+				ram.objects[1].ysp = -0x300;
+				ram.objects[2].xsp = 0x300;
+				ram.objects[2].ysp = -0x200;
+				ram.objects[3].xsp = 0x300;
+				ram.objects[3].ysp = -0x100;
 			}
 			break;
 		case 8: //Knocked back and landing
@@ -391,10 +391,10 @@ static void Obj_Square(Object *obj)
 			if (speed < 0)
 			{
 				//Invert palette brightness
-				if (dry_palette[3][1] != 0xE0E)
-					dry_palette[3][1] += 0x202;
-				if (dry_palette[3][3] != 0x404)
-					dry_palette[3][3] -= 0x202;
+				if (ram.dry_palette[3][1] != 0xE0E)
+					ram.dry_palette[3][1] += 0x202;
+				if (ram.dry_palette[3][3] != 0x404)
+					ram.dry_palette[3][3] -= 0x202;
 			}
 			else
 			{
@@ -528,7 +528,7 @@ static void Obj_SonicNeon(Object *obj)
 	//Palette cycle
 	if (!(ssrg_scroll_fg & 0x7))
 	{
-		uint16_t *fromp = &dry_palette[3][4];
+		uint16_t *fromp = &ram.dry_palette[3][4];
 		uint16_t *top = fromp;
 		uint16_t temp = *fromp++;
 		*top++ = *fromp++;
@@ -542,6 +542,13 @@ static void Obj_SonicNeon(Object *obj)
 	DisplaySprite(obj);
 }
 
+const uint8_t *GM_SSRG_GetArt(size_t i)
+{
+	//Get the i-th art loaded by the splash screen
+	static const uint8_t *const art[] = {art_main, art_square, art_sonic, art_link};
+	return (i < (sizeof(art) / sizeof(*art))) ? art[i] : NULL;
+}
+
 //SSRG splash game mode
 void GM_SSRG()
 {
@@ -556,12 +563,12 @@ void GM_SSRG()
 	ClearScreen();
 	
 	//Clear object memory
-	memset(objects, 0, sizeof(objects));
+	ClearObjects();
 	
 	//Initialize VDP and video state
 	VDP_SetBackgroundColour(0);
-	vid_scrpos_y_dup = -8;
-	vid_bg_scrpos_y_dup = -44;
+	ram.vid_scrpos_y_dup = -8;
+	ram.vid_bg_scrpos_y_dup = -44;
 	
 	//Decompress art into VRAM
 	VDP_SeekVRAM(0x0020);
@@ -574,46 +581,46 @@ void GM_SSRG()
 	NemDec(art_link);
 	
 	//Decompress mappings
-	KosDec(map_link, buffer0000);
-	CopyTilemap(buffer0000, MAP_PLANE(VRAM_FG, 4, 24) + PLANE_WIDEADD + (PLANE_TALLADD * 2), 32, 1);
+	KosDec(map_link, ram.buffer0000);
+	CopyTilemap(ram.buffer0000, MAP_PLANE(VRAM_FG, 4, 24) + PLANE_WIDEADD + (PLANE_TALLADD * 2), 32, 1);
 	
-	KosDec(map_main, &buffer0000[0x0000]);
-	KosDec(map_square, &buffer0000[0x4000]);
+	KosDec(map_main, &ram.buffer0000[0x0000]);
+	KosDec(map_square, &ram.buffer0000[0x4000]);
 	
 	//Copy palette
-	memcpy(&dry_palette_dup[0][0], pal_ssrg, sizeof(pal_ssrg));
+	memcpy(&ram.dry_palette_dup[0][0], pal_ssrg, sizeof(pal_ssrg));
 	
 	//Load objects and fade in
-	objects[0].type = 1; //S
-	objects[1].type = 2; //S
-	objects[2].type = 3; //R
-	objects[3].type = 4; //G
+	ram.objects[0].type = 1; //S
+	ram.objects[1].type = 2; //S
+	ram.objects[2].type = 3; //R
+	ram.objects[3].type = 4; //G
 	PaletteFadeIn();
-	memset(&buffer0000[0x7800], 0, 4*3);
+	memset(&ram.buffer0000[0x7800], 0, 4*3);
 	
 	//Run loop
 	do
 	{
 		//Render frame
-		vbla_routine = 0x04;
+		ram.vbla_routine = 0x04;
 		WaitForVBla();
 		ssrg_scroll_fg++;
 		
 		//Run objects
-		Object *objectp = objects;
+		Object *objectp = ram.objects;
 		Obj_Letters(objectp++); //S
 		Obj_Letters(objectp++); //S
 		Obj_Letters(objectp++); //R
 		Obj_Letters(objectp++); //G
 		Obj_Square(objectp++); //Square
-		Obj_SonicNeon(&objects[5]); //Neon Sonic (not sure why it directly addresses here)
+		Obj_SonicNeon(&ram.objects[5]); //Neon Sonic (not sure why it directly addresses here)
 		
 		//Draw screen
 		SRG_ScrollFG();
 		SRG_DrawFG();
 		BuildSprites(NULL);
-	} while (!(jpad1_press1 & JPAD_START) && ssrg_scroll_fg < 0x200);
+	} while (!(ram.jpad1_press1 & JPAD_START) && ssrg_scroll_fg < 0x200);
 	
 	//Go to title gamemode
-	gamemode = GameMode_Title;
+	ram.gamemode = GameMode_Title;
 }
@@ -1,3 +1,7 @@
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
 void GM_SSRG();
+const uint8_t *GM_SSRG_GetArt(size_t i);
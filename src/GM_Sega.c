@@ -19,6 +19,13 @@ static ALIGNED2 const uint8_t map_sega[] = {
 	#include RES_REV(Tilemap/Sega)
 };
 
+const uint8_t *GM_Sega_GetArt(size_t i)
+{
+	//Get the i-th art loaded directly instead of through a PLC
+	static const uint8_t *const art[] = {art_sega};
+	return (i < (sizeof(art) / sizeof(*art))) ? art[i] : NULL;
+}
+
 //SEGA gamemode
 void GM_Sega()
 {
@@ -34,7 +41,7 @@ void GM_Sega()
 	VDP_SetPlaneBLocation(VRAM_BG);
 	VDP_SetBackgroundColour(0);
 	
-	wtr_state = 0;
+	ram.wtr_state = 0;
 	
 	//Clear screen and load SEGA graphics
 	ClearScreen();
@@ -50,38 +57,38 @@ void GM_Sega()
 	
 	//Load palette and initialize cycle
 	PalLoad2(PalId_SegaBG);
-	pcyc_num = -10;
-	pcyc_time = 0x0000;
-	pcyc_buffer[6] = 0;
-	pcyc_buffer[5] = 0;
+	ram.pcyc_num = -10;
+	ram.pcyc_time = 0x0000;
+	ram.pcyc_buffer[6] = 0;
+	ram.pcyc_buffer[5] = 0;
 	
 	//Run palette cycle
 	do
 	{
-		vbla_routine = 0x02;
+		ram.vbla_routine = 0x02;
 		WaitForVBla();
 	}
 	while (PCycle_Sega());
 	
 	//Play "SEGA" sound
 	
-	vbla_routine = 0x14;
+	ram.vbla_routine = 0x14;
 	WaitForVBla();
 	
 	//Wait a bit before resuming
-	demo_length = 30;
+	ram.demo_length = 30;
 	do
 	{
-		vbla_routine = 0x02;
+		ram.vbla_routine = 0x02;
 		WaitForVBla();
-		if (!demo_length)
+		if (!ram.demo_length)
 			break;
-	} while (!(jpad1_press1 & JPAD_START));
+	} while (!(ram.jpad1_press1 & JPAD_START));
 	
 	//Start title gamemode
 	#ifdef SCP_SPLASH
-		gamemode = GameMode_SSRG;
+		ram.gamemode = GameMode_SSRG;
 	#else
-		gamemode = GameMode_Title;
+		ram.gamemode = GameMode_Title;
 	#endif
 }
@@ -1,3 +1,7 @@
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
 void GM_Sega();
+const uint8_t *GM_Sega_GetArt(size_t i);
@@ -10,14 +10,12 @@
 #include "SpecialStage.h"
 #include "PLC.h"
 #include "Nemesis.h"
+#include "DecCache.h"
 
 #include "Backend/VDP.h"
 
 #include <string.h>
 
-//Title screen state
-uint8_t demo_num;
-
 //Title screen demo list
 static const uint16_t title_demos[] = {
 	LEVEL_ID(ZoneId_GHZ, 0),
@@ -76,23 +74,28 @@ static void LevelSelect()
 */
 
 //Level stuff
-static void PlayLevel()
+void NewGame()
 {
-	gamemode = (jpad1_hold1 & JPAD_A) ? GameMode_Special : GameMode_Level;
-	lives = 3;
-	rings = 0;
-	time.pad = time.min = time.sec = time.frame = 0;
-	score = 0;
-	last_special = 0;
-	emeralds = 0;
-	memset(emerald_list, 0, sizeof(emerald_list));
-	continues = 0;
+	ram.lives = 3;
+	ram.rings = 0;
+	ram.time.pad = ram.time.min = ram.time.sec = ram.time.frame = 0;
+	ram.score = 0;
+	ram.last_special = 0;
+	ram.emeralds = 0;
+	memset(ram.emerald_list, 0, sizeof(ram.emerald_list));
+	ram.continues = 0;
 	#ifndef SCP_REV00
-		score_life = 5000;
+		ram.score_life = 5000;
 	#endif
 	//sfx	bgm_Fade,0,1,1 ; fade out music //TODO
 }
 
+static void PlayLevel()
+{
+	ram.gamemode = (ram.jpad1_hold1 & JPAD_A) ? GameMode_Special : GameMode_Level;
+	NewGame();
+}
+
 static void Tit_ChkLevSel()
 {
 	PlayLevel();
@@ -111,6 +114,13 @@ static void Tit_ChkLevSel()
 	*/
 }
 
+const uint8_t *GM_Title_GetArt(size_t i)
+{
+	//Get the i-th art loaded directly instead of through a PLC
+	static const uint8_t *const art[] = {art_japanese_credits, art_credits_font, art_title_fg, art_title_sonic, art_title_tm};
+	return (i < (sizeof(art) / sizeof(*art))) ? art[i] : NULL;
+}
+
 //Title gamemode
 void GM_Title()
 {
@@ -126,28 +136,28 @@ void GM_Title()
 	VDP_SetPlaneBLocation(VRAM_BG);
 	VDP_SetBackgroundColour(0x20); //Line 2, entry 0
 	
-	wtr_state = 0;
+	ram.wtr_state = 0;
 	
 	//Clear screen
 	ClearScreen();
 	
 	//Clear object memory
-	memset(objects, 0, sizeof(objects));
+	ClearObjects();
 	
 	//Load Japanese credits
 	VDP_SeekVRAM(0x0000);
-	NemDec(art_japanese_credits);
+	NemDecCached(art_japanese_credits);
 	VDP_SeekVRAM(0x14C0);
-	NemDec(art_credits_font);
+	NemDecCached(art_credits_font);
 	
 	CopyTilemap(map_japanese_credits, VRAM_FG + PLANE_WIDEADD + PLANE_TALLADD, 40, 24);
 	
 	//Clear palette
-	memset(dry_palette_dup, 0, sizeof(dry_palette_dup));
+	memset(ram.dry_palette_dup, 0, sizeof(ram.dry_palette_dup));
 	PalLoad1(PalId_Sonic);
 	
 	//Load "SONIC TEAM PRESENTS" object
-	objects[2].type = ObjId_Credits;
+	ram.objects[2].type = ObjId_Credits;
 	
 	ExecuteObjects();
 	BuildSprites(NULL);
@@ -157,20 +167,20 @@ void GM_Title()
 	
 	//Load title art
 	VDP_SeekVRAM(0x4000);
-	NemDec(art_title_fg);
+	NemDecCached(art_title_fg);
 	VDP_SeekVRAM(0x6000);
-	NemDec(art_title_sonic);
+	NemDecCached(art_title_sonic);
 	VDP_SeekVRAM(0xA200);
-	NemDec(art_title_tm);
+	NemDecCached(art_title_tm);
 	
 	//Reset game state
-	last_lamp = 0;
-	debug_use = false;
-	demo = 0;
+	ram.last_lamp = 0;
+	ram.debug_use = false;
+	ram.demo = 0;
 	
 	//Load GHZ
-	level_id = LEVEL_ID(ZoneId_GHZ, 0);
-	pcyc_time = 0;
+	ram.level_id = LEVEL_ID(ZoneId_GHZ, 0);
+	ram.pcyc_time = 0;
 	
 	LevelSizeLoad();
 	DeformLayers();
@@ -183,36 +193,46 @@ void GM_Title()
 	
 	//Draw background
 	ClearScreen();
-	DrawChunks(bg_scrpos_x.f.u, bg_scrpos_y.f.u, level_layout[0][1], VRAM_BG);
+	DrawChunks(ram.bg_scrpos_x.f.u, ram.bg_scrpos_y.f.u, ram.level_layout[0][1], VRAM_BG);
 	
 	//Load title mappings
 	CopyTilemap(&map_title_fg[0x0000], MAP_PLANE(VRAM_FG, 3, 4) + PLANE_WIDEADD + PLANE_TALLADD, 34, 22);
 	
 	//Load GHZ art and title palette
 	VDP_SeekVRAM(0x0000);
-	NemDec(art_ghz1);
+	NemDecCached(art_ghz1);
 	PalLoad1(PalId_Title);
 	
 	//Run title screen for 376 frames
-	demo_length = 376;
+	ram.demo_length = 376;
 	
 	//Clear objects
 	#ifdef SCP_FIX_BUGS
-		memset(&objects[2], 0, sizeof(Object));
+		memset(&ram.objects[2], 0, sizeof(Object));
 	#else
-		memset(&objects[2], 0, 0x20); //0x20 instead of the object structure size?
-		                              //This why the "PRESS START BUTTON" text is missing.
+		//Only the first 0x20 bytes of the object are cleared instead of the whole object, which were the fields from type through the radii
+		//This why the "PRESS START BUTTON" text is missing.
+		ram.objects[2].type = ObjId_Null;
+		ram.objects[2].render.b = 0;
+		ram.objects[2].tile = 0;
+		ram.objects[2].mappings = NULL;
+		memset(&ram.objects[2].pos, 0, sizeof(ram.objects[2].pos));
+		ram.objects[2].xsp = 0;
+		ram.objects[2].ysp = 0;
+		ram.objects[2].inertia = 0;
+		ram.objects[2].x_rad = 0;
+		ram.objects[2].y_rad = 0;
 	#endif
 	
 	//Load title objects
-	objects[1].type = ObjId_TitleSonic;
-	objects[2].type = ObjId_PSB;
+	ram.objects[1].type = ObjId_TitleSonic;
+	ram.objects[2].type = ObjId_PSB;
 	#ifndef SCP_JP
-		objects[3].type = ObjId_PSB;
-		objects[3].frame = 3;
+		ram.objects[3].type = ObjId_PSB;
+		ram.objects[3].frame = 3;
 	#endif
-	objects[4].type = ObjId_PSB;
-	objects[4].frame = 2;
+	ram.objects[4].type = ObjId_PSB;
+	ram.objects[4].frame = 2;
 	
 	ExecuteObjects();
 	DeformLayers();
@@ -227,7 +247,7 @@ void GM_Title()
 	do
 	{
 		//Render frame
-		vbla_routine = 0x04;
+		ram.vbla_routine = 0x04;
 		WaitForVBla();
 		
 		//Run game and load PLCs
@@ -243,22 +263,22 @@ void GM_Title()
 		//...and return to the Sega screen after a minute?
 		if ((player->pos.l.x.f.u += 2) >= 0x1C00)
 		{
-			gamemode = GameMode_Sega;
+			ram.gamemode = GameMode_Sega;
 			return;
 		}
 		
 		//TODO: Check for level select cheat
 		
 		//Check if the title's over
-		if (!demo_length)
+		if (!ram.demo_length)
 		{
 			//Run the title screen but with reduced code for 30 frames
-			demo_length = 30;
+			ram.demo_length = 30;
 			
 			do
 			{
 				//Render frame
-				vbla_routine = 0x04;
+				ram.vbla_routine = 0x04;
 				WaitForVBla();
 				
 				//Run game and load PLCs
@@ -269,51 +289,51 @@ void GM_Title()
 				//Move Sonic object
 				if ((player->pos.l.x.f.u += 2) >= 0x1C00)
 				{
-					gamemode = GameMode_Sega;
+					ram.gamemode = GameMode_Sega;
 					return;
 				}
 				
 				//Check if start is pressed
-				if (jpad1_press1 &= JPAD_START)
+				if (ram.jpad1_press1 &= JPAD_START)
 				{
 					Tit_ChkLevSel();
 					return;
 				}
-			} while (demo_length);
+			} while (ram.demo_length);
 			
 			//Load demo
 			//sfx	bgm_Fade,0,1,1 ; fade out music //TODO
 			
-			level_id = title_demos[demo_num & 7];
-			if (++demo_num >= 4)
-				demo_num = 0;
+			ram.level_id = title_demos[ram.demo_num & 7];
+			if (++ram.demo_num >= 4)
+				ram.demo_num = 0;
 			
 			//Enter demo gamemode
-			demo = 1;
-			if (level_id != 0x600)
+			ram.demo = 1;
+			if (ram.level_id != 0x600)
 			{
 				//Regular level
-				gamemode = GameMode_Demo;
+				ram.gamemode = GameMode_Demo;
 			}
 			else
 			{
 				//Special stage
-				gamemode = GameMode_Special;
-				level_id = 0;
-				last_special = 0;
+				ram.gamemode = GameMode_Special;
+				ram.level_id = 0;
+				ram.last_special = 0;
 			}
 			
 			//Set game state
-			lives = 3;
-			rings = 0;
-			time.pad = time.min = time.sec = time.frame = 0;
-			score = 0;
+			ram.lives = 3;
+			ram.rings = 0;
+			ram.time.pad = ram.time.min = ram.time.sec = ram.time.frame = 0;
+			ram.score = 0;
 			#ifndef SCP_REV00
-				score_life = 5000;
+				ram.score_life = 5000;
 			#endif
 			return;
 		}
-	} while (!(jpad1_press1 &= JPAD_START));
+	} while (!(ram.jpad1_press1 &= JPAD_START));
 	
 	Tit_ChkLevSel();
 }
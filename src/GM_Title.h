@@ -1,3 +1,11 @@
 #pragma once
 
+#include "RAM.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+//Title gamemode
+void NewGame();
 void GM_Title();
+const uint8_t *GM_Title_GetArt(size_t i);
@@ -9,6 +9,7 @@
 #include "Object/Sonic.h"
 #include "PLC.h"
 #include "HUD.h"
+#include "Rollback.h"
 
 #include "GM_Sega.h"
 #include "GM_Title.h"
@@ -18,24 +19,9 @@
 	#include "GM_SSRG.h"
 #endif
 
-//Game
-ALIGNED4 uint8_t buffer0000[0xA400];
-
-uint8_t gamemode; //MSB acts as a title card flag
-
-int16_t demo;
-uint16_t demo_length;
-uint16_t credits_num;
-
-uint8_t credits_cheat;
-
-uint8_t debug_cheat, debug_mode;
-
-uint8_t jpad2_hold,  jpad2_press; //Joypad 2 state
-uint8_t jpad1_hold1, jpad1_press1; //Joypad 1 state
-uint8_t jpad1_hold2, jpad1_press2; //Sonic controls
-
-uint32_t vbla_count;
+//Boot options
+int start_level = -1; //Level ID to boot straight into, or -1 to boot normally
+unsigned int stress_objects = 0; //Rings to spawn on screen when a level starts, for benchmarking
 
 //Global assets
 const uint8_t art_text[] = {
@@ -45,17 +31,19 @@ const uint8_t art_text[] = {
 //General game functions
 void ReadJoypads()
 {
-	uint8_t state;
+	uint8_t state1 = Joypad_GetState1();
+	uint8_t state2 = Joypad_GetState2();
+	
+	//Exchange input with the netplay peer
+	Rollback_Input(&state1, &state2);
 	
 	//Read joypad 1
-	state = Joypad_GetState1();
-	jpad1_press1 = state & ~jpad1_hold1;
-	jpad1_hold1 = state;
+	ram.jpad1_press1 = state1 & ~ram.jpad1_hold1;
+	ram.jpad1_hold1 = state1;
 	
 	//Read joypad 2
-	state = Joypad_GetState2();
-	jpad2_press = state & ~jpad2_hold;
-	jpad2_hold = state;
+	ram.jpad2_press = state2 & ~ram.jpad2_hold;
+	ram.jpad2_hold = state2;
 }
 
 //Game entry point
@@ -65,12 +53,22 @@ void EntryPoint()
 	VDPSetupGame();
 	
 	//Initialize game state
-	gamemode = GameMode_Sega;
+	if (start_level >= 0)
+	{
+		//Start a new game on the given level
+		ram.level_id = (uint16_t)start_level;
+		NewGame();
+		ram.gamemode = GameMode_Level;
+	}
+	else
+	{
+		ram.gamemode = GameMode_Sega;
+	}
 	
 	//Run game loop
 	while (1)
 	{
-		switch (gamemode & 0x7F)
+		switch (ram.gamemode & 0x7F)
 		{
 			case GameMode_Sega:
 				GM_Sega();
@@ -92,7 +90,7 @@ void EntryPoint()
 		#endif
 			default:
 				VDPSetupGame();
-				gamemode = GameMode_Sega;
+				ram.gamemode = GameMode_Sega;
 				break;
 		}
 	}
@@ -106,28 +104,28 @@ void WriteVRAMBuffers()
 	
 	//Copy palette
 	VDP_SeekCRAM(0);
-	if (wtr_state)
-		VDP_WriteCRAM(&wet_palette[0][0], 0x40);
+	if (ram.wtr_state)
+		VDP_WriteCRAM(&ram.wet_palette[0][0], 0x40);
 	else
-		VDP_WriteCRAM(&dry_palette[0][0], 0x40);
+		VDP_WriteCRAM(&ram.dry_palette[0][0], 0x40);
 	
 	//Copy buffers
 	VDP_SeekVRAM(VRAM_SPRITES);
-	VDP_WriteVRAM((const uint8_t*)sprite_buffer, sizeof(sprite_buffer));
+	VDP_WriteVRAM((const uint8_t*)ram.sprite_buffer, buffer_sprites_num * sizeof(ram.sprite_buffer[0]));
 	VDP_SeekVRAM(VRAM_HSCROLL);
-	VDP_WriteVRAM((const uint8_t*)hscroll_buffer, sizeof(hscroll_buffer));
+	VDP_WriteVRAM((const uint8_t*)ram.hscroll_buffer, sizeof(ram.hscroll_buffer));
 }
 
 void VBlank()
 {
-	uint8_t routine = vbla_routine;
-	if (vbla_routine != 0x00)
+	uint8_t routine = ram.vbla_routine;
+	if (ram.vbla_routine != 0x00)
 	{
 		//Set VDP state
-		VDP_SetVScroll(vid_scrpos_y_dup, vid_bg_scrpos_y_dup);
+		VDP_SetVScroll(ram.vid_scrpos_y_dup, ram.vid_bg_scrpos_y_dup);
 		
 		//Set screen state
-		vbla_routine = 0x00;
+		ram.vbla_routine = 0x00;
 	}
 	
 	//Run VBlank routine
@@ -137,15 +135,15 @@ void VBlank()
 			WriteVRAMBuffers();
 	//Fallthrough
 		case 0x14:
-			if (demo_length)
-				demo_length--;
+			if (ram.demo_length)
+				ram.demo_length--;
 			break;
 		case 0x04:
 			WriteVRAMBuffers();
 			LoadTilesAsYouMove_BGOnly();
 			ProcessDPLC();
-			if (demo_length)
-				demo_length--;
+			if (ram.demo_length)
+				ram.demo_length--;
 			break;
 		case 0x08:
 			//Read joypad state
@@ -153,42 +151,42 @@ void VBlank()
 			
 			//Copy palette
 			VDP_SeekCRAM(0);
-			if (wtr_state)
-				VDP_WriteCRAM(&wet_palette[0][0], 0x40);
+			if (ram.wtr_state)
+				VDP_WriteCRAM(&ram.wet_palette[0][0], 0x40);
 			else
-				VDP_WriteCRAM(&dry_palette[0][0], 0x40);
+				VDP_WriteCRAM(&ram.dry_palette[0][0], 0x40);
 			
 			//Copy buffers
-			VDP_SetHIntPosition(hbla_pos);
+			VDP_SetHIntPosition(ram.hbla_pos);
 			VDP_SeekVRAM(VRAM_SPRITES);
-			VDP_WriteVRAM((const uint8_t*)sprite_buffer, sizeof(sprite_buffer));
+			VDP_WriteVRAM((const uint8_t*)ram.sprite_buffer, buffer_sprites_num * sizeof(ram.sprite_buffer[0]));
 			VDP_SeekVRAM(VRAM_HSCROLL);
-			VDP_WriteVRAM((const uint8_t*)hscroll_buffer, sizeof(hscroll_buffer));
+			VDP_WriteVRAM((const uint8_t*)ram.hscroll_buffer, sizeof(ram.hscroll_buffer));
 			
 			//Update Sonic's art
-			if (sonframe_chg)
+			if (ram.sonframe_chg)
 			{
 				VDP_SeekVRAM(0xF000);
-				VDP_WriteVRAM(sgfx_buffer, SONIC_DPLC_SIZE);
-				sonframe_chg = false;
+				VDP_UpdateVRAM(ram.sgfx_buffer, SONIC_DPLC_SIZE);
+				ram.sonframe_chg = false;
 			}
 			
 			//Copy duplicate plane positions and flags
-			scrpos_x_dup.v     = scrpos_x.v;
-			scrpos_y_dup.v     = scrpos_y.v;
-			bg_scrpos_x_dup.v  = bg_scrpos_x.v;
-			bg_scrpos_y_dup.v  = bg_scrpos_y.v;
-			bg2_scrpos_x_dup.v = bg2_scrpos_x.v;
-			bg2_scrpos_y_dup.v = bg2_scrpos_y.v;
-			bg3_scrpos_x_dup.v = bg3_scrpos_x.v;
-			bg3_scrpos_y_dup.v = bg3_scrpos_y.v;
+			ram.scrpos_x_dup.v     = ram.scrpos_x.v;
+			ram.scrpos_y_dup.v     = ram.scrpos_y.v;
+			ram.bg_scrpos_x_dup.v  = ram.bg_scrpos_x.v;
+			ram.bg_scrpos_y_dup.v  = ram.bg_scrpos_y.v;
+			ram.bg2_scrpos_x_dup.v = ram.bg2_scrpos_x.v;
+			ram.bg2_scrpos_y_dup.v = ram.bg2_scrpos_y.v;
+			ram.bg3_scrpos_x_dup.v = ram.bg3_scrpos_x.v;
+			ram.bg3_scrpos_y_dup.v = ram.bg3_scrpos_y.v;
 			
-			fg_scroll_flags_dup = fg_scroll_flags;
-			bg1_scroll_flags_dup = bg1_scroll_flags;
-			bg2_scroll_flags_dup = bg2_scroll_flags;
-			bg3_scroll_flags_dup = bg3_scroll_flags;
+			ram.fg_scroll_flags_dup = ram.fg_scroll_flags;
+			ram.bg1_scroll_flags_dup = ram.bg1_scroll_flags;
+			ram.bg2_scroll_flags_dup = ram.bg2_scroll_flags;
+			ram.bg3_scroll_flags_dup = ram.bg3_scroll_flags;
 			
-			if (hbla_pos >= 96) //Uh?
+			if (ram.hbla_pos >= 96) //Uh?
 			{
 				//Scroll camera
 				LoadTilesAsYouMove();
@@ -201,8 +199,8 @@ void VBlank()
 				ProcessDPLC2();
 				
 				//Decrement demo timer
-				if (demo_length)
-					demo_length--;
+				if (ram.demo_length)
+					ram.demo_length--;
 			}
 			break;
 		case 0x0A:
@@ -211,29 +209,29 @@ void VBlank()
 			
 			//Copy palette
 			VDP_SeekCRAM(0);
-			VDP_WriteCRAM(&dry_palette[0][0], 0x40);
+			VDP_WriteCRAM(&ram.dry_palette[0][0], 0x40);
 			
 			//Copy buffers
-			VDP_SetHIntPosition(hbla_pos);
+			VDP_SetHIntPosition(ram.hbla_pos);
 			VDP_SeekVRAM(VRAM_SPRITES);
-			VDP_WriteVRAM((const uint8_t*)sprite_buffer, sizeof(sprite_buffer));
+			VDP_WriteVRAM((const uint8_t*)ram.sprite_buffer, buffer_sprites_num * sizeof(ram.sprite_buffer[0]));
 			VDP_SeekVRAM(VRAM_HSCROLL);
-			VDP_WriteVRAM((const uint8_t*)hscroll_buffer, sizeof(hscroll_buffer));
+			VDP_WriteVRAM((const uint8_t*)ram.hscroll_buffer, sizeof(ram.hscroll_buffer));
 			
 			//Run palette cycle
 			PCycle_SS();
 			
 			//Update Sonic's art
-			if (sonframe_chg)
+			if (ram.sonframe_chg)
 			{
 				VDP_SeekVRAM(0xF000);
-				VDP_WriteVRAM(sgfx_buffer, SONIC_DPLC_SIZE);
-				sonframe_chg = false;
+				VDP_UpdateVRAM(ram.sgfx_buffer, SONIC_DPLC_SIZE);
+				ram.sonframe_chg = false;
 			}
 			
 			//Decrement demo timer
-			if (demo_length)
-				demo_length--;
+			if (ram.demo_length)
+				ram.demo_length--;
 			break;
 		case 0x0C:
 			//Read joypad state
@@ -241,40 +239,40 @@ void VBlank()
 			
 			//Copy palette
 			VDP_SeekCRAM(0);
-			if (wtr_state)
-				VDP_WriteCRAM(&wet_palette[0][0], 0x40);
+			if (ram.wtr_state)
+				VDP_WriteCRAM(&ram.wet_palette[0][0], 0x40);
 			else
-				VDP_WriteCRAM(&dry_palette[0][0], 0x40);
+				VDP_WriteCRAM(&ram.dry_palette[0][0], 0x40);
 			
 			//Copy buffers
-			VDP_SetHIntPosition(hbla_pos);
+			VDP_SetHIntPosition(ram.hbla_pos);
 			VDP_SeekVRAM(VRAM_SPRITES);
-			VDP_WriteVRAM((const uint8_t*)sprite_buffer, sizeof(sprite_buffer));
+			VDP_WriteVRAM((const uint8_t*)ram.sprite_buffer, buffer_sprites_num * sizeof(ram.sprite_buffer[0]));
 			VDP_SeekVRAM(VRAM_HSCROLL);
-			VDP_WriteVRAM((const uint8_t*)hscroll_buffer, sizeof(hscroll_buffer));
+			VDP_WriteVRAM((const uint8_t*)ram.hscroll_buffer, sizeof(ram.hscroll_buffer));
 			
 			//Update Sonic's art
-			if (sonframe_chg)
+			if (ram.sonframe_chg)
 			{
 				VDP_SeekVRAM(0xF000);
-				VDP_WriteVRAM(sgfx_buffer, SONIC_DPLC_SIZE);
-				sonframe_chg = false;
+				VDP_UpdateVRAM(ram.sgfx_buffer, SONIC_DPLC_SIZE);
+				ram.sonframe_chg = false;
 			}
 			
 			//Copy duplicate plane positions and flags
-			scrpos_x_dup.v     = scrpos_x.v;
-			scrpos_y_dup.v     = scrpos_y.v;
-			bg_scrpos_x_dup.v  = bg_scrpos_x.v;
-			bg_scrpos_y_dup.v  = bg_scrpos_y.v;
-			bg2_scrpos_x_dup.v = bg2_scrpos_x.v;
-			bg2_scrpos_y_dup.v = bg2_scrpos_y.v;
-			bg3_scrpos_x_dup.v = bg3_scrpos_x.v;
-			bg3_scrpos_y_dup.v = bg3_scrpos_y.v;
+			ram.scrpos_x_dup.v     = ram.scrpos_x.v;
+			ram.scrpos_y_dup.v     = ram.scrpos_y.v;
+			ram.bg_scrpos_x_dup.v  = ram.bg_scrpos_x.v;
+			ram.bg_scrpos_y_dup.v  = ram.bg_scrpos_y.v;
+			ram.bg2_scrpos_x_dup.v = ram.bg2_scrpos_x.v;
+			ram.bg2_scrpos_y_dup.v = ram.bg2_scrpos_y.v;
+			ram.bg3_scrpos_x_dup.v = ram.bg3_scrpos_x.v;
+			ram.bg3_scrpos_y_dup.v = ram.bg3_scrpos_y.v;
 			
-			fg_scroll_flags_dup = fg_scroll_flags;
-			bg1_scroll_flags_dup = bg1_scroll_flags;
-			bg2_scroll_flags_dup = bg2_scroll_flags;
-			bg3_scroll_flags_dup = bg3_scroll_flags;
+			ram.fg_scroll_flags_dup = ram.fg_scroll_flags;
+			ram.bg1_scroll_flags_dup = ram.bg1_scroll_flags;
+			ram.bg2_scroll_flags_dup = ram.bg2_scroll_flags;
+			ram.bg3_scroll_flags_dup = ram.bg3_scroll_flags;
 			
 			//Scroll camera
 			LoadTilesAsYouMove();
@@ -295,7 +293,7 @@ void VBlank()
 	//Update music
 	
 	//Increment VBlank counter
-	vbla_count++;
+	ram.vbla_count++;
 }
 
 void HBlank()
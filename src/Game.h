@@ -3,6 +3,7 @@
 #include <stdint.h>
 
 #include "Backend/Joypad.h"
+#include "RAM.h"
 
 //Game types
 typedef enum
@@ -20,28 +21,13 @@ typedef enum
 #endif
 } GameMode;
 
-//Game state
-extern uint8_t buffer0000[0xA400];
-
-extern uint8_t gamemode;
-
-extern int16_t demo;
-extern uint16_t demo_length;
-extern uint16_t credits_num;
-
-extern uint8_t credits_cheat;
-
-extern uint8_t debug_cheat, debug_mode;
-
-extern uint8_t jpad2_hold,  jpad2_press;
-extern uint8_t jpad1_hold1, jpad1_press1;
-extern uint8_t jpad1_hold2, jpad1_press2;
-
-extern uint32_t vbla_count;
-
 //Global assets
 extern const uint8_t art_text[];
 
+//Boot options
+extern int start_level;
+extern unsigned int stress_objects;
+
 //General game functions
 void ReadJoypads();
 
@@ -122,7 +122,7 @@ void HUD_Lives()
 {
 	size_t offset = 0xFBA0;
 	
-	uint32_t value = lives;
+	uint32_t value = ram.lives;
 	
 	const uint32_t *dec = &hud_dec[4];
 	size_t decs = 1;
@@ -164,19 +164,19 @@ void HUD_Base()
 
 void HUD_Update()
 {
-	if (!debug_mode)
+	if (!ram.debug_mode)
 	{
 		//Update score
-		if (score_count)
+		if (ram.score_count)
 		{
-			score_count = false;
-			HUD_WriteNumber(0xDC80, score, &hud_dec[0], 5);
+			ram.score_count = false;
+			HUD_WriteNumber(0xDC80, ram.score, &hud_dec[0], 5);
 		}
 		
 		//Update rings
-		if (ring_count)
+		if (ram.ring_count)
 		{
-			if (ring_count & 0x80)
+			if (ram.ring_count & 0x80)
 			{
 				//Set rings to 0
 				HUD_WriteCmd(0xDF40, hud_cmd_ringbase, 2);
@@ -184,53 +184,53 @@ void HUD_Update()
 			}
 			
 			//Update rings count
-			ring_count = false;
-			HUD_WriteNumber(0xDF40, rings, &hud_dec[3], 2);
+			ram.ring_count = false;
+			HUD_WriteNumber(0xDF40, ram.rings, &hud_dec[3], 2);
 		}
 		
 		//Update time
-		if (time_count)
+		if (ram.time_count)
 		{
 			//Time Over if time is 9:59:59(frames)
-			if (time.pad == 0 && time.min == 9 && time.sec == 59 && time.frame == 59)
+			if (ram.time.pad == 0 && ram.time.min == 9 && ram.time.sec == 59 && ram.time.frame == 59)
 			{
-				time_count = false;
+				ram.time_count = false;
 				KillSonic(player, player);
-				time_over = true;
+				ram.time_over = true;
 				return;
 			}
 			
 			//Increment time
-			if (++time.frame >= 60)
+			if (++ram.time.frame >= 60)
 			{
-				time.frame = 0;
-				if (++time.sec >= 60)
+				ram.time.frame = 0;
+				if (++ram.time.sec >= 60)
 				{
-					time.sec = 0;
-					if (++time.min > 9)
-						time.min = 9;
+					ram.time.sec = 0;
+					if (++ram.time.min > 9)
+						ram.time.min = 9;
 				}
 			}
 			
 			//Write time
-			HUD_WriteNumber2(0xDE40, time.min, &hud_dec[5], 0);
-			HUD_WriteNumber2(0xDEC0, time.sec, &hud_dec[4], 1);
+			HUD_WriteNumber2(0xDE40, ram.time.min, &hud_dec[5], 0);
+			HUD_WriteNumber2(0xDEC0, ram.time.sec, &hud_dec[4], 1);
 		}
 		
 		//Update lives
-		if (life_count)
+		if (ram.life_count)
 			HUD_Lives();
 	}
 	else
 	{
 		//Update position
-		HUD_WriteHex(0xDC40, (scrpos_x.f.u << 16) | player->pos.l.x.f.u);
-		HUD_WriteHex(0xDD40, (scrpos_y.f.u << 16) | player->pos.l.y.f.u);
+		HUD_WriteHex(0xDC40, (ram.scrpos_x.f.u << 16) | player->pos.l.x.f.u);
+		HUD_WriteHex(0xDD40, (ram.scrpos_y.f.u << 16) | player->pos.l.y.f.u);
 		
 		//Update rings
-		if (ring_count)
+		if (ram.ring_count)
 		{
-			if (ring_count & 0x80)
+			if (ram.ring_count & 0x80)
 			{
 				//Set rings to 0
 				HUD_WriteCmd(0xDF40, hud_cmd_ringbase, 2);
@@ -238,11 +238,11 @@ void HUD_Update()
 			}
 			
 			//Update rings count
-			ring_count = false;
-			HUD_WriteNumber(0xDF40, rings, &hud_dec[3], 2);
+			ram.ring_count = false;
+			HUD_WriteNumber(0xDF40, ram.rings, &hud_dec[3], 2);
 		}
 		
 		//Update sprite count
-		HUD_WriteNumber2(0xDEC0, sprite_count, &hud_dec[4], 1);
+		HUD_WriteNumber2(0xDEC0, ram.sprite_count, &hud_dec[4], 1);
 	}
 }
@@ -3,65 +3,73 @@
 #include "Kosinski.h"
 
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-static uint16_t descriptor_field;
-static uint32_t descriptor_bits_remaining;
-const uint8_t *source;
+//Original decompressor (kept as the reference the fast one is checked against)
+typedef struct
+{
+	uint16_t descriptor_field;
+	uint32_t descriptor_bits_remaining;
+	const uint8_t *source;
+} KosRefState;
 
-static void RefreshDescriptorField()
+static void RefreshDescriptorField(KosRefState *state)
 {
-	descriptor_field = source[0] | (source[1] << 8);
-	source += 2;
+	state->descriptor_field = state->source[0] | (state->source[1] << 8);
+	state->source += 2;
 	
-	descriptor_bits_remaining = 16;
+	state->descriptor_bits_remaining = 16;
 }
 
-static bool GetDescriptorBit()
+static bool GetDescriptorBit(KosRefState *state)
 {
-	bool bit = descriptor_field & 1;
+	bool bit = state->descriptor_field & 1;
 	
-	descriptor_field >>= 1;
+	state->descriptor_field >>= 1;
 	
-	if (--descriptor_bits_remaining == 0)
-		RefreshDescriptorField();
+	if (--state->descriptor_bits_remaining == 0)
+		RefreshDescriptorField(state);
 	
 	return bit;
 }
 
-uint8_t* KosDec(const uint8_t *_source, void *_destination)
+uint8_t* KosDecRef(const uint8_t *_source, void *_destination)
 {
-	source = _source;
+	KosRefState state;
+	state.source = _source;
 	uint8_t *destination = _destination;
 	
-	RefreshDescriptorField();
+	RefreshDescriptorField(&state);
 	
 	for (;;)
 	{
-		if (GetDescriptorBit())
+		if (GetDescriptorBit(&state))
 		{
-			*destination++ = *source++;
+			*destination++ = *state.source++;
 		}
 		else
 		{
 			uint32_t length = 0;
 			int32_t offset;
 			
-			if (!GetDescriptorBit())
+			if (!GetDescriptorBit(&state))
 			{
-				if (GetDescriptorBit())
+				if (GetDescriptorBit(&state))
 					length += 2;
 				
-				if (GetDescriptorBit())
+				if (GetDescriptorBit(&state))
 					++length;
 				
 				++length;
 				
-				offset = -0x100 + *source++;
+				offset = -0x100 + *state.source++;
 			}
 			else
 			{
-				uint8_t d0 = *source++;
-				uint8_t d1 = *source++;
+				uint8_t d0 = *state.source++;
+				uint8_t d1 = *state.source++;
 				
 				offset = -0x2000 + (((d1 & 0xF8) << 5) | d0);
 				length = d1 & 7;
@@ -72,7 +80,7 @@ uint8_t* KosDec(const uint8_t *_source, void *_destination)
 				}
 				else
 				{
-					length = *source++;
+					length = *state.source++;
 					
 					if (length == 0)
 						break;
@@ -92,3 +100,353 @@ uint8_t* KosDec(const uint8_t *_source, void *_destination)
 	
 	return destination;
 }
+
+//Stream check
+//Walks a stream like the original decompressor without writing anything, so untrusted data can be checked before it's decompressed
+//KosCheck returns the stream's size and gets its output's, or returns 0 if it reads past size bytes or copies from before the start of its output
+typedef struct
+{
+	const uint8_t *source;
+	size_t left; //Bytes left to read
+	uint16_t field;
+	unsigned int bits;
+	bool overrun;
+} KosCheckState;
+
+static uint8_t KosCheck_Byte(KosCheckState *state)
+{
+	if (state->left == 0)
+	{
+		state->overrun = true;
+		return 0;
+	}
+	state->left--;
+	return *state->source++;
+}
+
+static void KosCheck_Refill(KosCheckState *state)
+{
+	state->field = KosCheck_Byte(state);
+	state->field |= KosCheck_Byte(state) << 8;
+	state->bits = 16;
+}
+
+static bool KosCheck_Bit(KosCheckState *state)
+{
+	bool bit = state->field & 1;
+	state->field >>= 1;
+	if (--state->bits == 0)
+		KosCheck_Refill(state);
+	return bit;
+}
+
+size_t KosCheck(const uint8_t *source, size_t size, size_t *dec_size)
+{
+	//Check raw data
+	size_t raw_size = (size >= 8) ? KosRawSize(source) : 0;
+	if (raw_size != 0)
+	{
+		if (raw_size > size - 8)
+			return 0;
+		*dec_size = raw_size;
+		return 8 + raw_size;
+	}
+	
+	KosCheckState state;
+	state.source = source;
+	state.left = size;
+	state.overrun = false;
+	size_t out = 0;
+	
+	KosCheck_Refill(&state);
+	
+	while (!state.overrun)
+	{
+		if (KosCheck_Bit(&state))
+		{
+			KosCheck_Byte(&state);
+			out++;
+			continue;
+		}
+		
+		size_t length, distance;
+		if (!KosCheck_Bit(&state))
+		{
+			//Inline match
+			length = KosCheck_Bit(&state) << 1;
+			length |= KosCheck_Bit(&state);
+			length += 2;
+			distance = 0x100 - KosCheck_Byte(&state);
+		}
+		else
+		{
+			//Full match
+			uint8_t d0 = KosCheck_Byte(&state);
+			uint8_t d1 = KosCheck_Byte(&state);
+			
+			distance = 0x2000 - (((d1 & 0xF8) << 5) | d0);
+			length = d1 & 7;
+			
+			if (length != 0)
+			{
+				length += 2;
+			}
+			else
+			{
+				length = KosCheck_Byte(&state);
+				if (state.overrun)
+					break;
+				
+				if (length == 0)
+				{
+					//End of stream
+					*dec_size = out;
+					return size - state.left;
+				}
+				
+				if (length == 1)
+					continue;
+				
+				length += 1;
+			}
+		}
+		
+		//Matches can't copy from before the start of the output
+		if (distance > out)
+			return 0;
+		out += length;
+	}
+	return 0;
+}
+
+size_t KosRawSize(const uint8_t *source)
+{
+	#ifdef SCP_PREDECOMPRESS
+		//Data decompressed at build time (PREDECOMPRESS) is tagged "RAWK", followed by its size
+		if (memcmp(source, "RAWK", 4) != 0)
+			return 0;
+		return ((size_t)source[4] << 24) | ((size_t)source[5] << 16) | ((size_t)source[6] << 8) | source[7];
+	#else
+		(void)source;
+		return 0;
+	#endif
+}
+
+//Fast decompressor
+#define KOS_BULK 0x20 //Matches this long or longer that don't overlap are copied with a single memcpy
+
+typedef struct
+{
+	const uint8_t *source;
+	uint32_t field; //Descriptor bits left in the current field
+	unsigned int bits;
+} KosState;
+
+static void KosDec_Refill(KosState *state)
+{
+	state->field = state->source[0] | (state->source[1] << 8);
+	state->source += 2;
+	state->bits = 16;
+}
+
+static bool KosDec_Bit(KosState *state)
+{
+	//The next field is read as soon as the last bit is taken, before any data that follows
+	bool bit = state->field & 1;
+	state->field >>= 1;
+	if (--state->bits == 0)
+		KosDec_Refill(state);
+	return bit;
+}
+
+static unsigned int KosDec_LiteralRun(uint32_t field)
+{
+	//Count set bits from the bottom (the bits above the field are clear, so this never passes its end)
+	#if defined(__GNUC__)
+		return __builtin_ctz(~field);
+	#else
+		unsigned int run = 0;
+		for (; field & 1; field >>= 1)
+			run++;
+		return run;
+	#endif
+}
+
+static void KosDec_Move(uint8_t *destination, const uint8_t *source, size_t length)
+{
+	//Copies in 8 or 4 byte blocks, the last block overlapping the one before it
+	//The source must be at least 8 bytes away from the destination (or not in it at all)
+	if (length >= 8)
+	{
+		for (size_t i = 0; i < length - 8; i += 8)
+			memcpy(destination + i, source + i, 8);
+		memcpy(destination + length - 8, source + length - 8, 8);
+	}
+	else if (length >= 4)
+	{
+		memcpy(destination, source, 4);
+		memcpy(destination + length - 4, source + length - 4, 4);
+	}
+	else
+	{
+		while (length-- != 0)
+			*destination++ = *source++;
+	}
+}
+
+static uint8_t *KosDec_Copy(uint8_t *destination, size_t distance, size_t length)
+{
+	const uint8_t *from = destination - distance;
+	
+	if (distance >= 8)
+	{
+		if (distance >= length && length >= KOS_BULK)
+			memcpy(destination, from, length); //Doesn't overlap
+		else
+			KosDec_Move(destination, from, length);
+	}
+	else if (distance == 1)
+	{
+		//Repeats a single byte
+		memset(destination, *from, length);
+	}
+	else
+	{
+		//Repeats a short pattern
+		for (size_t i = 0; i < length; i++)
+			destination[i] = from[i];
+	}
+	return destination + length;
+}
+
+uint8_t* KosDec(const uint8_t *_source, void *_destination)
+{
+	//Copy raw data
+	size_t raw_size = KosRawSize(_source);
+	if (raw_size != 0)
+	{
+		memcpy(_destination, _source + 8, raw_size);
+		return (uint8_t*)_destination + raw_size;
+	}
+	
+	KosState state;
+	state.source = _source;
+	uint8_t *destination = _destination;
+	
+	KosDec_Refill(&state);
+	
+	for (;;)
+	{
+		//Copy a run of literals at once
+		unsigned int run = KosDec_LiteralRun(state.field);
+		if (run != 0)
+		{
+			if (run < state.bits)
+			{
+				KosDec_Move(destination, state.source, run);
+				destination += run;
+				state.source += run;
+				state.field >>= run;
+				state.bits -= run;
+			}
+			else
+			{
+				//The run takes the rest of the field, which is refilled before the last literal
+				KosDec_Move(destination, state.source, run - 1);
+				destination += run - 1;
+				state.source += run - 1;
+				KosDec_Refill(&state);
+				*destination++ = *state.source++;
+				continue;
+			}
+		}
+		
+		//Read match type (and an inline match's length), taking the bits at once when they're all in the field
+		size_t length, distance;
+		bool full;
+		
+		if (state.bits > 4)
+		{
+			full = (state.field & 2) != 0;
+			if (!full)
+			{
+				length = (((state.field >> 1) & 2) | ((state.field >> 3) & 1)) + 2;
+				state.field >>= 4;
+				state.bits -= 4;
+			}
+			else
+			{
+				state.field >>= 2;
+				state.bits -= 2;
+			}
+		}
+		else
+		{
+			KosDec_Bit(&state);
+			full = KosDec_Bit(&state);
+			if (!full)
+			{
+				length = KosDec_Bit(&state) << 1;
+				length |= KosDec_Bit(&state);
+				length += 2;
+			}
+		}
+		
+		if (!full)
+		{
+			//Inline match, 2 to 5 bytes at most 0x100 back
+			distance = 0x100 - *state.source++;
+		}
+		else
+		{
+			//Full match, 3 to 9 bytes (or 3 to 256 with an extra byte) at most 0x2000 back
+			uint8_t d0 = *state.source++;
+			uint8_t d1 = *state.source++;
+			
+			distance = 0x2000 - (((d1 & 0xF8) << 5) | d0);
+			length = d1 & 7;
+			
+			if (length != 0)
+			{
+				length += 2;
+			}
+			else
+			{
+				length = *state.source++;
+				
+				if (length == 0)
+					break;
+				
+				if (length == 1)
+					continue;
+				
+				length += 1;
+			}
+		}
+		
+		destination = KosDec_Copy(destination, distance, length);
+	}
+	
+	#ifdef SCP_VERIFY_DECOMPRESSION
+		//Check against the original decompressor (this can run on worker threads, so its buffer is allocated here)
+		size_t size = destination - (uint8_t*)_destination;
+		size_t ref_size;
+		uint8_t *verify;
+		if (KosCheck(_source, SIZE_MAX, &ref_size) == 0 || ref_size != size)
+		{
+			printf("KosDec: Output doesn't match the original decompressor\n");
+		}
+		else if ((verify = malloc(size ? size : 1)) == NULL)
+		{
+			printf("KosDec: Failed to allocate verification buffer\n");
+		}
+		else
+		{
+			if ((size_t)(KosDecRef(_source, verify) - verify) != size || memcmp(verify, _destination, size))
+				printf("KosDec: Output doesn't match the original decompressor\n");
+			free(verify);
+		}
+	#endif
+	
+	return destination;
+}
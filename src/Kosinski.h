@@ -1,5 +1,10 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
+size_t KosRawSize(const uint8_t *source);
+size_t KosCheck(const uint8_t *source, size_t size, size_t *dec_size);
+
 uint8_t *KosDec(const uint8_t *source, void *destination);
+uint8_t *KosDecRef(const uint8_t *source, void *destination);
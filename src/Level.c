@@ -4,12 +4,19 @@
 #include "Game.h"
 #include "LevelScroll.h"
 #include "LevelDraw.h"
+#include "LevelCollision.h"
 #include "Kosinski.h"
+#include "DecCache.h"
 #include "PLC.h"
 #include "Palette.h"
 
+#include "Object/Ring.h"
+
 #include "Backend/VDP.h"
+#include "Backend/ResPack.h"
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 //Level layouts
@@ -489,125 +496,33 @@ const uint8_t *level_obj[ZoneId_Num][4][2] = {
 	}
 };
 
-//Level state
-uint16_t level_id;
-
-uint8_t dle_routine;
-
-uint16_t limit_left1, limit_right1, limit_top1, limit_btm1;
-uint16_t limit_left2, limit_right2, limit_top2, limit_btm2;
-uint16_t limit_left3;
-uint16_t limit_top_db, limit_btm_db;
-
-LevelAnim level_anim[6];
-
-uint8_t last_lamp;
-
-uint16_t restart;
-uint16_t pause;
-uint8_t time_over;
-
-uint16_t frame_count;
-
-//Player state
-uint32_t score;
-LevelTime time;
-uint16_t rings;
-uint8_t lives;
-uint8_t continues;
-
-uint32_t score_life;
-
-uint16_t air;
-uint8_t last_special;
-
-uint8_t life_num;
-uint8_t life_count;
-uint8_t ring_count;
-uint8_t time_count;
-uint8_t score_count;
-
-uint8_t shield;
-uint8_t invincibility;
-uint8_t shoes;
-uint8_t debug_use;
-
-//Water state
-int16_t wtr_pos1, wtr_pos2, wtr_pos3;
-uint8_t water;
-uint8_t wtr_routine;
-uint8_t wtr_state;
-
 //Loaded level data
-uint8_t *const level_map256 = &buffer0000[0x0000];
-ALIGNED2 uint8_t level_map16[0x1800];
-uint8_t level_layout[8][2][0x40];
-uint8_t level_schunks[2][2];
-const uint8_t *coll_index;
+uint8_t *const level_map256 = &ram.buffer0000[0x0000];
 
 //Object state
-Object objects[OBJECTS];
-Object *const player = objects;
-Object *const level_objects = objects + RESERVED_OBJECTS;
-
-uint16_t opl_routine;
-int16_t opl_screen;
-const uint8_t *opl_ptr0;
-const uint8_t *opl_ptr4;
-const uint8_t *opl_ptr8;
-const uint8_t *opl_ptrC;
-const uint8_t *opl_layout;
-
-uint8_t objstate_left;
-uint8_t objstate_right;
-uint8_t objstate[0x100];
-
-int16_t obj31_ypos;
-uint8_t boss_status;
-uint8_t lock_screen;
-uint16_t gfx_big_ring;
-uint8_t convey_rev;
-uint8_t obj63[6];
-uint8_t tunnel_mode;
-uint8_t lock_multi;
-uint8_t tunnel_allow;
-uint8_t jump_only;
-uint8_t obj6B;
-uint8_t lock_ctrl;
-uint8_t big_ring;
-uint16_t item_bonus;
-uint16_t time_bonus;
-uint16_t ring_bonus;
-uint8_t endact_bonus;
-uint8_t sonicend;
-uint16_t lz_deform;
-uint8_t f_switch[0x10];
-
-Oscillatory oscillatory;
-
-LevelAnim sprite_anim[4];
-uint16_t sprite_anim_3buf;
+Object *const player = ram.objects;
+Object *const level_objects = ram.objects + RESERVED_OBJECTS;
 
 //Game functions
 void AddPoints(uint16_t points)
 {
 	//Update HUD
-	score_count = 1;
+	ram.score_count = 1;
 	
 	#ifdef SCP_REV00
 		//TODO
 	#else
 		//Increase score
-		if ((score += points) >= 999999)
-			score = 999999;
+		if ((ram.score += points) >= 999999)
+			ram.score = 999999;
 		
 		//Check if we should be rewarded an extra life
-		if (score >= score_life)
+		if (ram.score >= ram.score_life)
 		{
-			score_life += 5000;
+			ram.score_life += 5000;
 			#ifndef SCP_JP
-				lives++;
-				life_count++;
+				ram.lives++;
+				ram.life_count++;
 				//music	bgm_ExtraLife,1,0,0 //TODO
 			#endif
 		}
@@ -618,11 +533,15 @@ void AddPoints(uint16_t points)
 void LoadLevelMaps()
 {
 	//Get header
-	const LevelHeader *header = &level_header[LEVEL_ZONE(level_id)];
+	const LevelHeader *header = &level_header[LEVEL_ZONE(ram.level_id)];
 	
 	//Load chunk maps and tile map
-	KosDec(header->map256, level_map256);
-	memcpy(level_map16, header->map16, header->map16_size);
+	size_t map16_size = header->map16_size;
+	const uint8_t *map16 = ResPack_Get(header->map16, &map16_size);
+	if (map16_size > sizeof(ram.level_map16))
+		map16_size = sizeof(ram.level_map16);
+	KosDecCached(ResPack_Get(header->map256, NULL), level_map256);
+	memcpy(ram.level_map16, map16, map16_size);
 }
 
 void LoadLayout(const uint8_t *from, uint8_t *to)
@@ -643,39 +562,39 @@ void LoadLayout(const uint8_t *from, uint8_t *to)
 void LoadLevelLayout()
 {
 	//Load foreground and background layers
-	memset(level_layout, 0, sizeof(level_layout));
+	memset(ram.level_layout, 0, sizeof(ram.level_layout));
 	LoadLayout(
-		level_layouts[LEVEL_ZONE(level_id)][LEVEL_ACT(level_id)].layout_fg,
-		level_layout[0][0]);
+		ResPack_Get(level_layouts[LEVEL_ZONE(ram.level_id)][LEVEL_ACT(ram.level_id)].layout_fg, NULL),
+		ram.level_layout[0][0]);
 	LoadLayout(
-		level_layouts[LEVEL_ZONE(level_id)][LEVEL_ACT(level_id)].layout_bg,
-		level_layout[0][1]);
+		ResPack_Get(level_layouts[LEVEL_ZONE(ram.level_id)][LEVEL_ACT(ram.level_id)].layout_bg, NULL),
+		ram.level_layout[0][1]);
 }
 
 void LevelSizeLoad()
 {
 	//Reset level state
-	dle_routine = 0;
+	ram.dle_routine = 0;
 	
 	//Get sizes to load
-	const int16_t *sizes = ldef_size[LEVEL_ZONE(level_id)][LEVEL_ACT(level_id)];
+	const int16_t *sizes = ldef_size[LEVEL_ZONE(ram.level_id)][LEVEL_ACT(ram.level_id)];
 	
 	//Load sizes and other stuff
 	/* FFFFF730 = */ sizes++;
-	limit_left2 = *sizes;
-	limit_left1 = *sizes++;
-	limit_right2 = *sizes;
-	limit_right1 = *sizes++;
-	limit_top2 = *sizes;
-	limit_top1 = *sizes++;
-	limit_btm2 = *sizes;
-	limit_btm1 = *sizes++;
-	limit_left3 = limit_left2 + 0x240;
-	look_shift = *sizes++;
+	ram.limit_left2 = *sizes;
+	ram.limit_left1 = *sizes++;
+	ram.limit_right2 = *sizes;
+	ram.limit_right1 = *sizes++;
+	ram.limit_top2 = *sizes;
+	ram.limit_top1 = *sizes++;
+	ram.limit_btm2 = *sizes;
+	ram.limit_btm1 = *sizes++;
+	ram.limit_left3 = ram.limit_left2 + 0x240;
+	ram.look_shift = *sizes++;
 	
 	//Load player start
 	int16_t x, y;
-	if (last_lamp)
+	if (ram.last_lamp)
 	{
 		//TODO
 		//Lamp_LoadInfo();
@@ -684,7 +603,7 @@ void LevelSizeLoad()
 	}
 	else
 	{
-		if (demo < 0)
+		if (ram.demo < 0)
 		{
 			//TODO - in an ending demo
 			x = 0x80;
@@ -693,8 +612,8 @@ void LevelSizeLoad()
 		else
 		{
 			//Level
-			x = ldef_start[LEVEL_ZONE(level_id)][LEVEL_ACT(level_id)][0];
-			y = ldef_start[LEVEL_ZONE(level_id)][LEVEL_ACT(level_id)][1];
+			x = ldef_start[LEVEL_ZONE(ram.level_id)][LEVEL_ACT(ram.level_id)][0];
+			y = ldef_start[LEVEL_ZONE(ram.level_id)][LEVEL_ACT(ram.level_id)][1];
 		}
 		
 		player->pos.l.x.f.u = x;
@@ -704,45 +623,48 @@ void LevelSizeLoad()
 	//Clip camera position against left and right
 	if ((x -= (SCREEN_WIDTH / 2)) < 0) //0 instead of limit_left
 		x = 0;
-	if (x >= limit_right2)
-		x = limit_right2;
-	scrpos_x.f.u = x;
+	if (x >= ram.limit_right2)
+		x = ram.limit_right2;
+	ram.scrpos_x.f.u = x;
 	
 	//Clip camera position against top and bottom
 	if ((y -= (96 + SCREEN_TALLADD2)) < 0) //0 instead of limit_top
 		y = 0;
-	if (y >= limit_btm2)
-		y = limit_btm2;
-	scrpos_y.f.u = y;
+	if (y >= ram.limit_btm2)
+		y = ram.limit_btm2;
+	ram.scrpos_y.f.u = y;
 	
 	//Load other level stuff
 	BgScrollSpeed(x, y);
-	memcpy(&level_schunks[0][0], &ldef_schunks[LEVEL_ZONE(level_id)][0][0], 4);
+	memcpy(&ram.level_schunks[0][0], &ldef_schunks[LEVEL_ZONE(ram.level_id)][0][0], 4);
 	
-	const int16_t *scroll_size = ldef_scrollsize[LEVEL_ZONE(level_id)];
-	scroll_block1_size = *scroll_size++;
-	scroll_block2_size = *scroll_size++;
-	scroll_block3_size = *scroll_size++;
-	scroll_block4_size = *scroll_size++;
+	const int16_t *scroll_size = ldef_scrollsize[LEVEL_ZONE(ram.level_id)];
+	ram.scroll_block1_size = *scroll_size++;
+	ram.scroll_block2_size = *scroll_size++;
+	ram.scroll_block3_size = *scroll_size++;
+	ram.scroll_block4_size = *scroll_size++;
+}
+
+void LevelDataPrefetch()
+{
+	//Start decompressing the chunk maps on a worker, LevelDataLoad picks them up
+	KosDecPrefetch(ResPack_Get(level_header[LEVEL_ZONE(ram.level_id)].map256, NULL), sizeof(ram.buffer0000));
 }
 
 void LevelDataLoad()
 {
 	//Get header
-	const LevelHeader *header = &level_header[LEVEL_ZONE(level_id)];
-	
-	//Load chunk maps and tile map
-	KosDec(header->map256, level_map256);
-	memcpy(level_map16, header->map16, header->map16_size);
+	const LevelHeader *header = &level_header[LEVEL_ZONE(ram.level_id)];
 	
-	//Load level layout
+	//Load chunk maps, tile map and level layout
+	LoadLevelMaps();
 	LoadLevelLayout();
 	
 	//Load level palette
 	PaletteId pal = header->pal;
-	if (level_id == LEVEL_ID(ZoneId_LZ, 3))
+	if (ram.level_id == LEVEL_ID(ZoneId_LZ, 3))
 		pal = PalId_SBZ3;
-	if (level_id == LEVEL_ID(ZoneId_SBZ, 1) || level_id == LEVEL_ID(ZoneId_SBZ, 2))
+	if (ram.level_id == LEVEL_ID(ZoneId_SBZ, 1) || ram.level_id == LEVEL_ID(ZoneId_SBZ, 2))
 		pal = PalId_SBZ2;
 	PalLoad1(pal);
 	
@@ -754,70 +676,71 @@ void LevelDataLoad()
 void ColIndexLoad()
 {
 	//Use zone's collision indices
-	coll_index = level_coli[LEVEL_ZONE(level_id)];
+	ram.coll_index = ResPack_Get(level_coli[LEVEL_ZONE(ram.level_id)], NULL);
+	LoadCollBlocks();
 }
 
 //Dynamic level events
 void DynamicLevelEvents()
 {
 	//Update target scroll limits
-	switch (LEVEL_ZONE(level_id))
+	switch (LEVEL_ZONE(ram.level_id))
 	{
 		case ZoneId_GHZ:
-			switch (LEVEL_ACT(level_id))
+			switch (LEVEL_ACT(ram.level_id))
 			{
 				case 0: //Act 1
-					if ((uint16_t)scrpos_x.f.u >= (0x1780 - SCREEN_WIDEADD2))
-						limit_btm1 = 0x400 - SCREEN_TALLADD;
+					if ((uint16_t)ram.scrpos_x.f.u >= (0x1780 - SCREEN_WIDEADD2))
+						ram.limit_btm1 = 0x400 - SCREEN_TALLADD;
 					else
-						limit_btm1 = 0x300 - SCREEN_TALLADD;
+						ram.limit_btm1 = 0x300 - SCREEN_TALLADD;
 					break;
 				case 1: //Act 2
-					limit_btm1 = 0x300 - SCREEN_TALLADD;
-					if ((uint16_t)scrpos_x.f.u < (0xED0 - SCREEN_WIDEADD2))
+					ram.limit_btm1 = 0x300 - SCREEN_TALLADD;
+					if ((uint16_t)ram.scrpos_x.f.u < (0xED0 - SCREEN_WIDEADD2))
 						break;
-					limit_btm1 = 0x200 - SCREEN_TALLADD;
-					if ((uint16_t)scrpos_x.f.u < (0x1600 - SCREEN_WIDEADD2))
+					ram.limit_btm1 = 0x200 - SCREEN_TALLADD;
+					if ((uint16_t)ram.scrpos_x.f.u < (0x1600 - SCREEN_WIDEADD2))
 						break;
-					limit_btm1 = 0x400 - SCREEN_TALLADD;
-					if ((uint16_t)scrpos_x.f.u < (0x1D60 - SCREEN_WIDEADD2))
+					ram.limit_btm1 = 0x400 - SCREEN_TALLADD;
+					if ((uint16_t)ram.scrpos_x.f.u < (0x1D60 - SCREEN_WIDEADD2))
 						break;
-					limit_btm1 = 0x300 - SCREEN_TALLADD;
+					ram.limit_btm1 = 0x300 - SCREEN_TALLADD;
 					break;
 				case 2: //Act 3
-					switch (dle_routine)
+					switch (ram.dle_routine)
 					{
 						case 0:
-							limit_btm1 = 0x300 - SCREEN_TALLADD;
-							if ((uint16_t)scrpos_x.f.u < (0x380 - SCREEN_WIDEADD2))
+							ram.limit_btm1 = 0x300 - SCREEN_TALLADD;
+							if ((uint16_t)ram.scrpos_x.f.u < (0x380 - SCREEN_WIDEADD2))
 								break;
-							limit_btm1 = 0x310 - SCREEN_TALLADD;
-							if ((uint16_t)scrpos_x.f.u < (0x960 - SCREEN_WIDEADD2))
+							ram.limit_btm1 = 0x310 - SCREEN_TALLADD;
+							if ((uint16_t)ram.scrpos_x.f.u < (0x960 - SCREEN_WIDEADD2))
 								break;
-							if (scrpos_y.f.u >= 0x280 + SCREEN_TALLADD)
+							if (ram.scrpos_y.f.u >= 0x280 + SCREEN_TALLADD)
 							{
-								limit_btm1 = 0x400 - SCREEN_TALLADD;
-								if ((uint16_t)scrpos_x.f.u < (0x1380 - SCREEN_WIDEADD2))
+								ram.limit_btm1 = 0x400 - SCREEN_TALLADD;
+								if ((uint16_t)ram.scrpos_x.f.u < (0x1380 - SCREEN_WIDEADD2))
 								{
-									limit_btm1 = 0x4C0 - SCREEN_TALLADD;
-									limit_btm2 = 0x4C0 - SCREEN_TALLADD;
+									ram.limit_btm1 = 0x4C0 - SCREEN_TALLADD;
+									ram.limit_btm2 = 0x4C0 - SCREEN_TALLADD;
 								}
-								else if ((uint16_t)scrpos_x.f.u >= (0x1700 - SCREEN_WIDEADD2))
+								else if ((uint16_t)ram.scrpos_x.f.u >= (0x1700 - SCREEN_WIDEADD2))
 								{
-									limit_btm1 = 0x300 - SCREEN_TALLADD;
-									dle_routine += 2;
+									ram.limit_btm1 = 0x300 - SCREEN_TALLADD;
+									ram.dle_routine += 2;
 								}
 							}
 							else
 							{
-								limit_btm1 = 0x300 - SCREEN_TALLADD;
-								dle_routine += 2;
+								ram.limit_btm1 = 0x300 - SCREEN_TALLADD;
+								ram.dle_routine += 2;
 							}
 							break;
 						case 2:
-							if ((uint16_t)scrpos_x.f.u < (0x960 - SCREEN_WIDEADD2))
-								dle_routine -= 2;
-							if ((uint16_t)scrpos_x.f.u < (0x2960 - SCREEN_WIDEADD2))
+							if ((uint16_t)ram.scrpos_x.f.u < (0x960 - SCREEN_WIDEADD2))
+								ram.dle_routine -= 2;
+							if ((uint16_t)ram.scrpos_x.f.u < (0x2960 - SCREEN_WIDEADD2))
 								break;
 							//TODO spawn boss
 							break;
@@ -830,22 +753,22 @@ void DynamicLevelEvents()
 	}
 	
 	//Update scroll limits
-	int16_t scroll_diff = limit_btm1 - limit_btm2;
+	int16_t scroll_diff = ram.limit_btm1 - ram.limit_btm2;
 	int16_t spd = 2;
 	
 	if (scroll_diff < 0)
 	{
-		if ((uint16_t)scrpos_y.f.u > limit_btm1)
-			limit_btm2 = scrpos_y.f.u & ~1;
-		limit_btm2 -= spd;
-		bgscrollvert = true;
+		if ((uint16_t)ram.scrpos_y.f.u > ram.limit_btm1)
+			ram.limit_btm2 = ram.scrpos_y.f.u & ~1;
+		ram.limit_btm2 -= spd;
+		ram.bgscrollvert = true;
 	}
 	else if (scroll_diff > 0)
 	{
-		if (((uint16_t)scrpos_y.f.u + 8) >= limit_btm2 && player->status.p.f.in_air)
+		if (((uint16_t)ram.scrpos_y.f.u + 8) >= ram.limit_btm2 && player->status.p.f.in_air)
 			spd *= 4;
-		limit_btm2 += spd;
-		bgscrollvert = true;
+		ram.limit_btm2 += spd;
+		ram.bgscrollvert = true;
 	}
 }
 
@@ -853,34 +776,34 @@ void DynamicLevelEvents()
 void SynchroAnimate()
 {
 	//Spiked log
-	if (--sprite_anim[0].time < 0)
+	if (--ram.sprite_anim[0].time < 0)
 	{
-		sprite_anim[0].time = 11;
-		sprite_anim[0].frame = (sprite_anim[0].frame - 1) & 7;
+		ram.sprite_anim[0].time = 11;
+		ram.sprite_anim[0].frame = (ram.sprite_anim[0].frame - 1) & 7;
 	}
 	
 	//Rings
-	if (--sprite_anim[1].time < 0)
+	if (--ram.sprite_anim[1].time < 0)
 	{
-		sprite_anim[1].time = 7;
-		sprite_anim[1].frame = (sprite_anim[1].frame + 1) & 3;
+		ram.sprite_anim[1].time = 7;
+		ram.sprite_anim[1].frame = (ram.sprite_anim[1].frame + 1) & 3;
 	}
 	
 	//Unused
-	if (--sprite_anim[2].time < 0)
+	if (--ram.sprite_anim[2].time < 0)
 	{
-		sprite_anim[2].time = 7;
-		if (++sprite_anim[2].frame >= 6)
-			sprite_anim[2].frame = 0;
+		ram.sprite_anim[2].time = 7;
+		if (++ram.sprite_anim[2].frame >= 6)
+			ram.sprite_anim[2].frame = 0;
 	}
 	
 	//Bouncing rings
-	if (sprite_anim[3].time != 0)
+	if (ram.sprite_anim[3].time != 0)
 	{
 		//WACKY!!
-		sprite_anim_3buf += (uint8_t)sprite_anim[3].time;
-		sprite_anim[3].frame = (sprite_anim_3buf >> 9) & 3;
-		sprite_anim[3].time--;
+		ram.sprite_anim_3buf += (uint8_t)ram.sprite_anim[3].time;
+		ram.sprite_anim[3].frame = (ram.sprite_anim_3buf >> 9) & 3;
+		ram.sprite_anim[3].time--;
 	}
 }
 
@@ -888,14 +811,14 @@ void SynchroAnimate()
 void SignpostArtLoad()
 {
 	//Check if signpost should load
-	if (debug_use || (level_id & 0xFF) == 2)
+	if (ram.debug_use || (ram.level_id & 0xFF) == 2)
 		return;
 	
 	//Check if we've reached the end of the level
-	int16_t end_x = limit_right2 - 0x100 - SCREEN_WIDEADD2;
-	if (scrpos_x.f.u >= end_x && time_count && limit_left2 != end_x)
+	int16_t end_x = ram.limit_right2 - 0x100 - SCREEN_WIDEADD2;
+	if (ram.scrpos_x.f.u >= end_x && ram.time_count && ram.limit_left2 != end_x)
 	{
-		limit_left2 = end_x;
+		ram.limit_left2 = end_x;
 		NewPLC(PlcId_Signpost);
 	}
 }
@@ -903,21 +826,117 @@ void SignpostArtLoad()
 //Level object loading
 #define LOAD_WIDTH (((SCREEN_WIDTH + 0x80) & ~0x7F) + 0x100) //I dunno
 
-static bool ChkLoadObj(uint8_t index, const uint8_t **entry)
+//Native object layouts
+//Each layout is decoded once, with the first entry and respawn state count at every 0x80 pixel sector, so ObjPosLoad can start anywhere without scanning
+#define OPL_LAYOUTS 0x20
+#define OPL_ENTRIES 0x2000
+#define OPL_SECTORS 0x100 //Covers X positions 0 to 0x7FFF
+
+typedef struct
+{
+	const uint8_t *layout;
+	const OPLEntry *entry;
+	uint16_t sector[OPL_SECTORS]; //First entry at or right of each sector
+	uint8_t state[OPL_SECTORS];   //Entries with a respawn state left of each sector
+} OPLIndex;
+
+static OPLIndex opl_index[OPL_LAYOUTS];
+static size_t opl_index_num;
+static OPLEntry opl_entries_static[OPL_ENTRIES];
+static OPLEntry *opl_entries = opl_entries_static;
+static size_t opl_entries_used;
+
+static const OPLEntry opl_null_entry = {0xFFFF, 0, 0, 0};
+static const OPLIndex opl_null_index = {NULL, &opl_null_entry, {0}, {0}};
+
+static const OPLIndex *OPL_GetIndex(const uint8_t *layout)
+{
+	//Use already decoded layout
+	for (size_t i = 0; i < opl_index_num; i++)
+		if (opl_index[i].layout == layout)
+			return &opl_index[i];
+	
+	//Count entries (including the terminator)
+	size_t entries = 1;
+	for (const uint8_t *entry = layout; ((entry[0] << 8) | (entry[1] << 0)) != 0xFFFF; entry += 6)
+		entries++;
+	
+	if (opl_index_num >= OPL_LAYOUTS || entries > OPL_ENTRIES)
+	{
+		printf("OPL_GetIndex: Out of space for object layouts\n");
+		return &opl_null_index;
+	}
+	if (opl_entries_used + entries > OPL_ENTRIES)
+	{
+		//Decode into a new block, the full one is kept as savestates can still point into it
+		OPLEntry *block = malloc(OPL_ENTRIES * sizeof(OPLEntry));
+		if (block == NULL)
+		{
+			printf("OPL_GetIndex: Out of space for object layouts\n");
+			return &opl_null_index;
+		}
+		opl_entries = block;
+		opl_entries_used = 0;
+	}
+	
+	//Decode entries
+	OPLIndex *index = &opl_index[opl_index_num++];
+	index->layout = layout;
+	
+	OPLEntry *to = &opl_entries[opl_entries_used];
+	index->entry = to;
+	opl_entries_used += entries;
+	
+	for (size_t i = 0; i < entries; i++, to++, layout += 6)
+	{
+		to->x = (layout[0] << 8) | (layout[1] << 0);
+		to->w1 = (layout[2] << 8) | (layout[3] << 0);
+		to->b4 = layout[4];
+		to->subtype = layout[5];
+	}
+	
+	//Index sectors
+	size_t i = 0;
+	uint8_t state = 0;
+	for (unsigned int sector = 0; sector < OPL_SECTORS; sector++)
+	{
+		while (index->entry[i].x < (sector << 7))
+		{
+			if (index->entry[i].b4 & 0x80)
+				state++;
+			i++;
+		}
+		index->sector[sector] = i;
+		index->state[sector] = state;
+	}
+	
+	return index;
+}
+
+static bool ChkLoadObj(uint8_t index, const OPLEntry **entry)
 {
+	#ifdef SCP_RING_MANAGER
+		//Rings are handled by the ring manager
+		if (((*entry)->b4 & 0x7F) == ObjId_Ring)
+		{
+			(*entry)++;
+			return false;
+		}
+	#endif
+	
 	//Handle object state
-	if ((*entry)[4] & 0x80)
+	if ((*entry)->b4 & 0x80)
 	{
-		if (objstate[index] & 0x80)
+		if (ram.objstate[index] & 0x80)
 		{
 			//Object already loaded
-			*entry += 6;
+			(*entry)++;
 			return false;
 		}
 		else
 		{
 			//Object loaded, set flag
-			objstate[index] |= 0x80;
+			ram.objstate[index] |= 0x80;
 		}
 	}
 	
@@ -926,76 +945,119 @@ static bool ChkLoadObj(uint8_t index, const uint8_t **entry)
 	if (obj == NULL)
 		return true; //Result from FindFreeObj, not d0
 	
-	obj->pos.l.x.f.u = ((*entry)[0] << 8) | ((*entry)[1] << 0);
-	*entry += 2;
+	obj->pos.l.x.f.u = (*entry)->x;
 	
-	uint16_t w1 = ((*entry)[0] << 8) | ((*entry)[1] << 0);
-	*entry += 2;
+	uint16_t w1 = (*entry)->w1;
 	obj->pos.l.y.f.u = w1 & 0xFFF;
 	obj->render.b = 0;
 	obj->status.o.b = 0;
 	obj->render.f.x_flip = obj->status.o.f.x_flip = w1 >> 14;
 	obj->render.f.y_flip = obj->status.o.f.y_flip = w1 >> 15;
 	
-	uint8_t b4 = *(*entry)++;
+	uint8_t b4 = (*entry)->b4;
 	if (b4 & 0x80)
 		obj->respawn_index = index;
 	obj->type = b4 & 0x7F;
 	
-	obj->scratch.u8[0] = *(*entry)++; //Subtype
+	obj->scratch.u8[0] = (*entry)->subtype; //Subtype
 	
+	(*entry)++;
+	return false;
+}
+
+static bool LevelData_CheckLayout(const uint8_t *data, size_t size)
+{
+	//Check the layout's dimensions fit in level_layout and its rows are all there
+	return size >= 2 && data[0] < 0x40 && data[1] < 8 && size >= 2 + (size_t)(data[0] + 1) * (data[1] + 1);
+}
+
+static bool LevelData_CheckMap256(const uint8_t *data, size_t size)
+{
+	//Check the chunk map decompresses without reading past its end, into no more than the chunk buffer holds
+	size_t dec_size;
+	return KosCheck(data, size, &dec_size) != 0 && dec_size <= sizeof(ram.buffer0000);
+}
+
+static bool LevelData_CheckObjLayout(const uint8_t *data, size_t size)
+{
+	//Check the object layout is terminated before its end
+	for (size_t i = 0; i + 6 <= size; i += 6)
+		if (((data[i] << 8) | (data[i + 1] << 0)) == 0xFFFF)
+			return true;
 	return false;
 }
 
+int LevelDataRequire()
+{
+	//Make resource packs hold every level resource, each fitting where it's loaded to
+	int result = 0;
+	for (size_t zone = 0; zone < ZoneId_Num; zone++)
+	{
+		result |= ResPack_Require(level_header[zone].map16, sizeof(ram.level_map16), NULL);
+		result |= ResPack_Require(level_header[zone].map256, SIZE_MAX, LevelData_CheckMap256);
+		if (zone < ZoneId_Num - 1)
+			result |= ResPack_Require(level_coli[zone], SIZE_MAX, NULL);
+		
+		for (size_t act = 0; act < 4; act++)
+		{
+			result |= ResPack_Require(level_layouts[zone][act].layout_fg, SIZE_MAX, LevelData_CheckLayout);
+			result |= ResPack_Require(level_layouts[zone][act].layout_bg, SIZE_MAX, LevelData_CheckLayout);
+			result |= ResPack_Require(level_obj[zone][act][0], OPL_ENTRIES * 6, LevelData_CheckObjLayout);
+		}
+	}
+	return result;
+}
+
+void LevelDataReload()
+{
+	//Pick up a replaced resource pack
+	//Only the lookup of the old pack's object layouts is dropped, their entries are kept as savestates can still point into them
+	if (ResPack_Reload())
+		opl_index_num = 0;
+}
+
 void ObjPosLoad()
 {
-	const uint8_t *entry;
+	const OPLEntry *entry;
 	
-	switch (opl_routine)
+	switch (ram.opl_routine)
 	{
 		case 0: //Initialization
 		{
 			//Increment routine
-			opl_routine += 2;
+			ram.opl_routine += 2;
 			
 			//Initialize state
-			opl_layout = level_obj[LEVEL_ZONE(level_id)][LEVEL_ACT(level_id)][0];
-			opl_ptr0 = opl_layout;
-			opl_ptr4 = opl_layout;
-			opl_ptr8 = level_obj[LEVEL_ZONE(level_id)][LEVEL_ACT(level_id)][1];
-			opl_ptrC = level_obj[LEVEL_ZONE(level_id)][LEVEL_ACT(level_id)][1];
+			const OPLIndex *index = OPL_GetIndex(ResPack_Get(level_obj[LEVEL_ZONE(ram.level_id)][LEVEL_ACT(ram.level_id)][0], NULL));
+			ram.opl_layout = index->entry;
+			ram.opl_ptr8 = level_obj[LEVEL_ZONE(ram.level_id)][LEVEL_ACT(ram.level_id)][1];
+			ram.opl_ptrC = level_obj[LEVEL_ZONE(ram.level_id)][LEVEL_ACT(ram.level_id)][1];
 			
-			objstate_left = 1;
-			objstate_right = 1;
-			memset(objstate, 0, sizeof(objstate));
+			memset(ram.objstate, 0, sizeof(ram.objstate));
+			#ifdef SCP_RING_MANAGER
+				Rings_Load(ram.opl_layout);
+			#endif
 			
 			//Load immediately on-screen objects
-			int16_t load_x = (scrpos_x.f.u - 0x80) & ~0x7F;
+			int16_t load_x = (ram.scrpos_x.f.u - 0x80) & ~0x7F;
 			if (load_x < 0)
 				load_x = 0;
 			
-			entry = opl_ptr0;
-			while (load_x > ((entry[0] << 8) | (entry[1] << 0)))
-			{
-				if (entry[4] & 0x80)
-					objstate_right++;
-				entry += 6;
-			}
-			opl_ptr0 = entry;
+			ram.opl_ptr0 = ram.opl_layout + index->sector[load_x >> 7];
+			ram.objstate_right = 1 + index->state[load_x >> 7];
 			
-			entry = opl_ptr4;
 			if ((load_x -= 0x80) >= 0)
 			{
-				while (load_x > ((entry[0] << 8) | (entry[1] << 0)))
-				{
-					if (entry[4] & 0x80)
-						objstate_left++;
-					entry += 6;
-				}
+				ram.opl_ptr4 = ram.opl_layout + index->sector[load_x >> 7];
+				ram.objstate_left = 1 + index->state[load_x >> 7];
+			}
+			else
+			{
+				ram.opl_ptr4 = ram.opl_layout;
+				ram.objstate_left = 1;
 			}
-			opl_ptr4 = entry;
 			
-			opl_screen = -1;
+			ram.opl_screen = -1;
 		}
 	//Fallthrough
 		case 2: //Main
@@ -1003,79 +1065,79 @@ void ObjPosLoad()
 			//Check if screen has scrolled and load objects
 			uint8_t index = 0;
 			
-			int16_t load_x = scrpos_x.f.u & ~0x7F;
+			int16_t load_x = ram.scrpos_x.f.u & ~0x7F;
 			
-			if (load_x < opl_screen)
+			if (load_x < ram.opl_screen)
 			{
 				//Moving left
-				opl_screen = load_x;
+				ram.opl_screen = load_x;
 				
 				//Load objects
-				entry = opl_ptr4;
+				entry = ram.opl_ptr4;
 				if ((load_x -= 0x80) >= 0)
 				{
-					while (entry > opl_layout && load_x < (int16_t)((entry[-6] << 8) | (entry[-5] << 0)))
+					while (entry > ram.opl_layout && load_x < (int16_t)entry[-1].x)
 					{
-						entry -= 6;
-						if (entry[4] & 0x80)
-							index = --objstate_left;
+						entry--;
+						if (entry->b4 & 0x80)
+							index = --ram.objstate_left;
 						
 						//Load object
 						if (!ChkLoadObj(index, &entry))
 						{
-							entry -= 6;
+							entry--;
 						}
 						else
 						{
-							if (entry[4] & 0x80)
-								objstate_left++;
-							entry += 6;
+							if (entry->b4 & 0x80)
+								ram.objstate_left++;
+							entry++;
 							break;
 						}
 					}
 				}
-				opl_ptr4 = entry;
+				ram.opl_ptr4 = entry;
 				
 				//Move right pointer
-				entry = opl_ptr0;
+				entry = ram.opl_ptr0;
 				load_x += 0x80 + LOAD_WIDTH;
-				while (entry > opl_layout && load_x <= ((entry[-6] << 8) | (entry[-5] << 0)))
+				while (entry > ram.opl_layout && load_x <= entry[-1].x)
 				{
-					if (entry[-2] & 0x80)
-						objstate_right--;
-					entry -= 6;
+					if (entry[-1].b4 & 0x80)
+						ram.objstate_right--;
+					entry--;
 				}
-				opl_ptr0 = entry;
+				ram.opl_ptr0 = entry;
 			}
-			else if (load_x > opl_screen)
+			else if (load_x > ram.opl_screen)
 			{
 				//Moving right
-				opl_screen = load_x;
+				ram.opl_screen = load_x;
 				
 				//Load objects
-				entry = opl_ptr0;
+				entry = ram.opl_ptr0;
 				load_x += LOAD_WIDTH;
-				while (load_x > ((entry[0] << 8) | (entry[1] << 0)))
+				while (load_x > entry->x)
 				{
-					if (entry[4] & 0x80)
-						index = objstate_right++;
+					if (entry->b4 & 0x80)
+						index = ram.objstate_right++;
 					
 					//Load object
 					if (ChkLoadObj(index, &entry))
 						break;
 				}
-				opl_ptr0 = entry;
+				ram.opl_ptr0 = entry;
 				
 				//Move left pointer
-				entry = opl_ptr4;
+				entry = ram.opl_ptr4;
 				load_x -= 0x80 + LOAD_WIDTH;
-				while (load_x > ((entry[0] << 8) | (entry[1] << 0)))
+				while (load_x > entry->x)
 				{
-					if (entry[4] & 0x80)
-						objstate_left++;
-					entry += 6;
+					if (entry->b4 & 0x80)
+						ram.objstate_left++;
+					entry++;
 				}
-				opl_ptr4 = entry;
+				ram.opl_ptr4 = entry;
 			}
 			break;
 		}
@@ -15,9 +15,6 @@ static const uint8_t width_map[] = {
 	#include "Resource/Collision/WidthMap.h"
 };
 
-//Collision angle buffer
-uint8_t angle_buffer0, angle_buffer1;
-
 //Level collision interface
 void FloorLog_Unk()
 {
@@ -30,7 +27,7 @@ const uint8_t *FindNearestTile(Object *obj, int16_t x, int16_t y)
 	//Get chunk
 	uint16_t cx = ((uint16_t)x >> 8) & 0x3F;
 	uint16_t cy = ((uint16_t)y >> 8) & 0x7;
-	uint8_t chunk = level_layout[cy][0][cx];
+	uint8_t chunk = ram.level_layout[cy][0][cx];
 	if (chunk == 0)
 		return chunk0_dummy;
 	
@@ -58,56 +55,119 @@ const uint8_t *FindNearestTile(Object *obj, int16_t x, int16_t y)
 	}
 }
 
-static int16_t FindFloor2(Object *obj, int16_t x, int16_t y, uint16_t solid, uint16_t flip, uint8_t *angle)
+//Flattened collision blocks
+//Every block of every chunk is resolved once into its collision tile, solidity, flips and angle, so sensors don't have to go through the block mappings and collision index
+#define COLL_CHUNKS (sizeof(ram.buffer0000) / 0x200) //Chunks that fit in the chunk map buffer
+
+typedef struct
 {
-	//Check tile at given position
-	const uint8_t *tile = FindNearestTile(obj, x, y);
+	uint16_t meta; //Solidity and flip flags (solidity is cleared if the block has no collision)
+	uint8_t ctile; //Collision tile
+	uint8_t angle; //Angle, with the block's flips applied
+} CollBlock;
+
+static CollBlock coll_blocks[1 + COLL_CHUNKS][0x100]; //Chunk 0 is empty, derived from the chunks and collision index in ram (State_Load rebuilds it)
+
+static CollBlock ResolveCollBlock(const uint8_t *tile)
+{
+	//Get block and collision tile
+	CollBlock block = {0, 0, 0};
 	uint16_t tilev = (tile[0] << 8) | (tile[1] << 0);
 	
 	uint16_t tilei = tilev & META_TILE;
+	if (tilei == 0 || ram.coll_index[tilei] == 0)
+		return block;
+	
+	block.meta = tilev & ~META_TILE;
+	block.ctile = ram.coll_index[tilei];
 	
-	if (tilei != 0 && (tilev & solid))
+	//Get angle
+	block.angle = angle_map[block.ctile];
+	if (tilev & META_X_FLIP)
+		block.angle = -block.angle;
+	if (tilev & META_Y_FLIP)
+		block.angle = (-(block.angle + 0x40)) - 0x40;
+	return block;
+}
+
+void LoadCollBlocks()
+{
+	//Resolve every block of the loaded chunks
+	for (size_t chunk = 1; chunk <= COLL_CHUNKS; chunk++)
 	{
-		//Get collision tile
-		uint16_t ctile = coll_index[tilei];
-		if (ctile != 0)
+		const uint8_t *tile = (level_map256 - 0x200) + (chunk << 9);
+		for (size_t i = 0; i < 0x100; i++, tile += 2)
+			coll_blocks[chunk][i] = ResolveCollBlock(tile);
+	}
+}
+
+static uint8_t FindNearestChunk(Object *obj, int16_t x, int16_t y)
+{
+	//Get chunk
+	uint16_t cx = ((uint16_t)x >> 8) & 0x3F;
+	uint16_t cy = ((uint16_t)y >> 8) & 0x7;
+	uint8_t chunk = ram.level_layout[cy][0][cx];
+	
+	if (chunk & 0x80)
+	{
+		//Get chunk id
+		chunk &= 0x7F;
+		if (obj->render.f.player_loop)
 		{
-			//Get angle and height map index
-			if (angle != NULL)
-				*angle = angle_map[ctile];
-			ctile <<= 4;
-			
-			int16_t ind_x = x;
-			if (tilev & META_X_FLIP)
-			{
-				ind_x ^= ~0;
-				if (angle != NULL)
-					*angle = -*angle;
-			}
-			if (tilev & META_Y_FLIP)
-			{
-				if (angle != NULL)
-					*angle = (-(*angle + 0x40)) - 0x40;
-			}
-			
-			//Get height
-			int16_t height = (int8_t)height_map[ctile + (ind_x & 0xF)];
-			if ((tilev ^ flip) & META_Y_FLIP)
-				height = -height;
-			
-			//Handle hit tile
-			if (height > 0)
-			{
-				//Clip to floor
-				return 0xF - (height + (y & 0xF));
-			}
-			else if (height < 0)
-			{
-				//Clip to ceiling?
-				int16_t distance = y & 0xF;
-				if (height + distance < 0)
-					return distance ^ ~0;
-			}
+			if (++chunk == 0x29)
+				chunk = 0x51;
+		}
+	}
+	return chunk;
+}
+
+static CollBlock FindChunkBlock(uint8_t chunk, int16_t x, int16_t y)
+{
+	//Get block
+	uint8_t tx = (x >> 4) & 0xF;
+	uint8_t ty = (y >> 4) & 0xF;
+	if (chunk <= COLL_CHUNKS)
+		return coll_blocks[chunk][(ty << 4) | tx];
+	return ResolveCollBlock((level_map256 - 0x200) + (chunk << 9) + (ty << 5) + (tx << 1)); //Outside of the chunk map buffer
+}
+
+static CollBlock FindNearestBlock(Object *obj, int16_t x, int16_t y)
+{
+	return FindChunkBlock(FindNearestChunk(obj, x, y), x, y);
+}
+
+static int16_t FindFloor2(Object *obj, int16_t x, int16_t y, uint16_t solid, uint16_t flip, uint8_t *angle)
+{
+	//Check block at given position
+	CollBlock block = FindNearestBlock(obj, x, y);
+	
+	if (block.meta & solid)
+	{
+		//Get angle and height map index
+		if (angle != NULL)
+			*angle = block.angle;
+		
+		int16_t ind_x = x;
+		if (block.meta & META_X_FLIP)
+			ind_x ^= ~0;
+		
+		//Get height
+		int16_t height = (int8_t)height_map[(block.ctile << 4) + (ind_x & 0xF)];
+		if ((block.meta ^ flip) & META_Y_FLIP)
+			height = -height;
+		
+		//Handle hit tile
+		if (height > 0)
+		{
+			//Clip to floor
+			return 0xF - (height + (y & 0xF));
+		}
+		else if (height < 0)
+		{
+			//Clip to ceiling?
+			int16_t distance = y & 0xF;
+			if (height + distance < 0)
+				return distance ^ ~0;
 		}
 	}
 	
@@ -115,56 +175,36 @@ static int16_t FindFloor2(Object *obj, int16_t x, int16_t y, uint16_t solid, uin
 	return 0xF - (y & 0xF);
 }
 
-int16_t FindFloor(Object *obj, int16_t x, int16_t y, uint16_t solid, uint16_t flip, int16_t inc, uint8_t *angle)
+static int16_t FindFloor_Block(Object *obj, CollBlock block, int16_t x, int16_t y, uint16_t solid, uint16_t flip, int16_t inc, uint8_t *angle)
 {
-	//Check tile at given position
-	const uint8_t *tile = FindNearestTile(obj, x, y);
-	uint16_t tilev = (tile[0] << 8) | (tile[1] << 0);
-	
-	uint16_t tilei = tilev & META_TILE;
-	
-	if (tilei != 0 && (tilev & solid))
+	//Check block at given position
+	if (block.meta & solid)
 	{
-		//Get collision tile
-		uint16_t ctile = coll_index[tilei];
-		if (ctile != 0)
+		//Get angle and height map index
+		if (angle != NULL)
+			*angle = block.angle;
+		
+		int16_t ind_x = x;
+		if (block.meta & META_X_FLIP)
+			ind_x ^= ~0;
+		
+		//Get height
+		int16_t height = (int8_t)height_map[(block.ctile << 4) + (ind_x & 0xF)];
+		if ((block.meta ^ flip) & META_Y_FLIP)
+			height = -height;
+		
+		//Handle hit tile
+		if (height > 0)
 		{
-			//Get angle and height map index
-			if (angle != NULL)
-				*angle = angle_map[ctile];
-			ctile <<= 4;
-			
-			int16_t ind_x = x;
-			if (tilev & META_X_FLIP)
-			{
-				ind_x ^= ~0;
-				if (angle != NULL)
-					*angle = -*angle;
-			}
-			if (tilev & META_Y_FLIP)
-			{
-				if (angle != NULL)
-					*angle = (-(*angle + 0x40)) - 0x40;
-			}
-			
-			//Get height
-			int16_t height = (int8_t)height_map[ctile + (ind_x & 0xF)];
-			if ((tilev ^ flip) & META_Y_FLIP)
-				height = -height;
-			
-			//Handle hit tile
-			if (height > 0)
-			{
-				if (height != 0x10)
-					return 0xF - (height + (y & 0xF));
-				else
-					return FindFloor2(obj, x, y - inc, solid, flip, angle) - 0x10;
-			}
+			if (height != 0x10)
+				return 0xF - (height + (y & 0xF));
 			else
-			{
-				if (height + (y & 0xF) < 0)
-					return FindFloor2(obj, x, y - inc, solid, flip, angle) - 0x10;
-			}
+				return FindFloor2(obj, x, y - inc, solid, flip, angle) - 0x10;
+		}
+		else
+		{
+			if (height + (y & 0xF) < 0)
+				return FindFloor2(obj, x, y - inc, solid, flip, angle) - 0x10;
 		}
 	}
 	
@@ -174,54 +214,36 @@ int16_t FindFloor(Object *obj, int16_t x, int16_t y, uint16_t solid, uint16_t fl
 
 static int16_t FindWall2(Object *obj, int16_t x, int16_t y, uint16_t solid, uint16_t flip, uint8_t *angle)
 {
-	//Check tile at given position
-	const uint8_t *tile = FindNearestTile(obj, x, y);
-	uint16_t tilev = (tile[0] << 8) | (tile[1] << 0);
-	
-	uint16_t tilei = tilev & META_TILE;
+	//Check block at given position
+	CollBlock block = FindNearestBlock(obj, x, y);
 	
-	if (tilei != 0 && (tilev & solid))
+	if (block.meta & solid)
 	{
-		//Get collision tile
-		uint16_t ctile = coll_index[tilei];
-		if (ctile != 0)
+		//Get angle and width map index
+		if (angle != NULL)
+			*angle = block.angle;
+		
+		int16_t ind_y = y;
+		if (block.meta & META_Y_FLIP)
+			ind_y ^= ~0;
+		
+		//Get width
+		int16_t width = (int8_t)width_map[(block.ctile << 4) + (ind_y & 0xF)];
+		if ((block.meta ^ flip) & META_X_FLIP)
+			width = -width;
+		
+		//Handle hit tile
+		if (width > 0)
 		{
-			//Get angle and width map index
-			if (angle != NULL)
-				*angle = angle_map[ctile];
-			ctile <<= 4;
-			
-			int16_t ind_y = y;
-			if (tilev & META_Y_FLIP)
-			{
-				ind_y ^= ~0;
-				if (angle != NULL)
-					*angle = (-(*angle + 0x40)) - 0x40;
-			}
-			if (tilev & META_X_FLIP)
-			{
-				if (angle != NULL)
-					*angle = -*angle;
-			}
-			
-			//Get width
-			int16_t width = (int8_t)width_map[ctile + (ind_y & 0xF)];
-			if ((tilev ^ flip) & META_X_FLIP)
-				width = -width;
-			
-			//Handle hit tile
-			if (width > 0)
-			{
-				//Clip to floor
-				return 0xF - (width + (x & 0xF));
-			}
-			else if (width < 0)
-			{
-				//Clip to ceiling?
-				int16_t distance = x & 0xF;
-				if (width + distance < 0)
-					return distance ^ ~0;
-			}
+			//Clip to floor
+			return 0xF - (width + (x & 0xF));
+		}
+		else if (width < 0)
+		{
+			//Clip to ceiling?
+			int16_t distance = x & 0xF;
+			if (width + distance < 0)
+				return distance ^ ~0;
 		}
 	}
 	
@@ -229,57 +251,37 @@ static int16_t FindWall2(Object *obj, int16_t x, int16_t y, uint16_t solid, uint
 	return 0xF - (x & 0xF);
 }
 
-int16_t FindWall(Object *obj, int16_t x, int16_t y, uint16_t solid, uint16_t flip, int16_t inc, uint8_t *angle)
+static int16_t FindWall_Block(Object *obj, CollBlock block, int16_t x, int16_t y, uint16_t solid, uint16_t flip, int16_t inc, uint8_t *angle)
 {
-	//Check tile at given position
-	const uint8_t *tile = FindNearestTile(obj, x, y);
-	uint16_t tilev = (tile[0] << 8) | (tile[1] << 0);
-	
-	uint16_t tilei = tilev & META_TILE;
-	
-	if (tilei != 0 && (tilev & solid))
+	//Check block at given position
+	if (block.meta & solid)
 	{
-		//Get collision tile
-		uint16_t ctile = coll_index[tilei];
-		if (ctile != 0)
+		//Get angle and width map index
+		if (angle != NULL)
+			*angle = block.angle;
+		
+		int16_t ind_y = y;
+		if (block.meta & META_Y_FLIP)
+			ind_y ^= ~0;
+		
+		//Get width
+		int16_t width = (int8_t)width_map[(block.ctile << 4) + (ind_y & 0xF)];
+		if ((block.meta ^ flip) & META_X_FLIP)
+			width = -width;
+		
+		//Handle hit tile
+		if (width > 0)
 		{
-			//Get angle and width map index
-			if (angle != NULL)
-				*angle = angle_map[ctile];
-			ctile <<= 4;
-			
-			int16_t ind_y = y;
-			if (tilev & META_Y_FLIP)
-			{
-				ind_y ^= ~0;
-				if (angle != NULL)
-					*angle = (-(*angle + 0x40)) - 0x40;
-			}
-			if (tilev & META_X_FLIP)
-			{
-				if (angle != NULL)
-					*angle = -*angle;
-			}
-			
-			//Get width
-			int16_t width = (int8_t)width_map[ctile + (ind_y & 0xF)];
-			if ((tilev ^ flip) & META_X_FLIP)
-				width = -width;
-			
-			//Handle hit tile
-			if (width > 0)
-			{
-				if (width != 0x10)
-					return 0xF - (width + (x & 0xF));
-				else
-					return FindWall2(obj, x - inc, y, solid, flip, angle) - 0x10;
-			}
+			if (width != 0x10)
+				return 0xF - (width + (x & 0xF));
 			else
-			{
-				//Check tile above
-				if (width + (x & 0xF) < 0)
-					return FindWall2(obj, x - inc, y, solid, flip, angle) - 0x10;
-			}
+				return FindWall2(obj, x - inc, y, solid, flip, angle) - 0x10;
+		}
+		else
+		{
+			//Check tile above
+			if (width + (x & 0xF) < 0)
+				return FindWall2(obj, x - inc, y, solid, flip, angle) - 0x10;
 		}
 	}
 	
@@ -287,55 +289,99 @@ int16_t FindWall(Object *obj, int16_t x, int16_t y, uint16_t solid, uint16_t fli
 	return FindWall2(obj, x + inc, y, solid, flip, angle) + 0x10;
 }
 
+int16_t FindFloor(Object *obj, int16_t x, int16_t y, uint16_t solid, uint16_t flip, int16_t inc, uint8_t *angle)
+{
+	return FindFloor_Block(obj, FindNearestBlock(obj, x, y), x, y, solid, flip, inc, angle);
+}
+
+int16_t FindWall(Object *obj, int16_t x, int16_t y, uint16_t solid, uint16_t flip, int16_t inc, uint8_t *angle)
+{
+	return FindWall_Block(obj, FindNearestBlock(obj, x, y), x, y, solid, flip, inc, angle);
+}
+
+//Sensor batches
+//Sensors in the same chunk (usually both feet) share its lookup, angles are only written when a surface is found
+void FindFloors(Object *obj, size_t num, const int16_t *x, const int16_t *y, uint16_t solid, uint16_t flip, int16_t inc, int16_t *dist, uint8_t *angle)
+{
+	uint16_t chunk_pos = 0xFFFF;
+	uint8_t chunk = 0;
+	for (size_t i = 0; i < num; i++)
+	{
+		uint16_t pos = (((uint16_t)y[i] >> 8) & 0x7) << 6 | (((uint16_t)x[i] >> 8) & 0x3F);
+		if (pos != chunk_pos)
+		{
+			chunk_pos = pos;
+			chunk = FindNearestChunk(obj, x[i], y[i]);
+		}
+		dist[i] = FindFloor_Block(obj, FindChunkBlock(chunk, x[i], y[i]), x[i], y[i], solid, flip, inc, &angle[i]);
+	}
+}
+
+void FindWalls(Object *obj, size_t num, const int16_t *x, const int16_t *y, uint16_t solid, uint16_t flip, int16_t inc, int16_t *dist, uint8_t *angle)
+{
+	uint16_t chunk_pos = 0xFFFF;
+	uint8_t chunk = 0;
+	for (size_t i = 0; i < num; i++)
+	{
+		uint16_t pos = (((uint16_t)y[i] >> 8) & 0x7) << 6 | (((uint16_t)x[i] >> 8) & 0x3F);
+		if (pos != chunk_pos)
+		{
+			chunk_pos = pos;
+			chunk = FindNearestChunk(obj, x[i], y[i]);
+		}
+		dist[i] = FindWall_Block(obj, FindChunkBlock(chunk, x[i], y[i]), x[i], y[i], solid, flip, inc, &angle[i]);
+	}
+}
+
 //Object collision functions
 int16_t GetDistance2_Down(Object *obj, int16_t x, int16_t y, uint8_t *hit_angle)
 {
-	int16_t dist = FindFloor(obj, x, y + 10, META_SOLID_LRB, 0, 0x10, &angle_buffer0);
+	int16_t dist = FindFloor(obj, x, y + 10, META_SOLID_LRB, 0, 0x10, &ram.angle_buffer[0]);
 	if (hit_angle != NULL)
 	{
-		if (angle_buffer0 & 1) //(special angle, run on all sides)
+		if (ram.angle_buffer[0] & 1) //(special angle, run on all sides)
 			*hit_angle = 0x00;
 		else
-			*hit_angle = angle_buffer0;
+			*hit_angle = ram.angle_buffer[0];
 	}
 	return dist;
 }
 
 int16_t GetDistance2_Up(Object *obj, int16_t x, int16_t y, uint8_t *hit_angle)
 {
-	int16_t dist = FindFloor(obj, x, (y - 10) ^ 0xF, META_SOLID_LRB, META_Y_FLIP, -0x10, &angle_buffer0);
+	int16_t dist = FindFloor(obj, x, (y - 10) ^ 0xF, META_SOLID_LRB, META_Y_FLIP, -0x10, &ram.angle_buffer[0]);
 	if (hit_angle != NULL)
 	{
-		if (angle_buffer0 & 1) //(special angle, run on all sides)
+		if (ram.angle_buffer[0] & 1) //(special angle, run on all sides)
 			*hit_angle = 0x80;
 		else
-			*hit_angle = angle_buffer0;
+			*hit_angle = ram.angle_buffer[0];
 	}
 	return dist;
 }
 
 int16_t GetDistance2_Left(Object *obj, int16_t x, int16_t y, uint8_t *hit_angle)
 {
-	int16_t dist = FindWall(obj, (x - 10) ^ 0xF, y, META_SOLID_LRB, META_X_FLIP, -0x10, &angle_buffer0);
+	int16_t dist = FindWall(obj, (x - 10) ^ 0xF, y, META_SOLID_LRB, META_X_FLIP, -0x10, &ram.angle_buffer[0]);
 	if (hit_angle != NULL)
 	{
-		if (angle_buffer0 & 1) //(special angle, run on all sides)
+		if (ram.angle_buffer[0] & 1) //(special angle, run on all sides)
 			*hit_angle = 0x40;
 		else
-			*hit_angle = angle_buffer0;
+			*hit_angle = ram.angle_buffer[0];
 	}
 	return dist;
 }
 
 int16_t GetDistance2_Right(Object *obj, int16_t x, int16_t y, uint8_t *hit_angle)
 {
-	int16_t dist = FindWall(obj, x + 10, y, META_SOLID_LRB, 0, 0x10, &angle_buffer0);
+	int16_t dist = FindWall(obj, x + 10, y, META_SOLID_LRB, 0, 0x10, &ram.angle_buffer[0]);
 	if (hit_angle != NULL)
 	{
-		if (angle_buffer0 & 1) //(special angle, run on all sides)
+		if (ram.angle_buffer[0] & 1) //(special angle, run on all sides)
 			*hit_angle = 0xC0;
 		else
-			*hit_angle = angle_buffer0;
+			*hit_angle = ram.angle_buffer[0];
 	}
 	return dist;
 }
@@ -347,8 +393,8 @@ int16_t GetDistanceBelowAngle2(Object *obj, uint8_t angle, uint8_t *hit_angle)
 	int16_t y = (obj->pos.l.y.v + (obj->ysp << 8)) >> 16;
 	
 	//Set angle buffer
-	angle_buffer0 = angle;
-	angle_buffer1 = angle;
+	ram.angle_buffer[0] = angle;
+	ram.angle_buffer[1] = angle;
 	
 	//Get symmetrical angle
 	uint8_t prev_angle = angle;
@@ -387,11 +433,11 @@ int16_t GetDistanceBelowAngle2(Object *obj, uint8_t angle, uint8_t *hit_angle)
 static void DistanceSwap(int16_t *dist0, int16_t *dist1, uint8_t *hit_angle, uint8_t angle)
 {
 	//Get angle and distance to use (use closest one)
-	uint8_t res_angle = angle_buffer1;
+	uint8_t res_angle = ram.angle_buffer[1];
 	if (*dist1 > *dist0)
 	{
 		int16_t temp = *dist1;
-		res_angle = angle_buffer0;
+		res_angle = ram.angle_buffer[0];
 		*dist1 = *dist0;
 		*dist0 = temp;
 	}
@@ -408,53 +454,65 @@ static void DistanceSwap(int16_t *dist0, int16_t *dist1, uint8_t *hit_angle, uin
 
 void GetDistance_Down(Object *obj, int16_t *dist0, int16_t *dist1, uint8_t *hit_angle)
 {
-	int16_t dist0t = FindFloor(obj, obj->pos.l.x.f.u + obj->x_rad, obj->pos.l.y.f.u + obj->y_rad, META_SOLID_TOP, 0, 0x10, &angle_buffer0);
-	int16_t dist1t = FindFloor(obj, obj->pos.l.x.f.u - obj->x_rad, obj->pos.l.y.f.u + obj->y_rad, META_SOLID_TOP, 0, 0x10, &angle_buffer1);
-	DistanceSwap(&dist0t, &dist1t, hit_angle, 0x00);
+	//Check both sides
+	int16_t x[2] = {obj->pos.l.x.f.u + obj->x_rad, obj->pos.l.x.f.u - obj->x_rad};
+	int16_t y[2] = {obj->pos.l.y.f.u + obj->y_rad, obj->pos.l.y.f.u + obj->y_rad};
+	int16_t dist[2];
+	FindFloors(obj, 2, x, y, META_SOLID_TOP, 0, 0x10, dist, ram.angle_buffer);
+	DistanceSwap(&dist[0], &dist[1], hit_angle, 0x00);
 	if (dist0 != NULL)
-		*dist0 = dist0t;
+		*dist0 = dist[0];
 	if (dist1 != NULL)
-		*dist1 = dist1t;
+		*dist1 = dist[1];
 }
 
 void GetDistance_Left(Object *obj, int16_t *dist0, int16_t *dist1, uint8_t *hit_angle)
 {
-	int16_t dist0t = FindWall(obj, (obj->pos.l.x.f.u - obj->y_rad) ^ 0xF, obj->pos.l.y.f.u - obj->x_rad, META_SOLID_LRB, META_X_FLIP, -0x10, &angle_buffer0);
-	int16_t dist1t = FindWall(obj, (obj->pos.l.x.f.u - obj->y_rad) ^ 0xF, obj->pos.l.y.f.u + obj->x_rad, META_SOLID_LRB, META_X_FLIP, -0x10, &angle_buffer1);
-	DistanceSwap(&dist0t, &dist1t, hit_angle, 0x40);
+	//Check both sides
+	int16_t x[2] = {(obj->pos.l.x.f.u - obj->y_rad) ^ 0xF, (obj->pos.l.x.f.u - obj->y_rad) ^ 0xF};
+	int16_t y[2] = {obj->pos.l.y.f.u - obj->x_rad, obj->pos.l.y.f.u + obj->x_rad};
+	int16_t dist[2];
+	FindWalls(obj, 2, x, y, META_SOLID_LRB, META_X_FLIP, -0x10, dist, ram.angle_buffer);
+	DistanceSwap(&dist[0], &dist[1], hit_angle, 0x40);
 	if (dist0 != NULL)
-		*dist0 = dist0t;
+		*dist0 = dist[0];
 	if (dist1 != NULL)
-		*dist1 = dist1t;
+		*dist1 = dist[1];
 }
 
 void GetDistance_Up(Object *obj, int16_t *dist0, int16_t *dist1, uint8_t *hit_angle)
 {
-	int16_t dist0t = FindFloor(obj, obj->pos.l.x.f.u + obj->x_rad, (obj->pos.l.y.f.u - obj->y_rad) ^ 0xF, META_SOLID_LRB, META_Y_FLIP, -0x10, &angle_buffer0);
-	int16_t dist1t = FindFloor(obj, obj->pos.l.x.f.u - obj->x_rad, (obj->pos.l.y.f.u - obj->y_rad) ^ 0xF, META_SOLID_LRB, META_Y_FLIP, -0x10, &angle_buffer1);
-	DistanceSwap(&dist0t, &dist1t, hit_angle, 0x80);
+	//Check both sides
+	int16_t x[2] = {obj->pos.l.x.f.u + obj->x_rad, obj->pos.l.x.f.u - obj->x_rad};
+	int16_t y[2] = {(obj->pos.l.y.f.u - obj->y_rad) ^ 0xF, (obj->pos.l.y.f.u - obj->y_rad) ^ 0xF};
+	int16_t dist[2];
+	FindFloors(obj, 2, x, y, META_SOLID_LRB, META_Y_FLIP, -0x10, dist, ram.angle_buffer);
+	DistanceSwap(&dist[0], &dist[1], hit_angle, 0x80);
 	if (dist0 != NULL)
-		*dist0 = dist0t;
+		*dist0 = dist[0];
 	if (dist1 != NULL)
-		*dist1 = dist1t;
+		*dist1 = dist[1];
 }
 
 void GetDistance_Right(Object *obj, int16_t *dist0, int16_t *dist1, uint8_t *hit_angle)
 {
-	int16_t dist0t = FindWall(obj, obj->pos.l.x.f.u + obj->y_rad, obj->pos.l.y.f.u - obj->x_rad, META_SOLID_LRB, 0, 0x10, &angle_buffer0);
-	int16_t dist1t = FindWall(obj, obj->pos.l.x.f.u + obj->y_rad, obj->pos.l.y.f.u + obj->x_rad, META_SOLID_LRB, 0, 0x10, &angle_buffer1);
-	DistanceSwap(&dist0t, &dist1t, hit_angle, 0xC0);
+	//Check both sides
+	int16_t x[2] = {obj->pos.l.x.f.u + obj->y_rad, obj->pos.l.x.f.u + obj->y_rad};
+	int16_t y[2] = {obj->pos.l.y.f.u - obj->x_rad, obj->pos.l.y.f.u + obj->x_rad};
+	int16_t dist[2];
+	FindWalls(obj, 2, x, y, META_SOLID_LRB, 0, 0x10, dist, ram.angle_buffer);
+	DistanceSwap(&dist[0], &dist[1], hit_angle, 0xC0);
 	if (dist0 != NULL)
-		*dist0 = dist0t;
+		*dist0 = dist[0];
 	if (dist1 != NULL)
-		*dist1 = dist1t;
+		*dist1 = dist[1];
 }
 
 void GetDistanceBelowAngle(Object *obj, uint8_t angle, int16_t *dist0, int16_t *dist1, uint8_t *hit_angle)
 {
 	//Set angle buffer
-	angle_buffer0 = angle;
-	angle_buffer1 = angle;
+	ram.angle_buffer[0] = angle;
+	ram.angle_buffer[1] = angle;
 	
 	//Get distance
 	switch ((angle + 0x20) & 0xC0)
@@ -476,5 +534,5 @@ void GetDistanceBelowAngle(Object *obj, uint8_t angle, int16_t *dist0, int16_t *
 
 int16_t ObjFloorDist(Object *obj, int16_t x)
 {
-	return FindFloor(obj, x, obj->pos.l.y.f.u + obj->y_rad, META_SOLID_TOP, 0, 0x10, &angle_buffer0);
+	return FindFloor(obj, x, obj->pos.l.y.f.u + obj->y_rad, META_SOLID_TOP, 0, 0x10, &ram.angle_buffer[0]);
 }
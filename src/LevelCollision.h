@@ -1,15 +1,16 @@
 #pragma once
 
 #include "Object.h"
-
-//Collision angle buffer
-extern uint8_t angle_buffer0, angle_buffer1;
+#include "RAM.h"
 
 //Level collision interface
 void FloorLog_Unk();
+void LoadCollBlocks();
 const uint8_t *FindNearestTile(Object *obj, int16_t x, int16_t y);
 int16_t FindFloor(Object *obj, int16_t x, int16_t y, uint16_t solid, uint16_t flip, int16_t inc, uint8_t *angle);
 int16_t FindWall(Object *obj, int16_t x, int16_t y, uint16_t solid, uint16_t flip, int16_t inc, uint8_t *angle);
+void FindFloors(Object *obj, size_t num, const int16_t *x, const int16_t *y, uint16_t solid, uint16_t flip, int16_t inc, int16_t *dist, uint8_t *angle);
+void FindWalls(Object *obj, size_t num, const int16_t *x, const int16_t *y, uint16_t solid, uint16_t flip, int16_t inc, int16_t *dist, uint8_t *angle);
 
 //Object collision functions
 int16_t GetDistance2_Down(Object *obj, int16_t x, int16_t y, uint8_t *hit_angle);
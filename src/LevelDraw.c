@@ -10,9 +10,6 @@
 #define SCROLL_WIDTH  ((SCREEN_WIDTH  + 15) & ~15)
 #define SCROLL_HEIGHT ((SCREEN_HEIGHT + 15) & ~15)
 
-//Scroll blocks
-int16_t scroll_block1_size, scroll_block2_size, scroll_block3_size, scroll_block4_size;
-
 //Block drawing functions
 size_t CalcVRAMPos(int16_t sx, int16_t sy, int16_t x, int16_t y)
 {
@@ -35,7 +32,7 @@ void GetBlockData(const uint8_t **meta, const uint8_t **block, int16_t sx, int16
 	if (chunk == 0)
 	{
 		*meta = level_map256;
-		*block = level_map16;
+		*block = ram.level_map16;
 		return;
 	}
 	
@@ -49,7 +46,7 @@ void GetBlockData(const uint8_t **meta, const uint8_t **block, int16_t sx, int16
 	size_t tile = (metap[0] << 8) | (metap[1] << 0);
 	tile = tile & 0x3FF;
 	
-	*block = level_map16 + (tile << 3);
+	*block = ram.level_map16 + (tile << 3);
 }
 
 #define WRITE_TILE(off, xor)                                \
@@ -139,7 +136,7 @@ void DrawBlocks_TB(size_t offset, size_t pos, int16_t sx, int16_t sy, int16_t x,
 
 void DrawBlocks_BG(size_t offset, int16_t sx, int16_t sy, int16_t y, uint8_t *layout, const uint8_t *array)
 {
-	static const dword_s *bg_pos[] = {&bg_scrpos_x, &bg_scrpos_x, &bg2_scrpos_x, &bg3_scrpos_y};
+	static const dword_s *bg_pos[] = {&ram.bg_scrpos_x, &ram.bg_scrpos_x, &ram.bg2_scrpos_x, &ram.bg3_scrpos_y};
 	uint8_t bg_pos_i = array[y >> 4];
 	if (bg_pos_i != 0)
 	{
@@ -159,7 +156,7 @@ void Draw_GHZ_Bg(int16_t sy, uint8_t *layout, size_t offset)
 	for (size_t i = 0; i < (SCROLL_HEIGHT + 16 + 16) / 16; i++)
 	{
 		static const uint8_t bg_array[] = {0x00, 0x00, 0x00, 0x00, 0x06, 0x06, 0x06, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-		DrawBlocks_BG(offset, bg_scrpos_y.f.u, sy, y, layout, bg_array);
+		DrawBlocks_BG(offset, ram.bg_scrpos_y.f.u, sy, y, layout, bg_array);
 		y += 16;
 	}
 }
@@ -177,19 +174,19 @@ void DrawChunks(int16_t sx, int16_t sy, uint8_t *layout, size_t offset)
 
 void LoadTilesFromStart()
 {
-	DrawChunks(scrpos_x.f.u, scrpos_y.f.u, level_layout[0][0], VRAM_FG);
+	DrawChunks(ram.scrpos_x.f.u, ram.scrpos_y.f.u, ram.level_layout[0][0], VRAM_FG);
 	#ifndef SCP_REV00
-		if (LEVEL_ZONE(level_id) == ZoneId_GHZ)
-			Draw_GHZ_Bg(bg_scrpos_y.f.u, level_layout[0][1], VRAM_BG);
-		else if (LEVEL_ZONE(level_id) == ZoneId_MZ)
+		if (LEVEL_ZONE(ram.level_id) == ZoneId_GHZ)
+			Draw_GHZ_Bg(ram.bg_scrpos_y.f.u, ram.level_layout[0][1], VRAM_BG);
+		else if (LEVEL_ZONE(ram.level_id) == ZoneId_MZ)
 			{;}//Draw_MZ_Bg(bg_scrpos_y.f.u, level_layout[0][1], VRAM_BG);
-		else if (level_id == LEVEL_ID(ZoneId_SBZ, 0))
+		else if (ram.level_id == LEVEL_ID(ZoneId_SBZ, 0))
 			{;}//Draw_SBZ_Bg(bg_scrpos_y.f.u, level_layout[0][1], VRAM_BG);
-		else if (LEVEL_ZONE(level_id) == ZoneId_EndZ)
-			Draw_GHZ_Bg(bg_scrpos_y.f.u, level_layout[0][1], VRAM_BG);
+		else if (LEVEL_ZONE(ram.level_id) == ZoneId_EndZ)
+			Draw_GHZ_Bg(ram.bg_scrpos_y.f.u, ram.level_layout[0][1], VRAM_BG);
 		else
 	#endif
-	DrawChunks(bg_scrpos_x.f.u, bg_scrpos_y.f.u, level_layout[0][1], VRAM_BG);
+	DrawChunks(ram.bg_scrpos_x.f.u, ram.bg_scrpos_y.f.u, ram.level_layout[0][1], VRAM_BG);
 }
 
 void DrawBGScrollBlock1(int16_t sx, int16_t sy, uint16_t *flag, uint8_t *layout, size_t offset)
@@ -240,7 +237,7 @@ void DrawBGScrollBlock2(int16_t sx, int16_t sy, uint16_t *flag, uint8_t *layout,
 		return;
 	
 	//Run completely different code if in Scrap Brain Zone (what)
-	if (LEVEL_ZONE(level_id) != ZoneId_SBZ)
+	if (LEVEL_ZONE(ram.level_id) != ZoneId_SBZ)
 	{
 		if (*flag & SCROLL_FLAG_LEFT2)
 		{
@@ -267,7 +264,7 @@ void DrawBGScrollBlock3(int16_t sx, int16_t sy, uint16_t *flag, uint8_t *layout,
 		return;
 	
 	//Run completely different code if in Marble Zone (what)
-	if (LEVEL_ZONE(level_id) != ZoneId_MZ)
+	if (LEVEL_ZONE(ram.level_id) != ZoneId_MZ)
 	{
 		if (*flag & SCROLL_FLAG_LEFT2)
 		{
@@ -289,44 +286,44 @@ void DrawBGScrollBlock3(int16_t sx, int16_t sy, uint16_t *flag, uint8_t *layout,
 void LoadTilesAsYouMove()
 {
 	//Scroll background
-	DrawBGScrollBlock1(bg_scrpos_x.f.u,  bg_scrpos_y.f.u,  &bg1_scroll_flags, level_layout[0][1], VRAM_BG);
-	DrawBGScrollBlock2(bg2_scrpos_x.f.u, bg2_scrpos_y.f.u, &bg2_scroll_flags, level_layout[0][1], VRAM_BG);
-	DrawBGScrollBlock3(bg3_scrpos_x.f.u, bg3_scrpos_y.f.u, &bg3_scroll_flags, level_layout[0][1], VRAM_BG);
+	DrawBGScrollBlock1(ram.bg_scrpos_x.f.u,  ram.bg_scrpos_y.f.u,  &ram.bg1_scroll_flags, ram.level_layout[0][1], VRAM_BG);
+	DrawBGScrollBlock2(ram.bg2_scrpos_x.f.u, ram.bg2_scrpos_y.f.u, &ram.bg2_scroll_flags, ram.level_layout[0][1], VRAM_BG);
+	DrawBGScrollBlock3(ram.bg3_scrpos_x.f.u, ram.bg3_scrpos_y.f.u, &ram.bg3_scroll_flags, ram.level_layout[0][1], VRAM_BG);
 	
 	//Scroll foreground
-	int16_t sx = scrpos_x_dup.f.u;
-	int16_t sy = scrpos_y_dup.f.u;
-	uint8_t *layout = level_layout[0][0];
+	int16_t sx = ram.scrpos_x_dup.f.u;
+	int16_t sy = ram.scrpos_y_dup.f.u;
+	uint8_t *layout = ram.level_layout[0][0];
 	
-	if (fg_scroll_flags == 0)
+	if (ram.fg_scroll_flags == 0)
 		return;
 	
-	if (fg_scroll_flags & SCROLL_FLAG_UP)
+	if (ram.fg_scroll_flags & SCROLL_FLAG_UP)
 	{
 		DrawBlocks_LR(VRAM_FG, CalcVRAMPos(sx, sy, -16, -16), sx, sy, -16, -16, layout);
-		fg_scroll_flags &= ~SCROLL_FLAG_UP;
+		ram.fg_scroll_flags &= ~SCROLL_FLAG_UP;
 	}
-	if (fg_scroll_flags & SCROLL_FLAG_DOWN)
+	if (ram.fg_scroll_flags & SCROLL_FLAG_DOWN)
 	{
 		DrawBlocks_LR(VRAM_FG, CalcVRAMPos(sx, sy, -16, SCROLL_HEIGHT), sx, sy, -16, SCROLL_HEIGHT, layout);
-		fg_scroll_flags &= ~SCROLL_FLAG_DOWN;
+		ram.fg_scroll_flags &= ~SCROLL_FLAG_DOWN;
 	}
-	if (fg_scroll_flags & SCROLL_FLAG_LEFT)
+	if (ram.fg_scroll_flags & SCROLL_FLAG_LEFT)
 	{
 		DrawBlocks_TB(VRAM_FG, CalcVRAMPos(sx, sy, -16, -16), sx, sy, -16, -16, layout);
-		fg_scroll_flags &= ~SCROLL_FLAG_LEFT;
+		ram.fg_scroll_flags &= ~SCROLL_FLAG_LEFT;
 	}
-	if (fg_scroll_flags & SCROLL_FLAG_RIGHT)
+	if (ram.fg_scroll_flags & SCROLL_FLAG_RIGHT)
 	{
 		DrawBlocks_TB(VRAM_FG, CalcVRAMPos(sx, sy, SCROLL_WIDTH, -16), sx, sy, SCROLL_WIDTH, -16, layout);
-		fg_scroll_flags &= ~SCROLL_FLAG_RIGHT;
+		ram.fg_scroll_flags &= ~SCROLL_FLAG_RIGHT;
 	}
 }
 
 void LoadTilesAsYouMove_BGOnly()
 {
-	DrawBGScrollBlock1(bg_scrpos_x.f.u,  bg_scrpos_y.f.u,  &bg1_scroll_flags, level_layout[0][1], VRAM_BG);
-	DrawBGScrollBlock2(bg2_scrpos_x.f.u, bg2_scrpos_y.f.u, &bg2_scroll_flags, level_layout[0][1], VRAM_BG);
+	DrawBGScrollBlock1(ram.bg_scrpos_x.f.u,  ram.bg_scrpos_y.f.u,  &ram.bg1_scroll_flags, ram.level_layout[0][1], VRAM_BG);
+	DrawBGScrollBlock2(ram.bg2_scrpos_x.f.u, ram.bg2_scrpos_y.f.u, &ram.bg2_scroll_flags, ram.level_layout[0][1], VRAM_BG);
 	//No scroll block 3, even in REV01... odd
 }
 
@@ -349,22 +346,22 @@ static void AniArt_GiantRing()
 void AnimateLevelGfx()
 {
 	//Don't run if game is paused
-	if (pause)
+	if (ram.pause)
 		return;
 	
 	//Animate giant ring
 	AniArt_GiantRing();
 	
 	//Run level animation
-	switch (LEVEL_ZONE(level_id))
+	switch (LEVEL_ZONE(ram.level_id))
 	{
 		case ZoneId_GHZ:
 			//Animate waterfall
-			if (--level_anim[0].time < 0)
+			if (--ram.level_anim[0].time < 0)
 			{
 				//Increment frame and reset timer
-				level_anim[0].time = 5;
-				uint8_t frame = level_anim[0].frame++ & 1;
+				ram.level_anim[0].time = 5;
+				uint8_t frame = ram.level_anim[0].frame++ & 1;
 				
 				//Write to VRAM
 				VDP_SeekVRAM(0x6F00);
@@ -372,11 +369,11 @@ void AnimateLevelGfx()
 			}
 			
 			//Animate large flowers
-			if (--level_anim[1].time < 0)
+			if (--ram.level_anim[1].time < 0)
 			{
 				//Increment frame and reset timer
-				level_anim[1].time = 15;
-				uint8_t frame = level_anim[1].frame++ & 1;
+				ram.level_anim[1].time = 15;
+				uint8_t frame = ram.level_anim[1].frame++ & 1;
 				
 				//Write to VRAM
 				VDP_SeekVRAM(0x6B80);
@@ -384,16 +381,16 @@ void AnimateLevelGfx()
 			}
 			
 			//Animate small flowers
-			if (--level_anim[2].time < 0)
+			if (--ram.level_anim[2].time < 0)
 			{
 				
 				//Increment frame and reset timer
-				level_anim[2].time = 7;
+				ram.level_anim[2].time = 7;
 				
 				static const uint8_t seq[4] = {0, 1, 2, 1};
-				uint8_t frame = seq[level_anim[2].frame++ & 3];
+				uint8_t frame = seq[ram.level_anim[2].frame++ & 3];
 				if (!(frame & 1))
-					level_anim[2].time = 127;
+					ram.level_anim[2].time = 127;
 				
 				//Write to VRAM
 				VDP_SeekVRAM(0x6D80);
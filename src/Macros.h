@@ -47,7 +47,7 @@
 #define POSITIVE_MOD(x, y) (((x) % (y) + (y)) % (y))
 
 //LevelScroll.h must be included
-#define IS_OFFSCREEN(x) (uint16_t)(((x) & ~0x7F) - ((scrpos_x.f.u - 0x80) & ~0x7F)) > (((SCREEN_WIDTH + 0x80) & ~0x7F) + 0x100)
+#define IS_OFFSCREEN(x) (uint16_t)(((x) & ~0x7F) - ((ram.scrpos_x.f.u - 0x80) & ~0x7F)) > (((SCREEN_WIDTH + 0x80) & ~0x7F) + 0x100)
 
 //Resource include
 #ifdef SCP_REV00
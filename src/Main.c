@@ -1,6 +1,21 @@
 #include "Backend/MegaDrive.h"
+#include "Backend/Trace.h"
+#include "Backend/ResPack.h"
 
 #include "Game.h"
+#include "Object.h"
+#include "RunAhead.h"
+#include "Rollback.h"
+#include "Batch.h"
+#include "DecCache.h"
+#include "DecBench.h"
+#include "PLC.h"
+#include "GM_Level.h"
+#include "Level.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 //Sonic 1 ROM header
 static const MD_Header s1_header = {
@@ -13,12 +28,210 @@ static const MD_Header s1_header = {
 	/* Game title           */ "SONIC THE HEDGEHOG",
 };
 
+//Opens the resource pack (next to the executable, unless a path is given)
+#ifdef SCP_RESOURCE_PACK
+static int OpenResPack(const char *argv0, const char *path)
+{
+	char buffer[0x400];
+	if (path == NULL)
+	{
+		size_t dir = strlen(argv0);
+		while (dir > 0 && argv0[dir - 1] != '/' && argv0[dir - 1] != '\\')
+			dir--;
+		if (dir + sizeof("SoniCPort.pak") > sizeof(buffer))
+			dir = 0;
+		memcpy(buffer, argv0, dir);
+		strcpy(buffer + dir, "SoniCPort.pak");
+		path = buffer;
+	}
+	if (LevelDataRequire())
+		return -1;
+	return ResPack_Open(path);
+}
+#endif
+
+//Starts the game
+static int RunGame()
+{
+	return MegaDrive_Start(&s1_header);
+}
+
 //MegaDrive entry point
 int main(int argc, char *argv[])
 {
-	(void)argc;
-	(void)argv;
+	//Read command line
+	//-record <trace>: write frame hashes and input to a golden trace
+	//-verify <trace>: play back a golden trace and report the first divergent frame
+	//-play <movie>: play back the input from a trace
+	//-frames <n>: quit after n frames
+	//-level <id>: start a new game on the given level instead of booting normally
+	//-objects <n>: level object slots to use (more than the original 0x60 requires EXTENDED_OBJECTS)
+	//-stress <n>: spawn n rings on screen when a level starts
+	//-cache <bytes>: memory cap of the decompression cache (0 disables it), and print its hits and misses on exit
+	//-asyncplc: decompress PLCs on worker threads and load them much faster (instead of the original's pacing)
+	//-loadtime: print how long each stage of loading a level takes
+	//-pack <path>: resource pack to load level data from (RESOURCE_PACK builds, defaults to SoniCPort.pak next to the executable)
+	//-decbench <n>: check the fast decompressors against the original ones, time each over n runs, then quit
+	//-decfuzz <n>: decompress n mutated copies of each Kosinski stream with both decompressors, check they match, then quit
+	//-runahead <n>: run n frames ahead in levels to reduce input latency
+	//-netplay <player> <port> <host> <remote port>: play over UDP as player 0 or 1, rolling back mispredicted frames in levels
+	//-delay <n>: frames of netplay input delay
+	//-netsim <latency> <jitter> <loss>: simulate a bad connection (milliseconds, milliseconds, percent)
+	//-batch <jobs>: run each job in the list in its own process and print the results
+	//-workers <n>: processes to run batch jobs on at once
+	TraceMode trace_mode = TraceMode_None;
+	const char *trace_path = NULL;
+	unsigned long frames = 0;
+	
+	const char *pack_path = NULL;
+	bool decbench = false;
+	unsigned long decbench_iterations = 0;
+	bool decfuzz = false;
+	unsigned long decfuzz_iterations = 0;
+	
+	const char *batch_path = NULL;
+	unsigned int batch_workers = 4;
+	
+	const char *net_host = NULL;
+	unsigned int net_player = 0, net_delay = 2;
+	uint16_t net_port = 0, net_remote_port = 0;
+	unsigned int net_latency = 0, net_jitter = 0, net_loss = 0;
+	
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-record") && (i + 1) < argc)
+		{
+			trace_mode = TraceMode_Record;
+			trace_path = argv[++i];
+		}
+		else if (!strcmp(argv[i], "-verify") && (i + 1) < argc)
+		{
+			trace_mode = TraceMode_Verify;
+			trace_path = argv[++i];
+		}
+		else if (!strcmp(argv[i], "-play") && (i + 1) < argc)
+		{
+			trace_mode = TraceMode_Play;
+			trace_path = argv[++i];
+		}
+		else if (!strcmp(argv[i], "-frames") && (i + 1) < argc)
+		{
+			frames = strtoul(argv[++i], NULL, 0);
+		}
+		else if (!strcmp(argv[i], "-level") && (i + 1) < argc)
+		{
+			start_level = (int)strtol(argv[++i], NULL, 0);
+		}
+		else if (!strcmp(argv[i], "-objects") && (i + 1) < argc)
+		{
+			if (SetObjectCapacity(strtoul(argv[++i], NULL, 0)))
+				return -1;
+		}
+		else if (!strcmp(argv[i], "-stress") && (i + 1) < argc)
+		{
+			stress_objects = strtoul(argv[++i], NULL, 0);
+		}
+		else if (!strcmp(argv[i], "-cache") && (i + 1) < argc)
+		{
+			DecCache_SetCap(strtoul(argv[++i], NULL, 0));
+			atexit(DecCache_PrintStats);
+		}
+		else if (!strcmp(argv[i], "-asyncplc"))
+		{
+			plc_async = true;
+		}
+		else if (!strcmp(argv[i], "-loadtime"))
+		{
+			level_load_time = true;
+		}
+		else if (!strcmp(argv[i], "-pack") && (i + 1) < argc)
+		{
+			pack_path = argv[++i];
+		}
+		else if (!strcmp(argv[i], "-decbench") && (i + 1) < argc)
+		{
+			decbench = true;
+			decbench_iterations = strtoul(argv[++i], NULL, 0);
+		}
+		else if (!strcmp(argv[i], "-decfuzz") && (i + 1) < argc)
+		{
+			decfuzz = true;
+			decfuzz_iterations = strtoul(argv[++i], NULL, 0);
+		}
+		else if (!strcmp(argv[i], "-runahead") && (i + 1) < argc)
+		{
+			runahead_frames = strtoul(argv[++i], NULL, 0);
+		}
+		else if (!strcmp(argv[i], "-netplay") && (i + 4) < argc)
+		{
+			net_player = strtoul(argv[++i], NULL, 0) != 0;
+			net_port = strtoul(argv[++i], NULL, 0);
+			net_host = argv[++i];
+			net_remote_port = strtoul(argv[++i], NULL, 0);
+		}
+		else if (!strcmp(argv[i], "-delay") && (i + 1) < argc)
+		{
+			net_delay = strtoul(argv[++i], NULL, 0);
+		}
+		else if (!strcmp(argv[i], "-netsim") && (i + 3) < argc)
+		{
+			net_latency = strtoul(argv[++i], NULL, 0);
+			net_jitter = strtoul(argv[++i], NULL, 0);
+			net_loss = strtoul(argv[++i], NULL, 0);
+		}
+		else if (!strcmp(argv[i], "-batch") && (i + 1) < argc)
+		{
+			batch_path = argv[++i];
+		}
+		else if (!strcmp(argv[i], "-workers") && (i + 1) < argc)
+		{
+			batch_workers = strtoul(argv[++i], NULL, 0);
+		}
+		else
+		{
+			printf("Usage: %s [-record <trace>] [-verify <trace>] [-play <movie>] [-frames <n>] [-level <id>] [-objects <n>] [-stress <n>] [-cache <bytes>] [-asyncplc] [-loadtime] [-pack <path>] [-decbench <n>] [-decfuzz <n>] [-runahead <n>] [-netplay <player> <port> <host> <remote port>] [-delay <n>] [-netsim <latency> <jitter> <loss>] [-batch <jobs>] [-workers <n>]\n", argv[0]);
+			return -1;
+		}
+	}
+	
+	//Map the resource pack
+	#ifdef SCP_RESOURCE_PACK
+		if (OpenResPack(argv[0], pack_path))
+			return -1;
+	#else
+		(void)pack_path;
+	#endif
+	
+	//Run decompression benchmark or fuzzing
+	if (decbench)
+		return DecBench_Run(decbench_iterations) ? EXIT_FAILURE : EXIT_SUCCESS;
+	if (decfuzz)
+		return DecBench_Fuzz(decfuzz_iterations) ? EXIT_FAILURE : EXIT_SUCCESS;
+	
+	//Run batch jobs
+	if (batch_path != NULL)
+		return Batch_Run(batch_path, batch_workers, RunGame) ? EXIT_FAILURE : EXIT_SUCCESS;
+	
+	if (Trace_Open(trace_mode, trace_path, frames))
+		return -1;
+	
+	//Start netplay session
+	if (net_host != NULL)
+	{
+		NetTransport *net = Net_OpenUDP(net_port, net_host, net_remote_port);
+		if (net != NULL && (net_latency != 0 || net_jitter != 0 || net_loss != 0))
+			net = Net_OpenSim(net, net_latency, net_jitter, net_loss);
+		if (net == NULL)
+			return -1;
+		
+		if (Rollback_Open(net, net_player, net_delay))
+		{
+			net->close(net);
+			return -1;
+		}
+		atexit(Rollback_Close);
+	}
 	
 	//Start MegaDrive
-	return MegaDrive_Start(&s1_header);
+	return RunGame();
 }
@@ -1,9 +1,7 @@
 #pragma once
 
 #include "Types.h"
-
-//Random seed
-extern dword_u random_seed;
+#include "RAM.h"
 
 //Math utility functions
 void CalcSine(uint8_t angle, int16_t *sin, int16_t *cos);
@@ -4,10 +4,24 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "Backend/VDP.h"
 
-uint8_t nemesis_buffer[0x200];
+size_t NemRawSize(const uint8_t *source)
+{
+	#ifdef SCP_PREDECOMPRESS
+		//Art decompressed at build time (PREDECOMPRESS) is tagged "RAWN", followed by its tile count
+		if (memcmp(source, "RAWN", 4) != 0)
+			return 0;
+		return ((source[4] << 8) | source[5]) * 0x20;
+	#else
+		(void)source;
+		return 0;
+	#endif
+}
 
 void NemDecPrepare(NemesisState *state)
 {
@@ -61,8 +75,9 @@ void NemDecPrepare(NemesisState *state)
 	}
 }
 
+//Original decompressor (kept as the reference the fast one is checked against)
 //This function needed a lot of restructuring to look good in C
-void NemDecRun(NemesisState *state)
+static void NemDecRunRef(NemesisState *state)
 {
 	for (;;)
 	{
@@ -171,10 +186,142 @@ void NemDecRun(NemesisState *state)
 	}
 }
 
-static void NemDecMain(NemesisState *state)
+//Fast decompressor
+//Whole runs of a nibble are put into a row at once, and VRAM output is gathered into a buffer of tiles and written in bulk
+//The state is kept in the same form as the original's (d0 is the nibbles left in the current run, d1 is its nibble), so PLCs can stop and resume it
+#define NEM_BUFFER_TILES 0x10
+
+static const uint32_t nem_run_fill[9] = {
+	0x00000000, 0x00000001, 0x00000011, 0x00000111, 0x00001111,
+	0x00011111, 0x00111111, 0x01111111, 0x11111111,
+};
+
+static void NemDecRunFast(NemesisState *state)
+{
+	//Load state
+	const uint8_t *source = state->source;
+	const uint8_t *dictionary = state->dictionary;
+	uint32_t d5 = state->d5;
+	unsigned int d6 = state->d6;
+	unsigned int run = state->d0;
+	uint32_t nibble = state->d1;
+	uint32_t xor_row = state->d2;
+	bool xor_mode = state->xor_mode;
+	unsigned int remaining = state->remaining;
+	
+	uint8_t buffer[NEM_BUFFER_TILES * 0x20];
+	uint8_t *out = state->vram_mode ? buffer : state->destination;
+	
+	while (remaining != 0)
+	{
+		//Assemble a row of 8 nibbles
+		uint64_t row = 0;
+		unsigned int need = 8;
+		while (run < need)
+		{
+			row = (row << (run * 4)) | (nibble * nem_run_fill[run]);
+			need -= run;
+			
+			//Read the next code
+			size_t index = (d5 >> (d6 - 8)) & 0xFF;
+			uint8_t code;
+			
+			if (index < 0xFC)
+			{
+				//Code from the dictionary
+				index *= 2;
+				d6 -= dictionary[index];
+				if (d6 < 9)
+				{
+					d6 += 8;
+					d5 = (d5 << 8) | *source++;
+				}
+				code = dictionary[index + 1];
+			}
+			else
+			{
+				//Inline run (6 bit escape, 3 bit count, 4 bit nibble)
+				d6 -= 6;
+				if (d6 < 9)
+				{
+					d6 += 8;
+					d5 = (d5 << 8) | *source++;
+				}
+				d6 -= 7;
+				code = d5 >> d6;
+				if (d6 < 9)
+				{
+					d6 += 8;
+					d5 = (d5 << 8) | *source++;
+				}
+			}
+			
+			nibble = code & 0xF;
+			run = ((code >> 4) & 7) + 1;
+		}
+		row = (row << (need * 4)) | (nibble * nem_run_fill[need]);
+		run -= need;
+		
+		if (xor_mode)
+			row = (xor_row ^= (uint32_t)row);
+		
+		//Write row
+		*out++ = (row >> 24) & 0xFF;
+		*out++ = (row >> 16) & 0xFF;
+		*out++ = (row >> 8) & 0xFF;
+		*out++ = (row >> 0) & 0xFF;
+		remaining--;
+		
+		if (state->vram_mode && out == buffer + sizeof(buffer))
+		{
+			VDP_WriteVRAM(buffer, sizeof(buffer));
+			out = buffer;
+		}
+	}
+	
+	//Write the rest of the buffered tiles
+	if (state->vram_mode)
+		VDP_WriteVRAM(buffer, out - buffer);
+	else
+		state->destination = out;
+	
+	//Store state
+	state->source = source;
+	state->d5 = d5;
+	state->d6 = d6;
+	state->d0 = run;
+	state->d1 = nibble;
+	state->d2 = xor_row;
+	state->d3 = 8;
+	state->d4 = 0;
+	state->remaining = 0;
+}
+
+void NemDecRun(NemesisState *state)
 {
-	state->dictionary = nemesis_buffer;
+	if (state->raw_mode)
+	{
+		//Copy raw art
+		size_t size = state->remaining * 4;
+		if (state->vram_mode)
+		{
+			VDP_WriteVRAM(state->source, size);
+		}
+		else
+		{
+			memcpy(state->destination, state->source, size);
+			state->destination += size;
+		}
+		state->source += size;
+		state->remaining = 0;
+		return;
+	}
 	
+	NemDecRunFast(state);
+}
+
+static void NemDecStart(NemesisState *state)
+{
 	uint16_t header = (state->source[0] << 8) | state->source[1];
 	state->source += 2;
 	
@@ -196,8 +343,83 @@ static void NemDecMain(NemesisState *state)
 	// These lines are new, to suit the restructured NemDecRun
 	state->d0 = 0;
 	//state->d1 = 0; // This line isn't actually necessary
+}
+
+#ifdef SCP_VERIFY_DECOMPRESSION
+static uint8_t *NemDecVerify_Run(const uint8_t *source, void (*run)(NemesisState*), bool by_tile, size_t size)
+{
+	static uint8_t dictionary[0x200];
+	
+	uint8_t *data = malloc(size);
+	if (data == NULL)
+		return NULL;
+	
+	NemesisState state;
+	state.source = source;
+	state.dictionary = dictionary;
+	state.destination = data;
+	state.vram_mode = false;
+	state.raw_mode = false;
+	NemDecStart(&state);
+	
+	if (by_tile)
+	{
+		//Decompress a tile per call, like PLCs do
+		for (size_t i = 0; i < size / 0x20; i++)
+		{
+			state.remaining = 8;
+			state.d3 = 8;
+			state.d4 = 0;
+			run(&state);
+		}
+	}
+	else
+	{
+		run(&state);
+	}
+	return data;
+}
+
+void NemDecVerify(const uint8_t *source)
+{
+	if (NemRawSize(source) != 0)
+		return;
+	
+	//Check the fast decompressor against the original, both all at once and a tile at a time
+	size_t size = ((((source[0] << 8) | source[1]) << 3) & 0xFFFF) * 4;
+	if (size == 0)
+		return;
+	
+	uint8_t *data_ref = NemDecVerify_Run(source, NemDecRunRef, false, size);
+	uint8_t *data = NemDecVerify_Run(source, NemDecRunFast, false, size);
+	uint8_t *data_tile = NemDecVerify_Run(source, NemDecRunFast, true, size);
+	if (data_ref != NULL && data != NULL && data_tile != NULL && (memcmp(data_ref, data, size) || memcmp(data_ref, data_tile, size)))
+		printf("NemDec: Output doesn't match the original decompressor\n");
+	free(data_ref);
+	free(data);
+	free(data_tile);
+}
+#endif
+
+static void NemDecMain(NemesisState *state, void (*run)(NemesisState*))
+{
+	state->dictionary = ram.nemesis_buffer;
+	
+	size_t raw_size = NemRawSize(state->source);
+	if ((state->raw_mode = (raw_size != 0)))
+	{
+		state->source += 6;
+		state->remaining = raw_size / 4;
+		NemDecRun(state);
+		return;
+	}
+	
+	#ifdef SCP_VERIFY_DECOMPRESSION
+		NemDecVerify(state->source);
+	#endif
 	
-	NemDecRun(state);
+	NemDecStart(state);
+	run(state);
 }
 
 void NemDec(const uint8_t *source)
@@ -207,7 +429,7 @@ void NemDec(const uint8_t *source)
 	state.source = source;
 	state.vram_mode = true;
 	
-	NemDecMain(&state);
+	NemDecMain(&state, NemDecRunFast);
 }
 
 void NemDecToRAM(const uint8_t *source, uint8_t *destination)
@@ -218,5 +440,31 @@ void NemDecToRAM(const uint8_t *source, uint8_t *destination)
 	state.destination = destination;
 	state.vram_mode = false;
 	
-	NemDecMain(&state);
+	NemDecMain(&state, NemDecRunFast);
+}
+
+void NemDecToBuffer(const uint8_t *source, uint8_t *destination, uint8_t *dictionary)
+{
+	//Uses the given dictionary instead of nemesis_buffer, so it can run on another thread (raw art has to be copied by the caller)
+	NemesisState state;
+	
+	state.source = source;
+	state.destination = destination;
+	state.dictionary = dictionary;
+	state.vram_mode = false;
+	state.raw_mode = false;
+	
+	NemDecStart(&state);
+	NemDecRunFast(&state);
+}
+
+void NemDecToRAMRef(const uint8_t *source, uint8_t *destination)
+{
+	NemesisState state;
+	
+	state.source = source;
+	state.destination = destination;
+	state.vram_mode = false;
+	
+	NemDecMain(&state, NemDecRunRef);
 }
@@ -1,22 +1,19 @@
 #include "Object.h"
 
+#include "RAM.h"
 #include "Video.h"
 #include "Level.h"
 #include "LevelScroll.h"
 
 #include "Object/Sonic.h"
+#include "Object/Ring.h"
 
 #include "Macros.h"
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-//Object draw queue
-struct SpriteQueue
-{
-	uint32_t size;
-	Object *obj[0x3F];
-} sprite_queue[8];
-
 //Object indices
 //#ifndef SCP_FIX_BUGS
 //	#define Obj_Null ObjectFall //Thats right, all null objects point to ObjectFall
@@ -24,7 +21,7 @@ struct SpriteQueue
 	void Obj_Null(Object *obj)
 	{
 		if (obj->respawn_index)
-			objstate[obj->respawn_index] &= 0x7F;
+			ram.objstate[obj->respawn_index] &= 0x7F;
 		ObjectDelete(obj);
 	}
 //#endif
@@ -203,74 +200,363 @@ static void (*object_func[])(Object*) = {
 	/* ObjId_8C                  */ Obj_Null,
 };
 
+//Object slot bitmap
+//Level object slots are tracked in objects_used, so finding free slots and running objects doesn't have to scan every slot
+#define OBJECTS_WORDS ((LEVEL_OBJECTS + 31) / 32)
+
+static unsigned int Object_CTZ(uint32_t v)
+{
+	#if defined(__GNUC__)
+		return __builtin_ctz(v);
+	#else
+		unsigned int i = 0;
+		while (!(v & 1))
+		{
+			v >>= 1;
+			i++;
+		}
+		return i;
+	#endif
+}
+
+static Object *Object_Take(unsigned int i)
+{
+	//Mark a free level object slot as used as it's handed out, ObjectDelete frees it again
+	ram.objects_used[i >> 5] |= 1UL << (i & 31);
+	return &level_objects[i];
+}
+
+static unsigned int Object_NextUsed(unsigned int i)
+{
+	//Get the first used level object slot at or after i (LEVEL_OBJECTS if none)
+	if (i >= LEVEL_OBJECTS)
+		return LEVEL_OBJECTS;
+	
+	unsigned int w = i >> 5;
+	uint32_t bits = ram.objects_used[w] & (~0UL << (i & 31));
+	while (bits == 0)
+	{
+		if (++w >= OBJECTS_WORDS)
+			return LEVEL_OBJECTS;
+		bits = ram.objects_used[w];
+	}
+	return (w << 5) + Object_CTZ(bits);
+}
+
+static unsigned int Object_NextFree(unsigned int i)
+{
+	//Get the first free level object slot at or after i (LEVEL_OBJECTS if none)
+	if (i >= LEVEL_OBJECTS)
+		return LEVEL_OBJECTS;
+	
+	unsigned int w = i >> 5;
+	uint32_t bits = ~ram.objects_used[w] & (~0UL << (i & 31));
+	while (bits == 0)
+	{
+		if (++w >= OBJECTS_WORDS)
+			return LEVEL_OBJECTS;
+		bits = ~ram.objects_used[w];
+	}
+	i = (w << 5) + Object_CTZ(bits);
+	return (i < LEVEL_OBJECTS) ? i : LEVEL_OBJECTS;
+}
+
+//Object capacity
+unsigned int level_objects_num = LEVEL_OBJECTS_STRICT;
+unsigned int sprite_queue_num = SPRITE_QUEUE_STRICT;
+unsigned int buffer_sprites_num = BUFFER_SPRITES_STRICT;
+
 //Object functions
+int SetObjectCapacity(unsigned int num)
+{
+	//Check capacity
+	if (num < LEVEL_OBJECTS_STRICT || num > LEVEL_OBJECTS)
+	{
+		printf("SetObjectCapacity: Capacity must be between %d and %d\n", LEVEL_OBJECTS_STRICT, LEVEL_OBJECTS);
+		return -1;
+	}
+	
+	//Keep the original limits unless the table is being extended
+	level_objects_num = num;
+	if (num == LEVEL_OBJECTS_STRICT)
+	{
+		sprite_queue_num = SPRITE_QUEUE_STRICT;
+		buffer_sprites_num = BUFFER_SPRITES_STRICT;
+	}
+	else
+	{
+		sprite_queue_num = SPRITE_QUEUE;
+		buffer_sprites_num = BUFFER_SPRITES;
+	}
+	return 0;
+}
+
+void ClearObjects()
+{
+	//Clear all objects and the slot bitmap
+	memset(ram.objects, 0, sizeof(ram.objects));
+	memset(ram.objects_used, 0, sizeof(ram.objects_used));
+	Touch_Build();
+	#ifdef SCP_RING_MANAGER
+		Rings_Clear();
+	#endif
+}
+
 Object *FindFreeObj()
 {
-	Object *obj = level_objects;
-	for (int i = 0; i < LEVEL_OBJECTS; i++, obj++)
-		if (obj->type == ObjId_Null)
-			return obj;
-	return NULL; //Original would return the address at the end of object space, I believe
+	unsigned int i = Object_NextFree(0);
+	if (i >= level_objects_num)
+		return NULL; //Original would return the address at the end of object space, I believe
+	return Object_Take(i);
 }
 
 Object *FindNextFreeObj(Object *obj)
 {
-	for (; (obj - objects) < OBJECTS; obj++)
+	//Search reserved objects
+	for (; (obj - ram.objects) < RESERVED_OBJECTS; obj++)
 		if (obj->type == ObjId_Null)
 			return obj;
-	return NULL; //Original would return the address at the end of object space, I believe
+	
+	//Search level objects
+	unsigned int i = Object_NextFree(obj - level_objects);
+	if (i >= level_objects_num)
+		return NULL; //Original would return the address at the end of object space, I believe
+	return Object_Take(i);
 }
 
-int ExecuteObjects_i;
-
 void ExecuteObjects()
 {
 	Object *obj;
 	
 	if (player->routine < 6)
 	{
-		//Run all objects
-		obj = objects;
-		ExecuteObjects_i = OBJECTS - 1;
+		//Run reserved objects
+		obj = ram.objects;
+		ram.ExecuteObjects_i = RESERVED_OBJECTS + level_objects_num - 1;
 		do
 		{
 			if (obj->type)
 				object_func[obj->type](obj);
 			obj++;
-		} while (ExecuteObjects_i-- > 0);
+		} while (ram.ExecuteObjects_i-- > (int)level_objects_num);
+		
+		//Run level objects (the bitmap is checked again after each one, as objects may create or delete others)
+		for (unsigned int i = Object_NextUsed(0); i < LEVEL_OBJECTS; i = Object_NextUsed(i + 1))
+		{
+			obj = &level_objects[i];
+			ram.ExecuteObjects_i = level_objects_num - 1 - i;
+			object_func[obj->type](obj);
+		}
 	}
 	else
 	{
 		//Run reserved objects
-		obj = objects;
-		ExecuteObjects_i = RESERVED_OBJECTS - 1;
+		obj = ram.objects;
+		ram.ExecuteObjects_i = RESERVED_OBJECTS - 1;
 		do
 		{
 			if (obj->type)
 				object_func[obj->type](obj);
 			obj++;
-		} while (ExecuteObjects_i-- > 0);
+		} while (ram.ExecuteObjects_i-- > 0);
 		
 		//Draw level objects
-		ExecuteObjects_i = LEVEL_OBJECTS - 1;
-		do
+		for (unsigned int i = Object_NextUsed(0); i < LEVEL_OBJECTS; i = Object_NextUsed(i + 1))
 		{
-			if (obj->type && obj->render.f.on_screen)
+			obj = &level_objects[i];
+			ram.ExecuteObjects_i = level_objects_num - 1 - i;
+			if (obj->render.f.on_screen)
 				DisplaySprite(obj);
-			obj++;
-		} while (ExecuteObjects_i-- > 0);
+		}
 	}
+	ram.ExecuteObjects_i = -1;
+	
+	//Level objects only move while they run, so the touch grid is rebuilt once here for the rest of the frame
+	Touch_Build();
+	
+	#ifdef SCP_RING_MANAGER
+		//Move the scattered rings (after Sonic, like the ring objects they replace)
+		if (player->routine < 6)
+			Rings_Update();
+	#endif
 }
 
-//Object drawing
-void BuildSpr_Normal(uint16_t **sprite, uint8_t *sprite_i, uint16_t x, uint16_t y, uint16_t tile, const uint8_t *mappings, uint8_t pieces)
+//Object touch grid
+//Level objects that Sonic can touch are sorted into cells, so overlap queries only test objects near the queried area
+//The grid is built after ExecuteObjects, before BuildSprites updates on_screen, so that's only checked by Touch_Next
+#define TOUCH_CELL_SHIFT 6
+#define TOUCH_GRID       8 //Cells along each axis, wrapping (must divide 0x10000 >> TOUCH_CELL_SHIFT)
+
+static const uint8_t obj_sizes[][2] = {
+	{ 0x0,  0x0},
+	{0x14, 0x14},
+	{ 0xC, 0x14},
+	{0x14,  0xC},
+	{ 0x4, 0x10},
+	{ 0xC, 0x12},
+	{0x10, 0x10},
+	{ 0x6,  0x6},
+	{0x18,  0xC},
+	{ 0xC, 0x10},
+	{0x10,  0xC},
+	{ 0x8,  0x8},
+	{0x14, 0x10},
+	{0x14,  0x8},
+	{ 0xE,  0xE},
+	{0x18, 0x18},
+	{0x28, 0x10},
+	{0x10, 0x18},
+	{ 0x8, 0x10},
+	{0x20, 0x70},
+	{0x40, 0x20},
+	{0x80, 0x20},
+	{0x20, 0x20},
+	{ 0x8,  0x8},
+	{ 0x4,  0x4},
+	{0x20,  0x8},
+	{ 0xC,  0xC},
+	{ 0x8,  0x4},
+	{0x18,  0x4},
+	{0x28,  0x4},
+	{ 0x4,  0x8},
+	{ 0x4, 0x18},
+	{ 0x4, 0x28},
+	{ 0x4, 0x20},
+	{0x18, 0x18},
+	{ 0xC, 0x18},
+	{0x48,  0x8},
+};
+
+static uint32_t touch_grid[TOUCH_GRID][TOUCH_GRID][OBJECTS_WORDS];
+
+static void Touch_Span(uint16_t lo, uint16_t size, unsigned int *start, unsigned int *count)
+{
+	//Get the cells covering lo to lo + size
+	*start = (lo >> TOUCH_CELL_SHIFT) & (TOUCH_GRID - 1);
+	*count = (((lo & ((1 << TOUCH_CELL_SHIFT) - 1)) + size) >> TOUCH_CELL_SHIFT) + 1;
+	if (*count > TOUCH_GRID)
+		*count = TOUCH_GRID;
+}
+
+void Touch_Build()
 {
-	do
+	//Clear grid
+	memset(touch_grid, 0, sizeof(touch_grid));
+	
+	//Add collidable level objects to the cells their hitbox covers
+	for (unsigned int i = Object_NextUsed(0); i < LEVEL_OBJECTS; i = Object_NextUsed(i + 1))
 	{
-		//Don't overflow the sprite buffer
-		if (*sprite_i >= BUFFER_SPRITES)
-			break;
+		Object *hit = &level_objects[i];
+		if (!hit->col_type)
+			continue;
+		
+		const uint8_t *sizep = obj_sizes[hit->col_type & 0x3F];
+		unsigned int x_start, x_count, y_start, y_count;
+		Touch_Span(hit->pos.l.x.f.u - sizep[0], sizep[0] * 2, &x_start, &x_count);
+		Touch_Span(hit->pos.l.y.f.u - sizep[1], sizep[1] * 2, &y_start, &y_count);
+		
+		uint32_t bit = 1UL << (i & 31);
+		for (unsigned int cy = 0; cy < y_count; cy++)
+			for (unsigned int cx = 0; cx < x_count; cx++)
+				touch_grid[(y_start + cy) & (TOUCH_GRID - 1)][(x_start + cx) & (TOUCH_GRID - 1)][i >> 5] |= bit;
+	}
+}
+
+void Touch_Start(TouchQuery *query, int16_t x, int16_t y, int16_t width, int16_t height)
+{
+	//Initialize query
+	query->x = x;
+	query->y = y;
+	query->width = width;
+	query->height = height;
+	query->i = 0;
+	memset(query->slots, 0, sizeof(query->slots));
+	
+	//Gather the objects in the cells the area covers
+	unsigned int x_start, x_count, y_start, y_count;
+	Touch_Span(x, width, &x_start, &x_count);
+	Touch_Span(y, height, &y_start, &y_count);
+	
+	for (unsigned int cy = 0; cy < y_count; cy++)
+	{
+		for (unsigned int cx = 0; cx < x_count; cx++)
+		{
+			const uint32_t *cell = touch_grid[(y_start + cy) & (TOUCH_GRID - 1)][(x_start + cx) & (TOUCH_GRID - 1)];
+			for (unsigned int w = 0; w < OBJECTS_WORDS; w++)
+				query->slots[w] |= cell[w];
+		}
+	}
+}
+
+Object *Touch_Next(TouchQuery *query)
+{
+	//Get the next gathered object, in slot order, that's touching the area
+	while (query->i < LEVEL_OBJECTS)
+	{
+		unsigned int w = query->i >> 5;
+		uint32_t bits = query->slots[w] & (~0UL << (query->i & 31));
+		if (bits == 0)
+		{
+			query->i = (w + 1) << 5;
+			continue;
+		}
+		unsigned int i = (w << 5) + Object_CTZ(bits);
+		query->i = i + 1;
+		
+		//Check if object is collidable
+		Object *hit = &level_objects[i];
+		if (!(hit->render.f.on_screen && hit->col_type))
+			continue;
+		
+		//Get object's size
+		const uint8_t *sizep = obj_sizes[hit->col_type & 0x3F];
+		uint8_t hit_width = *sizep++;
+		uint8_t hit_height = *sizep++;
 		
+		//Check if we're touching (TODO: may be inaccurate)
+		int16_t x_diff = query->x - (hit->pos.l.x.f.u - hit_width);
+		int16_t y_diff = query->y - (hit->pos.l.y.f.u - hit_height);
+		
+		if (x_diff >= -query->width && x_diff <= hit_width * 2 && y_diff >= -query->height && y_diff <= hit_height * 2)
+			return hit;
+	}
+	return NULL;
+}
+
+//Native mappings
+//Each mapping set is decoded into native pieces once per frame, with the offsets of each flip already applied
+typedef struct
+{
+	int16_t y, x;
+	uint16_t size, tile;
+} MapPiece;
+
+typedef struct
+{
+	MapPiece *piece; //Pieces of each flip, NULL if the frame hasn't been decoded yet
+	uint8_t pieces;
+} MapFrame;
+
+struct MapSet
+{
+	const uint8_t *mappings;
+	MapSet *next;
+	MapFrame frame[0x100];
+};
+
+static MapSet *map_sets;
+
+static const uint16_t map_flip[4] = {
+	0,
+	TILE_X_FLIP_AND,
+	TILE_Y_FLIP_AND,
+	TILE_Y_FLIP_AND | TILE_X_FLIP_AND,
+};
+
+static void Map_Decode(MapPiece *piece, const uint8_t *mappings, unsigned int pieces, unsigned int flip)
+{
+	for (unsigned int i = 0; i < pieces; i++, piece++)
+	{
 		//Read mappings
 		int8_t map_y = *mappings++;
 		uint8_t map_size = *mappings++;
@@ -278,11 +564,78 @@ void BuildSpr_Normal(uint16_t **sprite, uint8_t *sprite_i, uint16_t x, uint16_t
 		mappings += 2;
 		int8_t map_x = *mappings++;
 		
+		//Apply flip offsets
+		piece->y = (flip & 2) ? (-map_y - (((map_size << 3) & 0x18) + 8)) : map_y;
+		piece->x = (flip & 1) ? (-map_x - (((map_size << 1) & 0x18) + 8)) : map_x;
+		piece->size = map_size << 8;
+		piece->tile = map_tile;
+	}
+}
+
+MapSet *Map_Set(const uint8_t *mappings)
+{
+	//Find mapping set
+	MapSet *set;
+	for (set = map_sets; set != NULL; set = set->next)
+		if (set->mappings == mappings)
+			return set;
+	
+	//Add mapping set, its frames are decoded as they're drawn
+	if ((set = calloc(1, sizeof(MapSet))) == NULL)
+	{
+		printf("Map_Set: Failed to allocate mapping set\n");
+		return NULL;
+	}
+	set->mappings = mappings;
+	set->next = map_sets;
+	map_sets = set;
+	return set;
+}
+
+static const MapFrame *Map_Frame(MapSet *set, uint8_t frame)
+{
+	MapFrame *entry = &set->frame[frame];
+	if (entry->piece == NULL)
+	{
+		//Index mapping by frame
+		const uint8_t *mapping_ind = set->mappings + (frame << 1);
+		const uint8_t *mappings = set->mappings + ((mapping_ind[0] << 8) | (mapping_ind[1] << 0));
+		uint8_t pieces = *mappings++;
+		
+		//Decode all flips of the frame
+		MapPiece *piece = malloc(sizeof(MapPiece) * 4 * (pieces ? pieces : 1));
+		if (piece == NULL)
+		{
+			printf("Map_Frame: Failed to allocate mapping frame\n");
+			return NULL;
+		}
+		for (unsigned int j = 0; j < 4; j++)
+			Map_Decode(&piece[pieces * j], mappings, pieces, j);
+		entry->piece = piece;
+		entry->pieces = pieces;
+	}
+	return entry;
+}
+
+//Object drawing
+static void BuildSpr_Pieces(uint16_t **sprite, uint8_t *sprite_i, uint16_t x, uint16_t y, uint16_t tile, const MapPiece *piece, unsigned int pieces, unsigned int flip)
+{
+	//Write sprites
+	uint16_t *spritep = *sprite;
+	uint8_t spritep_i = *sprite_i;
+	uint16_t flip_xor = map_flip[flip];
+	
+	for (; pieces > 0; pieces--, piece++)
+	{
+		//Don't overflow the sprite buffer
+		if (spritep_i >= buffer_sprites_num)
+			break;
+		
 		//Write sprite
-		*(*sprite)++ = y + map_y; //y
-		*(*sprite)++ = (map_size << 8) | ++(*sprite_i); //size and link
-		*(*sprite)++ = map_tile + tile; //tile
-		uint16_t px = x + map_x;
+		*spritep++ = y + piece->y; //y
+		*spritep++ = piece->size | ++spritep_i; //size and link
+		*spritep++ = (piece->tile + tile) ^ flip_xor; //tile
+		uint16_t px = x + piece->x;
 		#if (SCREEN_WIDTH <= 320)
 			if ((px &= 0x1FF) == 0)
 				px++; //Prevent sprite from being x=0 (acts as a mask)
@@ -290,120 +643,26 @@ void BuildSpr_Normal(uint16_t **sprite, uint8_t *sprite_i, uint16_t x, uint16_t
 			if (px == 0)
 				px++;
 		#endif
-		*(*sprite)++ = px; //x
-	} while (pieces-- > 0);
+		*spritep++ = px; //x
+	}
+	
+	*sprite = spritep;
+	*sprite_i = spritep_i;
 }
 
-void BuildSprites_Draw(uint16_t **sprite, uint8_t *sprite_i, uint16_t x, uint16_t y, Object *obj, const uint8_t *mappings, uint8_t pieces)
+void BuildSpr_Frame(uint16_t **sprite, uint8_t *sprite_i, uint16_t x, uint16_t y, uint16_t tile, MapSet *set, uint8_t frame, unsigned int flip)
 {
-	if (obj->render.f.x_flip)
-	{
-		if (obj->render.f.y_flip)
-		{
-			//XY flip
-			do
-			{
-				//Don't overflow the sprite buffer
-				if (*sprite_i >= BUFFER_SPRITES)
-					break;
-				
-				//Read mappings
-				int8_t map_y = *mappings++;
-				uint8_t map_size = *mappings++;
-				uint16_t map_tile = (mappings[0] << 8) | (mappings[1] << 0);
-				mappings += 2;
-				int8_t map_x = *mappings++;
-				
-				//Write sprite
-				*(*sprite)++ = y - map_y - (((map_size << 3) & 0x18) + 8); //y
-				*(*sprite)++ = (map_size << 8) | ++(*sprite_i); //size and link
-				*(*sprite)++ = (map_tile + obj->tile) ^ (TILE_Y_FLIP_AND | TILE_X_FLIP_AND); //tile
-				uint16_t px = x - map_x - (((map_size << 1) & 0x18) + 8);
-				#if (SCREEN_WIDTH <= 320)
-					if ((px &= 0x1FF) == 0)
-						px++; //Prevent sprite from being x=0 (acts as a mask)
-				#else
-					if (px == 0)
-						px++;
-				#endif
-				*(*sprite)++ = px; //x
-			} while (pieces-- > 0);
-		}
-		else
-		{
-			//X flip
-			do
-			{
-				//Don't overflow the sprite buffer
-				if (*sprite_i >= BUFFER_SPRITES)
-					break;
-				
-				//Read mappings
-				int8_t map_y = *mappings++;
-				uint8_t map_size = *mappings++;
-				uint16_t map_tile = (mappings[0] << 8) | (mappings[1] << 0);
-				mappings += 2;
-				int8_t map_x = *mappings++;
-				
-				//Write sprite
-				*(*sprite)++ = y + map_y; //y
-				*(*sprite)++ = (map_size << 8) | ++(*sprite_i); //size and link
-				*(*sprite)++ = (map_tile + obj->tile) ^ TILE_X_FLIP_AND; //tile
-				uint16_t px = x - map_x - (((map_size << 1) & 0x18) + 8);
-				#if (SCREEN_WIDTH <= 320)
-					if ((px &= 0x1FF) == 0)
-						px++; //Prevent sprite from being x=0 (acts as a mask)
-				#else
-					if (px == 0)
-						px++;
-				#endif
-				*(*sprite)++ = px; //x
-			} while (pieces-- > 0);
-		}
-	}
-	else if (obj->render.f.y_flip)
-	{
-		//Y flip
-		do
-		{
-			//Don't overflow the sprite buffer
-			if (*sprite_i >= BUFFER_SPRITES)
-				break;
-			
-			//Read mappings
-			int8_t map_y = *mappings++;
-			uint8_t map_size = *mappings++;
-			uint16_t map_tile = (mappings[0] << 8) | (mappings[1] << 0);
-			mappings += 2;
-			int8_t map_x = *mappings++;
-			
-			//Write sprite
-			*(*sprite)++ = y - map_y - (((map_size << 3) & 0x18) + 8); //y
-			*(*sprite)++ = (map_size << 8) | ++(*sprite_i); //size and link
-			*(*sprite)++ = (map_tile + obj->tile) ^ TILE_Y_FLIP_AND; //tile
-			uint16_t px = x + map_x;
-			#if (SCREEN_WIDTH <= 320)
-				if ((px &= 0x1FF) == 0)
-					px++; //Prevent sprite from being x=0 (acts as a mask)
-			#else
-				if (px == 0)
-					px++;
-			#endif
-			*(*sprite)++ = px; //x
-		} while (pieces-- > 0);
-	}
-	else
-	{
-		BuildSpr_Normal(sprite, sprite_i, x, y, obj->tile, mappings, pieces);
-	}
+	const MapFrame *entry = Map_Frame(set, frame);
+	if (entry != NULL && entry->pieces)
+		BuildSpr_Pieces(sprite, sprite_i, x, y, tile, &entry->piece[entry->pieces * flip], entry->pieces, flip);
 }
 
 void BuildSprites(uint8_t *sprite_io)
 {
 	//Draw each sprite priority queue
-	uint16_t *sprite = &sprite_buffer[0][0];
+	uint16_t *sprite = &ram.sprite_buffer[0][0];
 	uint8_t sprite_i = 0;
-	struct SpriteQueue *queue = sprite_queue;
+	SpriteQueue *queue = ram.sprite_queue;
 	
 	for (int i = 0; i < 8; i++, queue++)
 	{
@@ -424,9 +683,9 @@ void BuildSprites(uint8_t *sprite_io)
 					//Get screen position to use
 					static int16_t *bs_scrpos[4][2] = {
 						{NULL, NULL},
-						{&scrpos_x.f.u,     &scrpos_y.f.u},
-						{&bg_scrpos_x.f.u,  &bg_scrpos_y.f.u},
-						{&bg3_scrpos_x.f.u, &bg3_scrpos_y.f.u},
+						{&ram.scrpos_x.f.u,     &ram.scrpos_y.f.u},
+						{&ram.bg_scrpos_x.f.u,  &ram.bg_scrpos_y.f.u},
+						{&ram.bg3_scrpos_x.f.u, &ram.bg3_scrpos_y.f.u},
 					};
 					int16_t **scrpos = bs_scrpos[(obj->render.f.align_bg << 1) | obj->render.f.align_fg];
 					
@@ -459,35 +718,39 @@ void BuildSprites(uint8_t *sprite_io)
 					y = obj->pos.s.y;
 				}
 				
-				//Get object mappings to use
-				const uint8_t *mappings;
-				uint8_t pieces;
-				
+				//Draw object
+				unsigned int flip = (obj->render.f.y_flip << 1) | obj->render.f.x_flip;
 				if (!obj->render.f.raw_mappings)
 				{
-					//Index mapping by frame
-					const uint8_t *mapping_ind = (const uint8_t*)obj->mappings + (obj->frame << 1);
-					mappings = obj->mappings + ((mapping_ind[0] << 8) | (mapping_ind[1] << 0));
-					pieces = *mappings++;
+					//Get the native mappings, only looked up again when the object changes mappings
+					if (obj->map_set == NULL || obj->map_set->mappings != obj->mappings)
+						obj->map_set = Map_Set(obj->mappings);
+					if (obj->map_set != NULL)
+						BuildSpr_Frame(&sprite, &sprite_i, x, y, obj->tile, obj->map_set, obj->frame, flip);
 				}
 				else
 				{
-					//Directly use object mappings pointer
-					mappings = obj->mappings;
-					pieces = 1;
+					//Directly use object mappings pointer as a single piece
+					MapPiece piece;
+					Map_Decode(&piece, obj->mappings, 1, flip);
+					BuildSpr_Pieces(&sprite, &sprite_i, x, y, obj->tile, &piece, 1, flip);
 				}
-				
-				//Draw object
-				if (pieces)
-					BuildSprites_Draw(&sprite, &sprite_i, x, y, obj, mappings, pieces - 1);
 				obj->render.f.on_screen = true;
 			}
 		}
+		
+		#ifdef SCP_RING_MANAGER
+			//Draw the ring manager's rings and scattered rings with the ring objects they replace
+			if (i == 2)
+				Rings_Draw(&sprite, &sprite_i);
+			else if (i == 3)
+				Rings_DrawParticles(&sprite, &sprite_i);
+		#endif
 	}
 	
 	//Terminate end of sprite list
-	sprite_count = sprite_i;
-	if (sprite_i >= BUFFER_SPRITES)
+	ram.sprite_count = sprite_i;
+	if (sprite_i >= buffer_sprites_num)
 	{
 		sprite[-3] &= 0xFF00; //Clear link byte
 	}
@@ -500,6 +763,115 @@ void BuildSprites(uint8_t *sprite_io)
 		*sprite_io = sprite_i;
 }
 
+//Compiled animation scripts
+//Each command of an animation script is compiled into its result the first time it's read, in a table of every anim_frame
+struct AnimSet
+{
+	const uint8_t *anim_table;
+	AnimSet *next;
+	AnimStep *script[0x80]; //Steps of each script, NULL until it's used
+};
+
+static AnimSet *anim_sets;
+
+static AnimSet *Anim_Set(const uint8_t *anim_table)
+{
+	//Find animation script table
+	AnimSet *set;
+	for (set = anim_sets; set != NULL; set = set->next)
+		if (set->anim_table == anim_table)
+			return set;
+	
+	//Add animation script table, its scripts are compiled as they're read
+	if ((set = calloc(1, sizeof(AnimSet))) == NULL)
+	{
+		printf("Anim_Set: Failed to allocate animation set\n");
+		return NULL;
+	}
+	set->anim_table = anim_table;
+	set->next = anim_sets;
+	anim_sets = set;
+	return set;
+}
+
+static void Anim_Compile(AnimStep *step, const uint8_t *anim_script, uint8_t i)
+{
+	//Compile the command at i, reading what the original would when it's reached
+	uint8_t cmd = anim_script[1 + i];
+	switch (cmd)
+	{
+		case 0xFF: //Restart animation
+			step->op = AnimOp_Frame;
+			step->cmd = anim_script[1];
+			step->next = 1;
+			break;
+		case 0xFE: //Go back (next byte) frames
+		{
+			uint8_t back = i - anim_script[2 + i];
+			step->op = AnimOp_Frame;
+			step->cmd = anim_script[1 + back];
+			step->next = back + 1;
+			break;
+		}
+		case 0xFD: //Change animation
+			step->op = AnimOp_Anim;
+			step->cmd = anim_script[2 + i];
+			step->next = i;
+			break;
+		case 0xFC: //Increment routine
+			step->op = AnimOp_Routine;
+			step->cmd = 0;
+			step->next = i;
+			break;
+		case 0xFB: //Clear secondary routine
+			step->op = AnimOp_ClearSec;
+			step->cmd = 0;
+			step->next = i;
+			break;
+		case 0xFA: //Increment secondary routine
+			step->op = AnimOp_IncSec;
+			step->cmd = 0;
+			step->next = i;
+			break;
+		default:
+			step->op = (cmd & 0x80) ? AnimOp_None : AnimOp_Frame;
+			step->cmd = cmd;
+			step->next = i + 1;
+			break;
+	}
+}
+
+const AnimStep *Anim_Step(Object *obj, const uint8_t *anim_table, uint8_t anim)
+{
+	//Get the object's compiled animation scripts, only looked up again when its script table changes
+	AnimSet *set = obj->anim_set;
+	if (set == NULL || set->anim_table != anim_table)
+		if ((set = obj->anim_set = Anim_Set(anim_table)) == NULL)
+			return NULL;
+	
+	//Get script's steps
+	anim &= 0x7F;
+	AnimStep *steps = set->script[anim];
+	if (steps == NULL)
+	{
+		if ((steps = calloc(0x100, sizeof(AnimStep))) == NULL)
+		{
+			printf("Anim_Step: Failed to allocate animation script\n");
+			return NULL;
+		}
+		set->script[anim] = steps;
+	}
+	
+	//Get step, compiling it if it hasn't been read before
+	AnimStep *step = &steps[obj->anim_frame];
+	if (step->op == AnimOp_Compile)
+	{
+		const uint8_t *anim_script = anim_table + ((anim_table[anim << 1] << 8) | (anim_table[(anim << 1) + 1] << 0));
+		Anim_Compile(step, anim_script, obj->anim_frame);
+	}
+	return step;
+}
+
 //Object functions
 void AnimateSprite(Object *obj, const uint8_t *anim_script)
 {
@@ -517,69 +889,44 @@ void AnimateSprite(Object *obj, const uint8_t *anim_script)
 	if (--obj->frame_time.b >= 0)
 		return;
 	
-	//Get animation script to use
-	anim <<= 1;
-	anim_script += (anim_script[anim] << 8) | (anim_script[anim + 1] << 0);
-	obj->frame_time.b = anim_script[0];
-	
-	//Read current animation command
-	uint8_t cmd = anim_script[1 + obj->anim_frame];
+	//Get animation script's frame duration
+	uint8_t anim_ind = anim << 1;
+	obj->frame_time.b = anim_script[(anim_script[anim_ind] << 8) | (anim_script[anim_ind + 1] << 0)];
 	
-	if (!(cmd & 0x80))
-	{
-		Anim_Next:
-		//Set animation frame
-		obj->frame = cmd & 0x1F;
-		obj->render.f.x_flip = obj->status.o.f.x_flip ^ ((cmd >> 5) & 1);
-		obj->render.f.y_flip = obj->status.o.f.y_flip ^ ((cmd >> 6) & 1);
-		obj->anim_frame++;
-	}
-	else
+	//Run compiled animation command
+	const AnimStep *step = Anim_Step(obj, anim_script, anim);
+	if (step == NULL)
+		return;
+	switch (step->op)
 	{
-		if (++cmd == 0) //0xFF
-		{
-			//Restart animation
-			obj->anim_frame = 0;
-			cmd = anim_script[1];
-			goto Anim_Next;
-		}
-		if (++cmd == 0) //0xFE
-		{
-			//Go back (next byte) frames
-			obj->anim_frame -= anim_script[2 + obj->anim_frame];
-			cmd = anim_script[1 + obj->anim_frame];
-			goto Anim_Next;
-		}
-		if (++cmd == 0) //0xFD
-		{
-			//Change animation
-			obj->anim = anim_script[2 + obj->anim_frame];
-		}
-		if (++cmd == 0) //0xFC
-		{
-			//Increment routine
+		case AnimOp_Frame:
+			obj->frame = step->cmd & 0x1F;
+			obj->render.f.x_flip = obj->status.o.f.x_flip ^ ((step->cmd >> 5) & 1);
+			obj->render.f.y_flip = obj->status.o.f.y_flip ^ ((step->cmd >> 6) & 1);
+			obj->anim_frame = step->next;
+			break;
+		case AnimOp_Anim:
+			obj->anim = step->cmd;
+			break;
+		case AnimOp_Routine:
 			obj->routine += 2;
-		}
-		if (++cmd == 0) //0xFB
-		{
-			//Clear secondary routine
+			break;
+		case AnimOp_ClearSec:
 			obj->routine_sec = 0;
-		}
-		if (++cmd == 0) //0xFA
-		{
-			//Increment secondary routine
+			break;
+		case AnimOp_IncSec:
 			obj->routine_sec += 2;
-		}
+			break;
 	}
 }
 
 void DisplaySprite(Object *obj)
 {
 	//Get queue to use
-	struct SpriteQueue *queue = &sprite_queue[obj->priority & 7];
+	SpriteQueue *queue = &ram.sprite_queue[obj->priority & 7];
 	
 	//Push to queue
-	if (queue->size >= (sizeof(queue->obj) / sizeof(Object*)))
+	if (queue->size >= sprite_queue_num)
 		return;
 	queue->obj[queue->size++] = obj;
 }
@@ -589,6 +936,11 @@ void ObjectDelete(Object *obj)
 	//Clear object memory
 	memset(obj, 0, sizeof(Object));
 	obj->mappings = NULL; //NULL isn't guaranteed to be 0
+	
+	//Free level object slot
+	ptrdiff_t i = obj - level_objects;
+	if (i >= 0 && i < LEVEL_OBJECTS)
+		ram.objects_used[i >> 5] &= ~(1UL << (i & 31));
 }
 
 void SpeedToPos(Object *obj)
@@ -610,7 +962,7 @@ void RememberState(Object *obj)
 	{
 		//Off-screen
 		if (obj->respawn_index)
-			objstate[obj->respawn_index] &= 0x7F;
+			ram.objstate[obj->respawn_index] &= 0x7F;
 		ObjectDelete(obj);
 	}
 	else
@@ -624,7 +976,7 @@ void RememberState(Object *obj)
 void MvSonicOnPtfm(Object *obj, int16_t y, int16_t prev_x)
 {
 	//Check if player can be moved
-	if (lock_multi & 0x80 || player->routine >= 6 || debug_use)
+	if (ram.lock_multi & 0x80 || player->routine >= 6 || ram.debug_use)
 		return;
 	
 	player->pos.l.y.f.u = y - player->y_rad;
@@ -656,7 +1008,7 @@ void Platform3(Object *obj, int16_t top)
 		return;
 	
 	//Check if player can collide with platform
-	if ((lock_multi & 0x80) || player->routine >= 6)
+	if ((ram.lock_multi & 0x80) || player->routine >= 6)
 		return;
 	
 	//Clip on top of platform
@@ -674,7 +1026,7 @@ void Platform_SetStand(Object *obj)
 	//Release from last standing object
 	if (player->status.p.f.object_stand)
 	{
-		Object *prv = objects + scratch->standing_obj;
+		Object *prv = ram.objects + scratch->standing_obj;
 		prv->status.o.f.player_stand = false;
 		prv->routine_sec = 0;
 		if (prv->routine == 4)
@@ -682,7 +1034,7 @@ void Platform_SetStand(Object *obj)
 	}
 	
 	//Modify player state
-	scratch->standing_obj = obj - objects;
+	scratch->standing_obj = obj - ram.objects;
 	player->angle = 0;
 	player->ysp = 0;
 	player->inertia = player->xsp;
@@ -722,13 +1074,13 @@ static void Solid_ResetFloor(Object *obj, Object *pla)
 	//Release player from last standing object
 	if (player->status.p.f.object_stand)
 	{
-		Object *prv = objects + scratch->standing_obj;
+		Object *prv = ram.objects + scratch->standing_obj;
 		prv->status.o.f.player_stand = false;
 		prv->routine_sec = 0;
 	}
 	
 	//Modify player state
-	scratch->standing_obj = obj - objects;
+	scratch->standing_obj = obj - ram.objects;
 	player->angle = 0;
 	player->ysp = 0;
 	player->inertia = player->xsp;
@@ -754,15 +1106,15 @@ static signed int Solid_ChkEnter(Object *obj, uint16_t x_rad, uint16_t y_rad, in
 		if (*y_off >= 0 && *y_off < y_dia)
 		{
 			//Check if player can collide with object
-			if (!(lock_multi & 0x80))
+			if (!(ram.lock_multi & 0x80))
 			{
 			#ifdef SCP_REV00
 				if (player->routine >= 6)
 				{
-					if (debug_use)
+					if (ram.debug_use)
 						return 0;
 			#else
-				if (player->routine >= 6 || debug_use)
+				if (player->routine >= 6 || ram.debug_use)
 					return 0;
 				{
 			#endif
@@ -7,9 +7,19 @@
 #include "Backend/VDP.h"
 
 //Object constants
-#define RESERVED_OBJECTS 0x20
-#define LEVEL_OBJECTS    0x60
-#define OBJECTS          (RESERVED_OBJECTS + LEVEL_OBJECTS)
+#define RESERVED_OBJECTS     0x20
+#define LEVEL_OBJECTS_STRICT 0x60 //Level object slots in the original game
+#define SPRITE_QUEUE_STRICT  0x3F //Objects per sprite priority queue in the original game
+
+#ifdef SCP_EXTENDED_OBJECTS
+	#define LEVEL_OBJECTS 0x800 //Level object slots allocated, the slots used are set with SetObjectCapacity
+	#define SPRITE_QUEUE  (RESERVED_OBJECTS + LEVEL_OBJECTS)
+#else
+	#define LEVEL_OBJECTS LEVEL_OBJECTS_STRICT
+	#define SPRITE_QUEUE  SPRITE_QUEUE_STRICT
+#endif
+
+#define OBJECTS (RESERVED_OBJECTS + LEVEL_OBJECTS)
 
 //Object IDs
 typedef enum
@@ -211,12 +221,21 @@ typedef union
 
 #pragma pack(pop)
 
+typedef struct MapSet MapSet;   //Native mappings, decoded by Object.c
+typedef struct AnimSet AnimSet; //Compiled animation scripts, compiled by Object.c
+
 typedef struct
 {
+	//Hot fields, read by ExecuteObjects and moved by SpeedToPos and ObjectFall every frame, kept together at the start
 	uint8_t type;            //Object type
 	ObjectRender render;     //Object render
-	uint16_t tile;           //Object base tile
-	const uint8_t *mappings; //Object mappings
+	union
+	{
+		ObjectStatus o;   //Object status
+		PlayerStatus p;   //Player status
+		uint8_t b;
+	} status;
+	uint8_t routine;         //Routine
 	union
 	{
 		struct
@@ -229,10 +248,16 @@ typedef struct
 			int16_t y; //Y position
 			uint16_t yl; //Y position (lower word for long accesses)
 		} s; //Screen (VDP coordinates)
-	} pos;                //Position
-	int16_t xsp;          //Horizontal speed
-	int16_t ysp;          //Vertical speed
-	int16_t inertia;      //Speed rotated by angle
+	} pos;                   //Position
+	int16_t xsp;             //Horizontal speed
+	int16_t ysp;             //Vertical speed
+	uint16_t tile;           //Object base tile
+	int16_t inertia;         //Speed rotated by angle
+	
+	//Cold fields
+	const uint8_t *mappings; //Object mappings
+	MapSet *map_set;         //Native mappings of mappings, resolved by BuildSprites
+	AnimSet *anim_set;       //Compiled animation scripts of the last script table animated with, resolved by Anim_Step
 	int8_t x_rad, y_rad;  //Object radius
 	uint8_t priority;     //Sprite priority (0-7, 0 drawn in front of 7)
 	uint8_t width_pixels; //Culling and platform width of sprite
@@ -247,14 +272,7 @@ typedef struct
 	} frame_time;         //Frame duration remaining
 	uint8_t col_type;     //Collision type
 	uint8_t col_property; //Collision property (object-specific)
-	union
-	{
-		ObjectStatus o;   //Object status
-		PlayerStatus p;   //Player status
-		uint8_t b;
-	} status;
 	uint8_t respawn_index; //Respawn index reference number
-	uint8_t routine;       //Routine
 	uint8_t routine_sec;   //Secondary routine
 	uint8_t angle;         //Angle
 	union
@@ -268,17 +286,55 @@ typedef struct
 	} scratch;             //Scratch memory
 } Object;
 
-//Object globals
-extern int ExecuteObjects_i;
+//Object draw queue
+typedef struct
+{
+	uint32_t size;
+	Object *obj[SPRITE_QUEUE];
+} SpriteQueue;
+
+typedef struct
+{
+	int16_t x, y, width, height;
+	uint32_t slots[(LEVEL_OBJECTS + 31) / 32];
+	unsigned int i;
+} TouchQuery;
+
+typedef enum
+{
+	AnimOp_Compile,  //Not compiled yet
+	AnimOp_Frame,    //Set frame from cmd and anim_frame to next
+	AnimOp_Anim,     //Change animation to cmd
+	AnimOp_Routine,  //Increment routine
+	AnimOp_ClearSec, //Clear secondary routine
+	AnimOp_IncSec,   //Increment secondary routine
+	AnimOp_None,
+} AnimOp;
+
+typedef struct
+{
+	uint8_t op, cmd, next;
+} AnimStep;
+
+//Object capacity
+extern unsigned int level_objects_num, sprite_queue_num, buffer_sprites_num;
 
 //Object functions
+int SetObjectCapacity(unsigned int num);
+void ClearObjects();
 Object *FindFreeObj();
 Object *FindNextFreeObj(Object *obj);
 void ExecuteObjects();
 
-void BuildSpr_Normal(uint16_t **sprite, uint8_t *sprite_i, uint16_t x, uint16_t y, uint16_t tile, const uint8_t *mappings, uint8_t pieces);
+void Touch_Build();
+void Touch_Start(TouchQuery *query, int16_t x, int16_t y, int16_t width, int16_t height);
+Object *Touch_Next(TouchQuery *query);
+
+MapSet *Map_Set(const uint8_t *mappings);
+void BuildSpr_Frame(uint16_t **sprite, uint8_t *sprite_i, uint16_t x, uint16_t y, uint16_t tile, MapSet *set, uint8_t frame, unsigned int flip);
 void BuildSprites(uint8_t *sprite_io);
 
+const AnimStep *Anim_Step(Object *obj, const uint8_t *anim_table, uint8_t anim);
 void AnimateSprite(Object *obj, const uint8_t *anim_script);
 void DisplaySprite(Object *obj);
 
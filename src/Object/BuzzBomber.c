@@ -100,7 +100,7 @@ void Obj_BuzzMissile(Object *obj)
 				DisplaySprite(obj);
 				
 				//Delete if fallen below stage
-				if ((limit_btm2 + SCREEN_HEIGHT) < obj->pos.l.y.f.u)
+				if ((ram.limit_btm2 + SCREEN_HEIGHT) < obj->pos.l.y.f.u)
 					ObjectDelete(obj);
 			}
 			else
@@ -66,7 +66,7 @@ void Obj_Crabmeat(Object *obj)
 			//Clip and increment routine
 			obj->pos.l.y.f.u += floor_dist;
 			obj->ysp = 0;
-			obj->angle = angle_buffer0;
+			obj->angle = ram.angle_buffer[0];
 			obj->routine += 2;
 	//Fallthrough
 		case 2: //Moving
@@ -139,7 +139,7 @@ void Obj_Crabmeat(Object *obj)
 							//Clip out of floor
 							floor_dist = ObjFloorDist(obj, obj->pos.l.x.f.u);
 							obj->pos.l.y.f.u += floor_dist;
-							obj->angle = angle_buffer0;
+							obj->angle = ram.angle_buffer[0];
 							obj->anim = 3 + Obj_Crabmeat_SetAni(obj);
 							break;
 						}
@@ -184,7 +184,7 @@ void Obj_Crabmeat(Object *obj)
 			DisplaySprite(obj);
 			
 			//Delete if fallen below stage
-			if (obj->pos.l.y.f.u >= limit_btm2 + SCREEN_HEIGHT)
+			if (obj->pos.l.y.f.u >= ram.limit_btm2 + SCREEN_HEIGHT)
 				ObjectDelete(obj);
 			break;
 	}
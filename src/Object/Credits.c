@@ -22,22 +22,22 @@ void Obj_Credits(Object *obj)
 			//Set object drawing information
 			obj->mappings = map_credits;
 			obj->tile = TILE_MAP(0, 0, 0, 0, 0x5A0);
-			obj->frame = credits_num;
+			obj->frame = ram.credits_num;
 			obj->render.b = 0;
 			obj->priority = 0;
 			
 			//Force "SONIC TEAM PRESENTS" text when in title screen
-			if (gamemode == GameMode_Title)
+			if (ram.gamemode == GameMode_Title)
 			{
 				//Display "SONIC TEAM PRESENTS" text
 				obj->tile = TILE_MAP(0, 0, 0, 0, 0xA6);
 				obj->frame = 10;
 				
 				//Hidden Japanese credits
-				if (credits_cheat && jpad1_hold1 == (JPAD_A | JPAD_C | JPAD_B | JPAD_DOWN))
+				if (ram.credits_cheat && ram.jpad1_hold1 == (JPAD_A | JPAD_C | JPAD_B | JPAD_DOWN))
 				{
-					dry_palette_dup[2][0] = 0xEEE;
-					dry_palette_dup[2][1] = 0x880;
+					ram.dry_palette_dup[2][0] = 0xEEE;
+					ram.dry_palette_dup[2][1] = 0x880;
 					ObjectDelete(obj);
 					break;
 				}
@@ -91,7 +91,7 @@ static void Obj_GHZBridge_Bend(Object *obj)
 	do
 	{
 		//Get segment
-		Object *seg = objects + *a2++;
+		Object *seg = ram.objects + *a2++;
 		Scratch_GHZBridge *segscratch = (Scratch_GHZBridge*)&obj->scratch;
 		
 		//Move segment
@@ -114,7 +114,7 @@ static void Obj_GHZBridge_Bend(Object *obj)
 	do
 	{
 		//Get segment
-		Object *seg = objects + *a2++;
+		Object *seg = ram.objects + *a2++;
 		Scratch_GHZBridge *segscratch = (Scratch_GHZBridge*)&obj->scratch;
 		
 		//Move segment
@@ -148,7 +148,7 @@ static void Obj_GHZBridge_MoveSonic(Object *obj)
 	Scratch_GHZBridge *scratch = (Scratch_GHZBridge*)&obj->scratch;
 	
 	//Clip Sonic to the top of the bridge segment being stood on
-	Object *seg = objects + scratch->seg[scratch->push_seg];
+	Object *seg = ram.objects + scratch->seg[scratch->push_seg];
 	player->pos.l.y.f.u = seg->pos.l.y.f.u - 8 - player->y_rad;
 }
 
@@ -182,7 +182,7 @@ static void Obj_GHZBridge_ChkDel(Object *obj)
 		
 		do
 		{
-			Object *seg = objects + *segp++;
+			Object *seg = ram.objects + *segp++;
 			if (seg != obj)
 				ObjectDelete(seg);
 		} while (segs-- > 0);
@@ -235,10 +235,10 @@ void Obj_GHZBridge(Object *obj)
 						x += 16;
 						obj->pos.l.y.f.u = y;
 						scratch->base_y = y;
-						*segp++ = obj - objects;
+						*segp++ = obj - ram.objects;
 						scratch->subtype++;
 					}
-					*segp++ = seg - objects;
+					*segp++ = seg - ram.objects;
 					
 					//Set segment object
 					Scratch_GHZBridge *segscratch = (Scratch_GHZBridge*)&seg->scratch;
@@ -31,7 +31,7 @@ static signed int Obj44_SolidWall2(Object *obj, uint16_t x_rad, uint16_t y_rad,
 		return 0;
 	
 	//Check if we can touch
-	if ((lock_multi & 0x80) || player->routine >= 6 || debug_use)
+	if ((ram.lock_multi & 0x80) || player->routine >= 6 || ram.debug_use)
 		return 0;
 	
 	//Get X clip
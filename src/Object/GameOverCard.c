@@ -21,7 +21,7 @@ void Obj_GameOverCard(Object *obj)
 	{
 		case 0: //Initialization
 			//Wait for art to be finished loading
-			if (plc_buffer[0].art != NULL)
+			if (ram.plc_buffer[0].art != NULL)
 				break;
 			
 			//Increment routine and set position
@@ -59,7 +59,7 @@ void Obj_GameOverCard(Object *obj)
 			}
 			break;
 		case 4:
-			if (!(jpad1_hold1 & (JPAD_A | JPAD_C | JPAD_B)))
+			if (!(ram.jpad1_hold1 & (JPAD_A | JPAD_C | JPAD_B)))
 			{
 				//Don't change handle timer if 'OVER'
 				if (obj->frame & 1)
@@ -78,10 +78,10 @@ void Obj_GameOverCard(Object *obj)
 			}
 			
 			//Change gamemode
-			if (!time_over)
+			if (!ram.time_over)
 			{
 				//Go to continue screen, or SEGA screen if we have no continues
-				gamemode = continues ? GameMode_Continue : GameMode_Sega;
+				ram.gamemode = ram.continues ? GameMode_Continue : GameMode_Sega;
 			}
 			else
 			{
@@ -89,7 +89,7 @@ void Obj_GameOverCard(Object *obj)
 				#ifndef SCP_REV00
 					//lamp_time = 0; //TODO
 				#endif
-				restart = true;
+				ram.restart = true;
 			}
 			
 			DisplaySprite(obj);
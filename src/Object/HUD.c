@@ -28,7 +28,7 @@ void Obj_HUD(Object *obj)
 	//Fallthrough
 		case 2:
 			#ifndef SCP_FIX_BUGS
-				if (rings)
+				if (ram.rings)
 				{
 					//Don't flash RINGS or TIME(?) and draw
 					obj->frame = 0;
@@ -38,10 +38,10 @@ void Obj_HUD(Object *obj)
 				{
 					//Determine frame and draw
 					uint8_t frame = 0;
-					if (!(frame_count & 8))
+					if (!(ram.frame_count & 8))
 					{
 						frame += 1; //Flash RINGS
-						if (time.min == 9)
+						if (ram.time.min == 9)
 							frame += 2; //Flash TIME
 					}
 					obj->frame = frame;
@@ -51,11 +51,11 @@ void Obj_HUD(Object *obj)
 				{
 					//Determine frame and draw
 					uint8_t frame = 0;
-					if (!(frame_count & 8))
+					if (!(ram.frame_count & 8))
 					{
-						if (!rings)
+						if (!ram.rings)
 							frame += 1; //Flash RINGS
-						if (time.min == 9)
+						if (ram.time.min == 9)
 							frame += 2; //Flash TIME
 					}
 					obj->frame = frame;
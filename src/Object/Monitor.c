@@ -31,7 +31,7 @@ static signed int Mon_SolidSides(Object *obj, uint16_t x_rad, uint16_t y_rad, in
 		return 0;
 	
 	//Check if player can collide with object
-	if ((lock_multi & 0x80) || player->routine >= 6 || debug_use)
+	if ((ram.lock_multi & 0x80) || player->routine >= 6 || ram.debug_use)
 		return 0;
 	
 	//Shift x off when on other side of monitor
@@ -74,8 +74,8 @@ void Obj_Monitor(Object *obj)
 			obj->width_pixels = 15;
 			
 			//Check if monitor was destroyed
-			objstate[obj->respawn_index] &= 0x7F;
-			if (objstate[obj->respawn_index] & 1)
+			ram.objstate[obj->respawn_index] &= 0x7F;
+			if (ram.objstate[obj->respawn_index] & 1)
 			{
 				//Destroyed
 				obj->routine = 8;
@@ -204,7 +204,7 @@ void Obj_Monitor(Object *obj)
 			}
 			
 			//Mark as broken and draw
-			objstate[obj->respawn_index] |= 1;
+			ram.objstate[obj->respawn_index] |= 1;
 			
 			obj->anim = 9;
 			DisplaySprite(obj);
@@ -215,8 +215,8 @@ void Obj_Monitor(Object *obj)
 //Monitor item object
 static void ExtraLife()
 {
-	lives++;
-	life_count++;
+	ram.lives++;
+	ram.life_count++;
 	//music	bgm_ExtraLife,1,0,0	; play extra life music TODO
 }
 
@@ -268,46 +268,46 @@ void Obj_MonitorItem(Object *obj)
 						ExtraLife();
 						break;
 					case 3: //Shoes
-						shoes = true;
+						ram.shoes = true;
 						scratch->shoes_time = 1200;
-						sonspeed_max = 0xC00;
-						sonspeed_acc = 0x18;
-						sonspeed_dec = 0x80;
+						ram.sonspeed_max = 0xC00;
+						ram.sonspeed_acc = 0x18;
+						ram.sonspeed_dec = 0x80;
 						//music	bgm_Speedup,1,0,0		; Speed	up the music TODO
 						break;
 					case 4: //Shield
-						shield = true;
-						objects[6].type = ObjId_ShieldInvincibility; //TODO
+						ram.shield = true;
+						ram.objects[6].type = ObjId_ShieldInvincibility; //TODO
 						//music	sfx_Shield,1,0,0	; play shield sound TODO
 						break;
 					case 5: //Invincibility
-						invincibility = true;
+						ram.invincibility = true;
 						scratch->invincibility_time = 1200;
-						objects[8].type = ObjId_ShieldInvincibility; //TODO
-						objects[8].anim = 1;
-						objects[9].type = ObjId_ShieldInvincibility;
-						objects[9].anim = 2;
-						objects[10].type = ObjId_ShieldInvincibility;
-						objects[10].anim = 3;
-						objects[11].type = ObjId_ShieldInvincibility;
-						objects[11].anim = 4;
-						if (!lock_screen)
+						ram.objects[8].type = ObjId_ShieldInvincibility; //TODO
+						ram.objects[8].anim = 1;
+						ram.objects[9].type = ObjId_ShieldInvincibility;
+						ram.objects[9].anim = 2;
+						ram.objects[10].type = ObjId_ShieldInvincibility;
+						ram.objects[10].anim = 3;
+						ram.objects[11].type = ObjId_ShieldInvincibility;
+						ram.objects[11].anim = 4;
+						if (!ram.lock_screen)
 							{;}//music	bgm_Invincible,1,0,0 ; play invincibility music TODO
 						break;
 					case 6: //Rings
 						//Give 10 rings
-						rings += 10;
-						ring_count |= 1;
+						ram.rings += 10;
+						ram.ring_count |= 1;
 						
 						//Give extra life
-						if (rings >= 100 && !(life_num & 1))
+						if (ram.rings >= 100 && !(ram.life_num & 1))
 						{
-							life_num |= 1;
+							ram.life_num |= 1;
 							ExtraLife();
 						}
-						else if (rings >= 200 && !(life_num & 2))
+						else if (ram.rings >= 200 && !(ram.life_num & 2))
 						{
-							life_num |= 2;
+							ram.life_num |= 2;
 							ExtraLife();
 						}
 						else
@@ -1,4 +1,4 @@
-#include "Object.h"
+#include "Ring.h"
 
 #include "Level.h"
 #include "LevelScroll.h"
@@ -6,6 +6,8 @@
 #include "Game.h"
 #include "MathUtil.h"
 
+#include <stdio.h>
+
 //Ring assets
 static const uint8_t anim_ring[] = {
 	#include "Resource/Animation/Ring.h"
@@ -80,28 +82,40 @@ static void Obj_Ring_SetupRing(Object *obj, uint8_t index, int16_t x, int16_t y,
 	scratch->index = index;
 }
 
+void StressRings(unsigned int num)
+{
+	//Spawn rings in rows above Sonic
+	for (unsigned int i = 0; i < num; i++)
+	{
+		Object *ring = FindFreeObj();
+		if (ring == NULL)
+			break;
+		Obj_Ring_SetupRing(ring, 0, player->pos.l.x.f.u - 0x78 + (i & 0xF) * 0x10, player->pos.l.y.f.u - 0x60 + ((i >> 4) & 0xF) * 4, ring);
+	}
+}
+
 static void ExtraLife()
 {
-	lives++;
-	life_count++;
+	ram.lives++;
+	ram.life_count++;
 }
 
 static void CollectRing()
 {
 	//Increment ring count
-	rings++;
-	ring_count |= 1;
+	ram.rings++;
+	ram.ring_count |= 1;
 	
 	//Check if we should get an extra life
 	//TODO: sound
-	if (rings >= 100 && !(life_num & 1))
+	if (ram.rings >= 100 && !(ram.life_num & 1))
 	{
-		life_num |= 1;
+		ram.life_num |= 1;
 		ExtraLife();
 	}
-	else if (rings >= 200 && !(life_num & 2))
+	else if (ram.rings >= 200 && !(ram.life_num & 2))
 	{
-		life_num |= 2;
+		ram.life_num |= 2;
 		ExtraLife();
 	}
 }
@@ -115,7 +129,7 @@ void Obj_Ring(Object *obj)
 		case 0: //Initialization
 		{
 			//Get spawning information
-			uint8_t *statep = &objstate[obj->respawn_index];
+			uint8_t *statep = &ram.objstate[obj->respawn_index];
 			uint8_t state = *statep;
 			
 			uint8_t num = scratch->subtype & 7; //subtype
@@ -160,7 +174,7 @@ void Obj_Ring(Object *obj)
 	//Fallthrough
 		case 2: //Animate
 			//Draw and unload once off-screen
-			obj->frame = sprite_anim[1].frame;
+			obj->frame = ram.sprite_anim[1].frame;
 			DisplaySprite(obj);
 			if (IS_OFFSCREEN(scratch->base_x))
 				ObjectDelete(obj);
@@ -173,7 +187,7 @@ void Obj_Ring(Object *obj)
 			
 			//Collect ring and mark as collected
 			CollectRing();
-			objstate[obj->respawn_index] |= (1 << scratch->index);
+			ram.objstate[obj->respawn_index] |= (1 << scratch->index);
 	//Fallthrough
 		case 6: //Sparkling
 			//Animate and draw
@@ -187,6 +201,25 @@ void Obj_Ring(Object *obj)
 }
 
 //Ring loss object
+static void Obj_RingLoss_Speed(int16_t *xsp, int16_t *ysp, word_u *angle)
+{
+	//Handle object angle and velocity
+	if (!(angle->f.u & 0x80))
+	{
+		int16_t sin, cos;
+		CalcSine(angle->f.l, &sin, &cos);
+		*xsp = sin << angle->f.u;
+		*ysp = cos << angle->f.u;
+		
+		if ((angle->f.l += 0x10) < 0x10)
+		{
+			if ((angle->v -= 0x80) >= 0xFF80)
+				angle->v = 0x288;
+		}
+	}
+}
+
+#ifndef SCP_RING_MANAGER
 static void Obj_RingLoss_SetupRing(Object *obj, int16_t *xsp, int16_t *ysp, word_u *angle, Object *ring)
 {
 	//Set object type and routine
@@ -209,29 +242,17 @@ static void Obj_RingLoss_SetupRing(Object *obj, int16_t *xsp, int16_t *ysp, word
 	//Set other object state stuff
 	ring->col_type = 0x47;
 	ring->width_pixels = 8;
-	sprite_anim[3].time = -1;
-	
-	//Handle object angle and velocity
-	if (!(angle->f.u & 0x80))
-	{
-		int16_t sin, cos;
-		CalcSine(angle->f.l, &sin, &cos);
-		*xsp = sin << angle->f.u;
-		*ysp = cos << angle->f.u;
-		
-		if ((angle->f.l += 0x10) < 0x10)
-		{
-			if ((angle->v -= 0x80) >= 0xFF80)
-				angle->v = 0x288;
-		}
-	}
+	ram.sprite_anim[3].time = -1;
 	
+	//Set velocity
+	Obj_RingLoss_Speed(xsp, ysp, angle);
 	ring->xsp = *xsp;
 	ring->ysp = *ysp;
 	
 	*xsp = -*xsp;
 	angle->v = -angle->v;
 }
+#endif
 
 void Obj_RingLoss(Object *obj)
 {
@@ -240,42 +261,52 @@ void Obj_RingLoss(Object *obj)
 		case 0: //Initialization
 		{
 			//Get how many rings to drop
-			uint16_t drop = rings;
+			uint16_t drop = ram.rings;
 			if (drop >= 32)
 				drop = 32; //Cap at 32
 			drop--; //dbf
 			
 			//Drop rings
-			int16_t xsp, ysp;
-			word_u angle;
-			angle.v = 0x0288;
-			
-			Obj_RingLoss_SetupRing(obj, &xsp, &ysp, &angle, obj);
-			while (drop-- > 0)
-			{
-				Object *ring = FindFreeObj();
-				if (ring == NULL)
-					break;
-				Obj_RingLoss_SetupRing(obj, &xsp, &ysp, &angle, ring);
-			}
+			#ifdef SCP_RING_MANAGER
+				Rings_Scatter(obj, drop + 1);
+			#else
+				int16_t xsp, ysp;
+				word_u angle;
+				angle.v = 0x0288;
+				
+				Obj_RingLoss_SetupRing(obj, &xsp, &ysp, &angle, obj);
+				while (drop-- > 0)
+				{
+					Object *ring = FindFreeObj();
+					if (ring == NULL)
+						break;
+					Obj_RingLoss_SetupRing(obj, &xsp, &ysp, &angle, ring);
+				}
+			#endif
 			
 			//Lose rings
-			rings = 0;
-			ring_count = 0x80;
-			life_num = 0;
+			ram.rings = 0;
+			ram.ring_count = 0x80;
+			ram.life_num = 0;
 			//sfx	sfx_RingLoss,0,0,0	; play ring loss sound //TODO
+			
+			#ifdef SCP_RING_MANAGER
+				//The ring manager moves the dropped rings from here on
+				ObjectDelete(obj);
+				break;
+			#endif
 		}
 	//Fallthrough
 		case 2: //Moving
 			//Use animation frame
-			obj->frame = sprite_anim[3].frame;
+			obj->frame = ram.sprite_anim[3].frame;
 			
 			//Fall
 			SpeedToPos(obj);
 			obj->ysp += 0x18;
 			
 			//Do floor collision (every 4 frames)
-			if (obj->ysp >= 0 && ((ExecuteObjects_i + (vbla_count & 0xFF)) & 3) == 0)
+			if (obj->ysp >= 0 && ((ram.ExecuteObjects_i + (ram.vbla_count & 0xFF)) & 3) == 0)
 			{
 				int16_t floor_dist = ObjFloorDist(obj, obj->pos.l.x.f.u);
 				if (floor_dist < 0)
@@ -287,12 +318,12 @@ void Obj_RingLoss(Object *obj)
 			}
 			
 			//Delete once below level or animation is done
-			if (!sprite_anim[3].time)
+			if (!ram.sprite_anim[3].time)
 			{
 				ObjectDelete(obj);
 				break;
 			}
-			if ((limit_btm2 + SCREEN_HEIGHT) < obj->pos.l.y.f.u)
+			if ((ram.limit_btm2 + SCREEN_HEIGHT) < obj->pos.l.y.f.u)
 			{
 				ObjectDelete(obj);
 				break;
@@ -320,3 +351,329 @@ void Obj_RingLoss(Object *obj)
 			break;
 	}
 }
+
+#ifdef SCP_RING_MANAGER
+//Ring manager
+//The rings placed in the level are kept in a list sorted by X position instead of being loaded as objects, and are touched and drawn in batches
+//Collected rings are marked in their group's respawn state, like ring objects do
+#define RING_FIELD_MAX 0x400
+
+typedef struct
+{
+	int16_t x, y;
+	uint8_t respawn_index; //Respawn index of the ring's group
+	uint8_t bit;           //Index of the ring in its group
+} RingFieldEntry;
+
+//Derived from ram.ring_layout, so it's kept outside of ram and rebuilt by Rings_Restore when ram is replaced
+static RingFieldEntry ring_field[RING_FIELD_MAX];
+static size_t ring_field_num;
+
+static MapSet *ring_map_set;
+
+void Rings_Clear()
+{
+	ring_field_num = 0;
+	ram.ring_layout = NULL;
+	ram.ring_left = 0;
+	ram.ring_right = 0;
+	ram.ring_particles.num = 0;
+}
+
+static void Rings_Build(const OPLEntry *layout)
+{
+	//Expand every ring group in the layout into single rings
+	ring_field_num = 0;
+	
+	uint8_t state = 0;
+	for (; layout->x != 0xFFFF; layout++)
+	{
+		//Get the group's respawn index (ObjPosLoad gives them out in layout order)
+		uint8_t respawn_index = 0;
+		if (layout->b4 & 0x80)
+			respawn_index = ++state;
+		if ((layout->b4 & 0x7F) != ObjId_Ring)
+			continue;
+		
+		uint8_t num = layout->subtype & 7;
+		if (num == 7)
+			num = 6;
+		
+		int16_t inc_x = ring_pos[layout->subtype >> 4][0];
+		int16_t inc_y = ring_pos[layout->subtype >> 4][1];
+		
+		int16_t x = layout->x;
+		int16_t y = layout->w1 & 0xFFF;
+		
+		for (uint8_t i = 0; i <= num; i++, x += inc_x, y += inc_y)
+		{
+			if (ring_field_num >= RING_FIELD_MAX)
+			{
+				printf("Rings_Build: Too many rings\n");
+				return;
+			}
+			
+			//Insert ring, keeping the list sorted (groups are already in order, so this rarely moves anything)
+			size_t j = ring_field_num++;
+			for (; j > 0 && ring_field[j - 1].x > x; j--)
+				ring_field[j] = ring_field[j - 1];
+			ring_field[j].x = x;
+			ring_field[j].y = y;
+			ring_field[j].respawn_index = respawn_index;
+			ring_field[j].bit = i;
+		}
+	}
+}
+
+void Rings_Load(const OPLEntry *layout)
+{
+	//Load the layout's rings
+	Rings_Clear();
+	ram.ring_layout = layout;
+	Rings_Build(layout);
+}
+
+void Rings_Restore()
+{
+	//Rebuild the ring list from the layout in ram, after ram has been replaced
+	ring_field_num = 0;
+	if (ram.ring_layout != NULL)
+		Rings_Build(ram.ring_layout);
+}
+
+static void Rings_Sparkle(int16_t x, int16_t y)
+{
+	//Leave a sparkle behind where a ring was collected
+	Object *sparkle = FindFreeObj();
+	if (sparkle != NULL)
+	{
+		sparkle->type = ObjId_Ring;
+		sparkle->routine = 6;
+		sparkle->pos.l.x.f.u = x;
+		sparkle->pos.l.y.f.u = y;
+		sparkle->mappings = map_ring;
+		sparkle->tile = TILE_MAP(0, 1, 0, 0, 0x7B2);
+		sparkle->render.b = 0;
+		sparkle->render.f.align_fg = true;
+		sparkle->priority = 1;
+		sparkle->width_pixels = 8;
+	}
+}
+
+static bool Rings_Collected(const RingFieldEntry *ring)
+{
+	return (ram.objstate[ring->respawn_index] >> ring->bit) & 1;
+}
+
+//Scattered rings
+//The rings dropped when Sonic's hurt are kept as particles in the RAM arena, moved and drawn together instead of as an object each
+static Object ring_probe; //Stands in for a ring object in floor checks
+
+static void Rings_RemoveParticle(uint16_t i)
+{
+	//Move the last particle into the removed one's place
+	RingParticles *particles = &ram.ring_particles;
+	uint16_t last = --particles->num;
+	particles->x[i] = particles->x[last];
+	particles->y[i] = particles->y[last];
+	particles->xsp[i] = particles->xsp[last];
+	particles->ysp[i] = particles->ysp[last];
+	particles->phase[i] = particles->phase[last];
+	particles->on_screen[i] = particles->on_screen[last];
+}
+
+void Rings_Scatter(Object *obj, uint16_t num)
+{
+	RingParticles *particles = &ram.ring_particles;
+	
+	//Spawn rings with the same spread as the ring loss object
+	int16_t xsp = 0, ysp = 0;
+	word_u angle;
+	angle.v = 0x0288;
+	
+	//The first ring takes the ring loss object's slot, the rest take the free slots FindFreeObj would've given out, in order
+	//A ring's slot sets which frames it checks for the floor on, and the original drops no more rings than there are free slots
+	int phase = ram.ExecuteObjects_i;
+	unsigned int slot = 0;
+	
+	for (; num > 0 && particles->num < RING_PARTICLES; num--)
+	{
+		Obj_RingLoss_Speed(&xsp, &ysp, &angle);
+		
+		uint16_t i = particles->num++;
+		particles->x[i] = (int32_t)obj->pos.l.x.f.u << 16;
+		particles->y[i] = (int32_t)obj->pos.l.y.f.u << 16;
+		particles->xsp[i] = xsp;
+		particles->ysp[i] = ysp;
+		particles->phase[i] = phase;
+		particles->on_screen[i] = false;
+		
+		xsp = -xsp;
+		angle.v = -angle.v;
+		
+		//Get the next free slot
+		while (slot < level_objects_num && level_objects[slot].type != ObjId_Null)
+			slot++;
+		if (slot >= level_objects_num)
+			break;
+		phase = level_objects_num - 1 - slot++;
+	}
+	ram.sprite_anim[3].time = -1;
+}
+
+void Rings_Update()
+{
+	RingParticles *particles = &ram.ring_particles;
+	uint16_t num = particles->num;
+	if (num == 0)
+		return;
+	
+	//Delete every particle once the animation is done
+	if (!ram.sprite_anim[3].time)
+	{
+		particles->num = 0;
+		return;
+	}
+	
+	//Move and fall
+	for (uint16_t i = 0; i < num; i++)
+	{
+		particles->x[i] += particles->xsp[i] << 8;
+		particles->y[i] += particles->ysp[i] << 8;
+		particles->ysp[i] += 0x18;
+	}
+	
+	for (uint16_t i = 0; i < particles->num;)
+	{
+		//Do floor collision (every 4 frames)
+		if (particles->ysp[i] >= 0 && ((particles->phase[i] + (ram.vbla_count & 0xFF)) & 3) == 0)
+		{
+			int16_t floor_dist = FindFloor(&ring_probe, particles->x[i] >> 16, (particles->y[i] >> 16) + 8, META_SOLID_TOP, 0, 0x10, &ram.angle_buffer[0]);
+			if (floor_dist < 0)
+			{
+				//Bounce off floor
+				particles->y[i] += (int32_t)floor_dist * 0x10000;
+				particles->ysp[i] = -(particles->ysp[i] - (particles->ysp[i] >> 2));
+			}
+		}
+		
+		//Delete once below level
+		if ((ram.limit_btm2 + SCREEN_HEIGHT) < (int16_t)(particles->y[i] >> 16))
+		{
+			Rings_RemoveParticle(i);
+			continue;
+		}
+		i++;
+	}
+}
+
+void Rings_DrawParticles(uint16_t **sprite, uint8_t *sprite_i)
+{
+	RingParticles *particles = &ram.ring_particles;
+	
+	//Get the ring mappings
+	if (ring_map_set == NULL && (ring_map_set = Map_Set(map_ring)) == NULL)
+		return;
+	uint8_t frame = ram.sprite_anim[3].frame;
+	
+	//Draw the visible particles
+	for (uint16_t i = 0; i < particles->num; i++)
+	{
+		particles->on_screen[i] = false;
+		
+		int16_t ox = (particles->x[i] >> 16) - ram.scrpos_x.f.u;
+		if ((ox + 8) < 0 || (ox - 8) >= SCREEN_WIDTH)
+			continue;
+		int16_t oy = (particles->y[i] >> 16) - ram.scrpos_y.f.u + 0x80;
+		if (oy < 0x60 || oy >= (0x180 + SCREEN_TALLADD))
+			continue;
+		
+		BuildSpr_Frame(sprite, sprite_i, 128 + ox, oy, TILE_MAP(0, 1, 0, 0, 0x7B2), ring_map_set, frame, 0);
+		particles->on_screen[i] = true;
+	}
+}
+
+//Ring collision and drawing
+void Rings_Touch(int16_t x, int16_t y, int16_t width, int16_t height)
+{
+	//Get the size of a ring (collision type 0x47)
+	const int16_t ring_width = 6;
+	const int16_t ring_height = 6;
+	
+	//Find the first visible ring that may be touching
+	size_t lo = ram.ring_left, hi = ram.ring_right;
+	while (lo < hi)
+	{
+		size_t mid = (lo + hi) >> 1;
+		if (ring_field[mid].x < x - ring_width)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	
+	//Collect every ring we're touching
+	for (RingFieldEntry *ring = &ring_field[lo]; ring < &ring_field[ram.ring_right] && ring->x <= x + width + ring_width; ring++)
+	{
+		//Rings are only touchable if they were drawn (the camera hasn't moved since)
+		int16_t oy = ring->y - ram.scrpos_y.f.u + 0x80;
+		if (oy < 0x60 || oy >= (0x180 + SCREEN_TALLADD))
+			continue;
+		
+		int16_t y_diff = y - (ring->y - ring_height);
+		if (y_diff < -height || y_diff > ring_height * 2 || Rings_Collected(ring))
+			continue;
+		
+		//Collect ring and mark as collected
+		CollectRing();
+		ram.objstate[ring->respawn_index] |= (1 << ring->bit);
+		Rings_Sparkle(ring->x, ring->y);
+	}
+	
+	//Collect every scattered ring we're touching
+	RingParticles *particles = &ram.ring_particles;
+	for (uint16_t i = 0; i < particles->num;)
+	{
+		int16_t x_diff = x - ((particles->x[i] >> 16) - ring_width);
+		int16_t y_diff = y - ((particles->y[i] >> 16) - ring_height);
+		if (!particles->on_screen[i] || x_diff < -width || x_diff > ring_width * 2 || y_diff < -height || y_diff > ring_height * 2)
+		{
+			i++;
+			continue;
+		}
+		
+		CollectRing();
+		Rings_Sparkle(particles->x[i] >> 16, particles->y[i] >> 16);
+		Rings_RemoveParticle(i);
+	}
+}
+
+void Rings_Draw(uint16_t **sprite, uint8_t *sprite_i)
+{
+	//Slide the visible window to the screen
+	int16_t left = ram.scrpos_x.f.u - 8;
+	int16_t right = ram.scrpos_x.f.u + SCREEN_WIDTH + 8;
+	
+	while (ram.ring_left < ring_field_num && ring_field[ram.ring_left].x < left)
+		ram.ring_left++;
+	while (ram.ring_left > 0 && ring_field[ram.ring_left - 1].x >= left)
+		ram.ring_left--;
+	while (ram.ring_right < ring_field_num && ring_field[ram.ring_right].x < right)
+		ram.ring_right++;
+	while (ram.ring_right > ram.ring_left && ring_field[ram.ring_right - 1].x >= right)
+		ram.ring_right--;
+	
+	//Get the ring mappings
+	if (ring_map_set == NULL && (ring_map_set = Map_Set(map_ring)) == NULL)
+		return;
+	uint8_t frame = ram.sprite_anim[1].frame;
+	
+	//Draw the visible rings
+	for (const RingFieldEntry *ring = &ring_field[ram.ring_left]; ring < &ring_field[ram.ring_right]; ring++)
+	{
+		int16_t oy = ring->y - ram.scrpos_y.f.u + 0x80;
+		if (oy < 0x60 || oy >= (0x180 + SCREEN_TALLADD) || Rings_Collected(ring))
+			continue;
+		BuildSpr_Frame(sprite, sprite_i, 128 + ring->x - ram.scrpos_x.f.u, oy, TILE_MAP(0, 1, 0, 0, 0x7B2), ring_map_set, frame, 0);
+	}
+}
+#endif
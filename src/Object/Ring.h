@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Object.h"
+#include "RAM.h"
+
+//Ring functions
+void StressRings(unsigned int num);
+
+#ifdef SCP_RING_MANAGER
+//Ring manager
+void Rings_Clear();
+void Rings_Load(const OPLEntry *layout);
+void Rings_Restore();
+void Rings_Touch(int16_t x, int16_t y, int16_t width, int16_t height);
+void Rings_Draw(uint16_t **sprite, uint8_t *sprite_i);
+
+void Rings_Scatter(Object *obj, uint16_t num);
+void Rings_Update();
+void Rings_DrawParticles(uint16_t **sprite, uint8_t *sprite_i);
+#endif
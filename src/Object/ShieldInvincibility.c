@@ -50,9 +50,9 @@ void Obj_ShieldInvincibility(Object *obj)
 			break;
 		case 2: //Shield
 			//Check if shield should exist
-			if (invincibility)
+			if (ram.invincibility)
 				break;
-			if (!shield)
+			if (!ram.shield)
 			{
 				ObjectDelete(obj);
 				break;
@@ -69,14 +69,14 @@ void Obj_ShieldInvincibility(Object *obj)
 			break;
 		case 4: //Invincibility
 			//Check if invincibility should exist
-			if (!invincibility)
+			if (!ram.invincibility)
 			{
 				ObjectDelete(obj);
 				break;
 			}
 			
 			//Get trail position
-			uint8_t track_ind = track_pos.f.l;
+			uint8_t track_ind = ram.track_pos.f.l;
 			uint8_t track_off = (obj->anim - 1) << 3;
 			track_off = (track_off << 1) + track_off + 4;
 			track_ind -= track_off + scratch->trail;
@@ -84,7 +84,7 @@ void Obj_ShieldInvincibility(Object *obj)
 				scratch->trail = 0;
 			
 			//Set object position
-			int16_t *pos = track_sonic[track_ind >> 2];
+			int16_t *pos = ram.track_sonic[track_ind >> 2];
 			obj->pos.l.x.f.u = *pos++;
 			obj->pos.l.y.f.u = *pos++;
 			obj->status.b = player->status.b;
@@ -59,8 +59,8 @@ void Obj_Signpost(Object *obj)
 			{
 				//Start spinning
 				//music	sfx_Signpost,0,0,0	; play signpost sound TODO
-				time_count = false;
-				limit_left2 = limit_right2;
+				ram.time_count = false;
+				ram.limit_left2 = ram.limit_right2;
 				obj->routine += 2;
 			}
 			break;
@@ -107,31 +107,31 @@ void Obj_Signpost(Object *obj)
 			break;
 		case 6: //Player run
 			//Lock player controls
-			if (debug_use)
+			if (ram.debug_use)
 				break;
 			if (!player->status.p.f.in_air)
 			{
-				lock_ctrl = true;
-				jpad1_hold2 = JPAD_RIGHT;
-				jpad1_press2 = 0;
+				ram.lock_ctrl = true;
+				ram.jpad1_hold2 = JPAD_RIGHT;
+				ram.jpad1_press2 = 0;
 			}
 			
 			//Check if level end sequence should play
-			if (player->type != ObjId_Null && (uint16_t)player->pos.l.x.f.u < (limit_right2 + 296 + SCREEN_WIDEADD))
+			if (player->type != ObjId_Null && (uint16_t)player->pos.l.x.f.u < (ram.limit_right2 + 296 + SCREEN_WIDEADD))
 				break;
 			
 			//Start level end sequence
 			obj->routine += 2;
-			if (objects[23].type != ObjId_Null)
+			if (ram.objects[23].type != ObjId_Null)
 				break;
 			
 			//Reset game state
-			limit_left2 = limit_right2;
-			invincibility = false;
-			time_count = false;
+			ram.limit_left2 = ram.limit_right2;
+			ram.invincibility = false;
+			ram.time_count = false;
 			
 			//Load "Got through" card
-			objects[23].type = ObjId_GotThroughCard;
+			ram.objects[23].type = ObjId_GotThroughCard;
 			NewPLC(PlcId_TitleCard);
 			break;
 		case 8: //Level end
@@ -7,6 +7,7 @@
 #include "LevelCollision.h"
 #include "MathUtil.h"
 #include "PLC.h"
+#include "Ring.h"
 
 #include <string.h>
 
@@ -17,17 +18,6 @@ const uint8_t map_sonic[] = {
 	#include "Resource/Mappings/Sonic.h"
 };
 
-//Sonic globals
-int16_t sonspeed_max, sonspeed_acc, sonspeed_dec;
-
-uint8_t sonframe_num, sonframe_chg;
-uint8_t sgfx_buffer[SONIC_DPLC_SIZE];
-
-int16_t track_sonic[0x40][2];
-word_u track_pos;
-
-uint8_t dbg_ang0, dbg_ang1, dbg_ang2, dbg_ang3; //0xFFEC-0xFFEF
-
 //General Sonic state stuff
 static void Sonic_Display(Object *obj)
 {
@@ -52,13 +42,13 @@ static void Sonic_Display(Object *obj)
 		if (--scratch->invincibility_time == 0)
 		{
 			//Restore music
-			if (!(lock_screen || air < 12))
+			if (!(ram.lock_screen || ram.air < 12))
 			{
 				//TODO
 			}
 			
 			//Clear flag
-			invincibility = false;
+			ram.invincibility = false;
 		}
 	}
 	
@@ -68,12 +58,12 @@ static void Sonic_Display(Object *obj)
 		if (--scratch->shoes_time == 0)
 		{
 			//Restore Sonic's speed
-			sonspeed_max = 0x600; //BUG: Water isn't checked
-			sonspeed_acc = 0xC;
-			sonspeed_dec = 0x80;
+			ram.sonspeed_max = 0x600; //BUG: Water isn't checked
+			ram.sonspeed_acc = 0xC;
+			ram.sonspeed_dec = 0x80;
 			
 			//Clear flag and restore music
-			shoes = false;
+			ram.shoes = false;
 			//music	bgm_Slowdown,1,0,0	; run music at normal speed //TODO
 		}
 	}
@@ -82,51 +72,31 @@ static void Sonic_Display(Object *obj)
 static void Sonic_RecordPosition(Object *obj)
 {
 	//Track current position
-	int16_t *write = &track_sonic[0][0] + (track_pos.v >> 1);
+	int16_t *write = &ram.track_sonic[0][0] + (ram.track_pos.v >> 1);
 	*write++ = obj->pos.l.x.f.u;
 	*write++ = obj->pos.l.y.f.u;
-	track_pos.f.l += 4;
+	ram.track_pos.f.l += 4;
 }
 
 //Sonic animation
 const uint8_t anim_sonic[] = {
 	#include "Resource/Animation/Sonic.h"
 };
-#define GET_SONIC_ANISCR(x) (anim_sonic + ((anim_sonic[((x) << 1)] << 8) | (anim_sonic[((x) << 1) + 1] << 0)))
 
-static void Sonic_AnimateReadFrame(Object *obj, const uint8_t *anim_script)
+static void Sonic_AnimateReadFrame(Object *obj, uint8_t anim)
 {
-	//Read current animation command
-	uint8_t cmd = anim_script[1 + obj->anim_frame];
-	
-	if (!(cmd & 0x80))
+	//Run compiled animation command
+	const AnimStep *step = Anim_Step(obj, anim_sonic, anim);
+	if (step == NULL)
+		return;
+	if (step->op == AnimOp_Frame)
 	{
-		Anim_Next:
-		//Set animation frame
-		obj->frame = cmd;
-		obj->anim_frame++;
+		obj->frame = step->cmd;
+		obj->anim_frame = step->next;
 	}
-	else
+	else if (step->op == AnimOp_Anim)
 	{
-		if (++cmd == 0) //0xFF
-		{
-			//Restart animation
-			obj->anim_frame = 0;
-			cmd = anim_script[1];
-			goto Anim_Next;
-		}
-		if (++cmd == 0) //0xFE
-		{
-			//Go back (next byte) frames
-			obj->anim_frame -= anim_script[2 + obj->anim_frame];
-			cmd = anim_script[1 + obj->anim_frame];
-			goto Anim_Next;
-		}
-		if (++cmd == 0) //0xFD
-		{
-			//Change animation (falls through to the routine increment below)
-			obj->anim = anim_script[2 + obj->anim_frame];
-		}
+		obj->anim = step->cmd;
 	}
 }
 
@@ -163,7 +133,7 @@ void Sonic_Animate(Object *obj)
 		obj->frame_time.b = anim_wait;
 		
 		//Read animation
-		Sonic_AnimateReadFrame(obj, anim_script);
+		Sonic_AnimateReadFrame(obj, obj->anim);
 	}
 	else
 	{
@@ -198,10 +168,10 @@ void Sonic_Animate(Object *obj)
 			uint16_t abs_spd = (obj->inertia < 0) ? -obj->inertia : obj->inertia;
 			
 			//Get script to use
-			anim_script = GET_SONIC_ANISCR(SonAnimId_Run);
+			uint8_t run_anim = SonAnimId_Run;
 			if (abs_spd < 0x600)
 			{
-				anim_script = GET_SONIC_ANISCR(SonAnimId_Walk);
+				run_anim = SonAnimId_Walk;
 				angle += (angle >> 1);
 			}
 			angle <<= 1;
@@ -213,7 +183,7 @@ void Sonic_Animate(Object *obj)
 			obj->frame_time.b = anim_spd >> 8;
 			
 			//Read animation
-			Sonic_AnimateReadFrame(obj, anim_script);
+			Sonic_AnimateReadFrame(obj, run_anim);
 			obj->frame += angle;
 		}
 		else if (++anim_wait == 0)
@@ -223,9 +193,9 @@ void Sonic_Animate(Object *obj)
 			uint16_t abs_spd = (obj->inertia < 0) ? -obj->inertia : obj->inertia;
 			
 			//Get script to use
-			anim_script = GET_SONIC_ANISCR(SonAnimId_Roll2);
+			uint8_t roll_anim = SonAnimId_Roll2;
 			if (abs_spd < 0x600)
-				anim_script = GET_SONIC_ANISCR(SonAnimId_Roll);
+				roll_anim = SonAnimId_Roll;
 			
 			//Get animation delay
 			int16_t anim_spd = 0x400 - abs_spd;
@@ -238,7 +208,7 @@ void Sonic_Animate(Object *obj)
 			obj->render.f.y_flip = false;
 			
 			//Read animation
-			Sonic_AnimateReadFrame(obj, anim_script);
+			Sonic_AnimateReadFrame(obj, roll_anim);
 		}
 		else
 		{
@@ -253,15 +223,12 @@ void Sonic_Animate(Object *obj)
 				anim_spd = 0;
 			obj->frame_time.b = anim_spd >> 6;
 			
-			//Get script to use
-			anim_script = GET_SONIC_ANISCR(SonAnimId_Push);
-			
 			//Set render flip
 			obj->render.f.x_flip = obj->status.p.f.x_flip;
 			obj->render.f.y_flip = false;
 			
 			//Read animation
-			Sonic_AnimateReadFrame(obj, anim_script);
+			Sonic_AnimateReadFrame(obj, SonAnimId_Push);
 		}
 	}
 }
@@ -275,14 +242,15 @@ static const uint8_t dplc_sonic[] = {
 	#include "Resource/Mappings/SonicDPLC.h"
 };
 
-void Sonic_LoadGfx(Object *obj)
+//Each frame's tiles, gathered from the DPLC script into one block
+#define SONIC_FRAMES 0x58
+
+static uint8_t sonic_gfx[SONIC_FRAMES][SONIC_DPLC_SIZE];
+static int16_t sonic_gfx_len[SONIC_FRAMES];
+static bool sonic_gfx_built;
+
+static int16_t Sonic_ReadDPLC(uint8_t frame, uint8_t *top)
 {
-	//Check if we're loading a new frame
-	uint8_t frame = obj->frame;
-	if (frame == sonframe_num)
-		return;
-	sonframe_num = frame;
-	
 	//Get DPLC script
 	const uint8_t *dplc_script = dplc_sonic;
 	frame <<= 1;
@@ -291,12 +259,10 @@ void Sonic_LoadGfx(Object *obj)
 	//Read number of entries
 	int8_t entries = (*dplc_script++) - 1;
 	if (entries < 0)
-		return;
-	
-	//Start reading data
-	uint8_t *top = sgfx_buffer;
-	sonframe_chg = true;
+		return -1;
 	
+	//Read data
+	uint8_t *start = top;
 	do
 	{
 		//Read entry
@@ -312,6 +278,38 @@ void Sonic_LoadGfx(Object *obj)
 			top += 0x20;
 		} while (tiles-- > 0);
 	} while (entries-- > 0);
+	return top - start;
+}
+
+void Sonic_LoadGfx(Object *obj)
+{
+	//Check if we're loading a new frame
+	uint8_t frame = obj->frame;
+	if (frame == ram.sonframe_num)
+		return;
+	ram.sonframe_num = frame;
+	
+	//Gather every frame's tiles the first time
+	if (!sonic_gfx_built)
+	{
+		for (int i = 0; i < SONIC_FRAMES; i++)
+			sonic_gfx_len[i] = Sonic_ReadDPLC(i, sonic_gfx[i]);
+		sonic_gfx_built = true;
+	}
+	
+	//Copy frame's tiles (reading the script directly for frames past the table)
+	if (frame < SONIC_FRAMES)
+	{
+		if (sonic_gfx_len[frame] < 0)
+			return;
+		memcpy(ram.sgfx_buffer, sonic_gfx[frame], sonic_gfx_len[frame]);
+	}
+	else
+	{
+		if (Sonic_ReadDPLC(frame, ram.sgfx_buffer) < 0)
+			return;
+	}
+	ram.sonframe_chg = true;
 }
 
 //Sonic collision functions
@@ -334,17 +332,17 @@ void Sonic_ResetOnFloor(Object *obj)
 	}
 	
 	scratch->jumping = false;
-	item_bonus = 0;
+	ram.item_bonus = 0;
 }
 
 static int16_t Sonic_Angle(Object *obj, int16_t dist0, int16_t dist1)
 {
 	//Get angle and distance to use (use closest one)
-	uint8_t res_angle = angle_buffer1;
+	uint8_t res_angle = ram.angle_buffer[1];
 	int16_t res_dist = dist1;
 	if (dist1 > dist0)
 	{
-		res_angle = angle_buffer0;
+		res_angle = ram.angle_buffer[0];
 		res_dist = dist0;
 	}
 	
@@ -363,14 +361,14 @@ static void Sonic_AnglePos(Object *obj)
 	//Don't do floor collision if standing on an object
 	if (obj->status.p.f.object_stand)
 	{
-		angle_buffer0 = 0;
-		angle_buffer1 = 0;
+		ram.angle_buffer[0] = 0;
+		ram.angle_buffer[1] = 0;
 		return;
 	}
 	
 	//Set 'no floor' angle
-	angle_buffer0 = 3;
-	angle_buffer1 = 3;
+	ram.angle_buffer[0] = 3;
+	ram.angle_buffer[1] = 3;
 	
 	//Get symmetrical angle
 	uint8_t angle = obj->angle;
@@ -387,13 +385,16 @@ static void Sonic_AnglePos(Object *obj)
 		angle += 0x1F;
 	}
 	
-	int16_t dist0, dist1, dist;
+	//Check both feet
+	int16_t x[2], y[2], dist_s[2], dist;
 	switch (angle & 0xC0)
 	{
 		case 0x00:
-			dist0 = FindFloor(obj, obj->pos.l.x.f.u + obj->x_rad, obj->pos.l.y.f.u + obj->y_rad, META_SOLID_TOP, 0, 0x10, &angle_buffer0);
-			dist1 = FindFloor(obj, obj->pos.l.x.f.u - obj->x_rad, obj->pos.l.y.f.u + obj->y_rad, META_SOLID_TOP, 0, 0x10, &angle_buffer1);
-			if ((dist = Sonic_Angle(obj, dist0, dist1)) != 0)
+			x[0] = obj->pos.l.x.f.u + obj->x_rad;
+			x[1] = obj->pos.l.x.f.u - obj->x_rad;
+			y[0] = y[1] = obj->pos.l.y.f.u + obj->y_rad;
+			FindFloors(obj, 2, x, y, META_SOLID_TOP, 0, 0x10, dist_s, ram.angle_buffer);
+			if ((dist = Sonic_Angle(obj, dist_s[0], dist_s[1])) != 0)
 			{
 				if (dist < 0)
 				{
@@ -416,9 +417,11 @@ static void Sonic_AnglePos(Object *obj)
 			}
 			break;
 		case 0x40:
-			dist0 = FindWall(obj, (obj->pos.l.x.f.u - obj->y_rad) ^ 0xF, obj->pos.l.y.f.u - obj->x_rad, META_SOLID_TOP, META_X_FLIP, -0x10, &angle_buffer0);
-			dist1 = FindWall(obj, (obj->pos.l.x.f.u - obj->y_rad) ^ 0xF, obj->pos.l.y.f.u + obj->x_rad, META_SOLID_TOP, META_X_FLIP, -0x10, &angle_buffer1);
-			if ((dist = Sonic_Angle(obj, dist0, dist1)) != 0)
+			x[0] = x[1] = (obj->pos.l.x.f.u - obj->y_rad) ^ 0xF;
+			y[0] = obj->pos.l.y.f.u - obj->x_rad;
+			y[1] = obj->pos.l.y.f.u + obj->x_rad;
+			FindWalls(obj, 2, x, y, META_SOLID_TOP, META_X_FLIP, -0x10, dist_s, ram.angle_buffer);
+			if ((dist = Sonic_Angle(obj, dist_s[0], dist_s[1])) != 0)
 			{
 				if (dist < 0)
 				{
@@ -441,9 +444,11 @@ static void Sonic_AnglePos(Object *obj)
 			}
 			break;
 		case 0x80:
-			dist0 = FindFloor(obj, obj->pos.l.x.f.u - obj->x_rad, (obj->pos.l.y.f.u - obj->y_rad) ^ 0xF, META_SOLID_TOP, META_Y_FLIP, -0x10, &angle_buffer0);
-			dist1 = FindFloor(obj, obj->pos.l.x.f.u + obj->x_rad, (obj->pos.l.y.f.u - obj->y_rad) ^ 0xF, META_SOLID_TOP, META_Y_FLIP, -0x10, &angle_buffer1);
-			if ((dist = Sonic_Angle(obj, dist0, dist1)) != 0)
+			x[0] = obj->pos.l.x.f.u - obj->x_rad;
+			x[1] = obj->pos.l.x.f.u + obj->x_rad;
+			y[0] = y[1] = (obj->pos.l.y.f.u - obj->y_rad) ^ 0xF;
+			FindFloors(obj, 2, x, y, META_SOLID_TOP, META_Y_FLIP, -0x10, dist_s, ram.angle_buffer);
+			if ((dist = Sonic_Angle(obj, dist_s[0], dist_s[1])) != 0)
 			{
 				if (dist < 0)
 				{
@@ -466,9 +471,11 @@ static void Sonic_AnglePos(Object *obj)
 			}
 			break;
 		case 0xC0:
-			dist0 = FindWall(obj, obj->pos.l.x.f.u + obj->y_rad, obj->pos.l.y.f.u + obj->x_rad, META_SOLID_TOP, 0, 0x10, &angle_buffer0);
-			dist1 = FindWall(obj, obj->pos.l.x.f.u + obj->y_rad, obj->pos.l.y.f.u - obj->x_rad, META_SOLID_TOP, 0, 0x10, &angle_buffer1);
-			if ((dist = Sonic_Angle(obj, dist0, dist1)) != 0)
+			x[0] = x[1] = obj->pos.l.x.f.u + obj->y_rad;
+			y[0] = obj->pos.l.y.f.u + obj->x_rad;
+			y[1] = obj->pos.l.y.f.u - obj->x_rad;
+			FindWalls(obj, 2, x, y, META_SOLID_TOP, 0, 0x10, dist_s, ram.angle_buffer);
+			if ((dist = Sonic_Angle(obj, dist_s[0], dist_s[1])) != 0)
 			{
 				if (dist < 0)
 				{
@@ -499,11 +506,11 @@ static void Sonic_Floor(Object *obj)
 	//There's some weird logging stuff done here
 	//Maybe testing if the CalcAngle is yielding desirable results?
 	uint8_t angle = CalcAngle(obj->xsp, obj->ysp);
-	dbg_ang0 = angle;
+	ram.dbg_ang0 = angle;
 	angle -= 0x20;
-	dbg_ang1 = angle;
+	ram.dbg_ang1 = angle;
 	angle &= 0xC0;
-	dbg_ang2 = angle;
+	ram.dbg_ang2 = angle;
 	
 	int16_t dist0, dist1, clip;
 	uint8_t hit_angle;
@@ -524,7 +531,7 @@ static void Sonic_Floor(Object *obj)
 			
 			//Collide with floor
 			GetDistance_Down(obj, &dist0, &dist1, &hit_angle);
-			dbg_ang3 = dist1; //...What?
+			ram.dbg_ang3 = dist1; //...What?
 			
 			clip = -((obj->ysp >> 8) + 8);
 			if (dist1 < 0 && (dist0 >= clip || dist1 >= clip))
@@ -674,7 +681,7 @@ static void Sonic_HurtStop(Object *obj)
 	Scratch_Sonic *scratch = (Scratch_Sonic*)&obj->scratch;
 	
 	//Die when falling below the level
-	if ((limit_btm2 + SCREEN_HEIGHT) < obj->pos.l.y.f.u)
+	if ((ram.limit_btm2 + SCREEN_HEIGHT) < obj->pos.l.y.f.u)
 	{
 		KillSonic(obj, obj); //a1 isn't set
 		return;
@@ -694,52 +701,12 @@ static void Sonic_HurtStop(Object *obj)
 }
 
 //Object collision
-static const uint8_t obj_sizes[][2] = {
-	{ 0x0,  0x0},
-	{0x14, 0x14},
-	{ 0xC, 0x14},
-	{0x14,  0xC},
-	{ 0x4, 0x10},
-	{ 0xC, 0x12},
-	{0x10, 0x10},
-	{ 0x6,  0x6},
-	{0x18,  0xC},
-	{ 0xC, 0x10},
-	{0x10,  0xC},
-	{ 0x8,  0x8},
-	{0x14, 0x10},
-	{0x14,  0x8},
-	{ 0xE,  0xE},
-	{0x18, 0x18},
-	{0x28, 0x10},
-	{0x10, 0x18},
-	{ 0x8, 0x10},
-	{0x20, 0x70},
-	{0x40, 0x20},
-	{0x80, 0x20},
-	{0x20, 0x20},
-	{ 0x8,  0x8},
-	{ 0x4,  0x4},
-	{0x20,  0x8},
-	{ 0xC,  0xC},
-	{ 0x8,  0x4},
-	{0x18,  0x4},
-	{0x28,  0x4},
-	{ 0x4,  0x8},
-	{ 0x4, 0x18},
-	{ 0x4, 0x28},
-	{ 0x4, 0x20},
-	{0x18, 0x18},
-	{ 0xC, 0x18},
-	{0x48,  0x8},
-};
-
 static signed int React_ChkHurt(Object *obj, Object *hit)
 {
 	Scratch_Sonic *scratch = (Scratch_Sonic*)&obj->scratch;
 	
 	//Check for invincibility or invulnerability
-	if (invincibility)
+	if (ram.invincibility)
 		return -1;
 	if (scratch->flash_time)
 		return -1;
@@ -751,7 +718,7 @@ static signed int React_ChkHurt(Object *obj, Object *hit)
 static signed int React_Enemy(Object *obj, Object *hit)
 {
 	//Check if we can hurt the enemy
-	if (!(invincibility || obj->anim == SonAnimId_Roll))
+	if (!(ram.invincibility || obj->anim == SonAnimId_Roll))
 		return React_ChkHurt(obj, hit);
 	
 	//Check if enemy is a boss
@@ -770,8 +737,8 @@ static signed int React_Enemy(Object *obj, Object *hit)
 		hit->status.o.f.flag7 = true;
 		
 		//Increment bonus
-		uint8_t bonus = item_bonus;
-		item_bonus += 2;
+		uint8_t bonus = ram.item_bonus;
+		ram.item_bonus += 2;
 		
 		//Handle score bonus
 		if (bonus >= 6)
@@ -780,7 +747,7 @@ static signed int React_Enemy(Object *obj, Object *hit)
 		
 		static const uint16_t points[] = {10, 20, 50, 100};
 		uint16_t point_bonus = points[bonus >> 1];
-		if (item_bonus >= 32) //16 enemies destroyed
+		if (ram.item_bonus >= 32) //16 enemies destroyed
 		{
 			point_bonus = 1000;
 			hit->scratch.u16[0xB] = 10;
@@ -849,41 +816,34 @@ static signed int ReactToItem(Object *obj)
 	width = 16;
 	height <<= 1;
 	
-	//Iterate through level objects
-	Object *hit = level_objects;
-	for (int i = 0; i < LEVEL_OBJECTS; i++, hit++)
+	#ifdef SCP_RING_MANAGER
+		//Collect the ring manager's rings
+		if (scratch->flash_time < 90)
+			Rings_Touch(x, y, width, height);
+	#endif
+	
+	//Iterate through touched level objects
+	TouchQuery query;
+	Touch_Start(&query, x, y, width, height);
+	
+	Object *hit;
+	while ((hit = Touch_Next(&query)) != NULL)
 	{
-		//Check if object is collidable
-		if (!(hit->render.f.on_screen && hit->col_type))
-			continue;
-		
-		//Get object's size
-		const uint8_t *sizep = obj_sizes[hit->col_type & 0x3F];
-		uint8_t hit_width = *sizep++;
-		uint8_t hit_height = *sizep++;
-		
-		//Check if we're touching (TODO: may be inaccurate)
-		int16_t x_diff = x - (hit->pos.l.x.f.u - hit_width);
-		int16_t y_diff = y - (hit->pos.l.y.f.u - hit_height);
-		
-		if (x_diff >= -width && x_diff <= hit_width * 2 && y_diff >= -height && y_diff <= hit_height * 2)
+		//Made contact
+		switch (hit->col_type & 0xC0)
 		{
-			//Made contact
-			switch (hit->col_type & 0xC0)
-			{
-				case 0x00: //Enemy
-					return React_Enemy(obj, hit);
-				case 0xC0: //Special
-					break;
-				case 0x80: //Hurt
-					return React_ChkHurt(obj, hit);
-				case 0x40: //Other
-					if ((hit->col_type & 0x3F) == 6)
-						return React_Monitor(obj, hit);
-					if (scratch->flash_time < 90)
-						hit->routine = 4;
-					break;
-			}
+			case 0x00: //Enemy
+				return React_Enemy(obj, hit);
+			case 0xC0: //Special
+				break;
+			case 0x80: //Hurt
+				return React_ChkHurt(obj, hit);
+			case 0x40: //Other
+				if ((hit->col_type & 0x3F) == 6)
+					return React_Monitor(obj, hit);
+				if (scratch->flash_time < 90)
+					hit->routine = 4;
+				break;
 		}
 	}
 	return 0;
@@ -895,9 +855,9 @@ signed int HurtSonic(Object *obj, Object *src)
 	Scratch_Sonic *scratch = (Scratch_Sonic*)&obj->scratch;
 	
 	//Lose rings and shield
-	if (!shield)
+	if (!ram.shield)
 	{
-		if (rings)
+		if (ram.rings)
 		{
 			//Spawn lost rings object
 			Object *rings = FindFreeObj();
@@ -908,13 +868,13 @@ signed int HurtSonic(Object *obj, Object *src)
 				rings->pos.l.y.f.u = obj->pos.l.y.f.u;
 			}
 		}
-		else if (!debug_mode)
+		else if (!ram.debug_mode)
 		{
 			//Die
 			return KillSonic(obj, src);
 		}
 	}
-	shield = 0;
+	ram.shield = 0;
 	
 	//Set Sonic state
 	obj->routine = 4;
@@ -948,11 +908,11 @@ signed int KillSonic(Object *obj, Object *src)
 	Scratch_Sonic *scratch = (Scratch_Sonic*)&obj->scratch;
 	
 	//Check if we can be killed
-	if (debug_use)
+	if (ram.debug_use)
 		return -1;
 	
 	//Set state
-	invincibility = false;
+	ram.invincibility = false;
 	obj->routine = 6;
 	Sonic_ResetOnFloor(obj);
 	obj->status.p.f.in_air = true;
@@ -980,7 +940,7 @@ static bool Sonic_Jump(Object *obj)
 	Scratch_Sonic *scratch = (Scratch_Sonic*)&obj->scratch;
 	
 	//Don't jump if ABC isn't pressed
-	if (!(jpad1_press2 & (JPAD_A | JPAD_C | JPAD_B)))
+	if (!(ram.jpad1_press2 & (JPAD_A | JPAD_C | JPAD_B)))
 		return false;
 	
 	//Check if we have enough room to jump
@@ -1049,8 +1009,8 @@ static void Sonic_MoveLeft(Object *obj)
 		}
 		
 		//Accelerate
-		if ((inertia -= sonspeed_acc) <= -sonspeed_max)
-			inertia = -sonspeed_max;
+		if ((inertia -= ram.sonspeed_acc) <= -ram.sonspeed_max)
+			inertia = -ram.sonspeed_max;
 		
 		//Set speed and animation
 		obj->inertia = inertia;
@@ -1059,7 +1019,7 @@ static void Sonic_MoveLeft(Object *obj)
 	else
 	{
 		//Decelerate
-		if ((inertia -= sonspeed_dec) < 0)
+		if ((inertia -= ram.sonspeed_dec) < 0)
 			inertia = -0x80;
 		obj->inertia = inertia;
 		
@@ -1087,8 +1047,8 @@ static void Sonic_MoveRight(Object *obj)
 		}
 		
 		//Accelerate
-		if ((inertia += sonspeed_acc) >= sonspeed_max)
-			inertia = sonspeed_max;
+		if ((inertia += ram.sonspeed_acc) >= ram.sonspeed_max)
+			inertia = ram.sonspeed_max;
 		
 		//Set speed and animation
 		obj->inertia = inertia;
@@ -1097,7 +1057,7 @@ static void Sonic_MoveRight(Object *obj)
 	else
 	{
 		//Decelerate
-		if ((inertia += sonspeed_dec) >= 0)
+		if ((inertia += ram.sonspeed_dec) >= 0)
 			inertia = 0x80;
 		obj->inertia = inertia;
 		
@@ -1115,14 +1075,14 @@ static void Sonic_Move(Object *obj)
 {
 	Scratch_Sonic *scratch = (Scratch_Sonic*)&obj->scratch;
 	
-	if (!jump_only)
+	if (!ram.jump_only)
 	{
 		if (!scratch->control_lock)
 		{
 			//Move left and right according to held direction
-			if (jpad1_hold2 & JPAD_LEFT)
+			if (ram.jpad1_hold2 & JPAD_LEFT)
 				Sonic_MoveLeft(obj);
-			if (jpad1_hold2 & JPAD_RIGHT)
+			if (ram.jpad1_hold2 & JPAD_RIGHT)
 				Sonic_MoveRight(obj);
 			
 			//Do idle or balance animation
@@ -1135,7 +1095,7 @@ static void Sonic_Move(Object *obj)
 				if (obj->status.p.f.object_stand)
 				{
 					//Balance on an object
-					Object *stand = &objects[scratch->standing_obj];
+					Object *stand = &ram.objects[scratch->standing_obj];
 					if (!stand->status.o.f.flag7)
 					{
 						int16_t left_dist = stand->width_pixels;
@@ -1174,18 +1134,18 @@ static void Sonic_Move(Object *obj)
 				
 				//Handle looking up and down
 				LookUpDown:;
-				if (jpad1_hold2 & JPAD_UP)
+				if (ram.jpad1_hold2 & JPAD_UP)
 				{
 					obj->anim = SonAnimId_LookUp;
-					if (look_shift != (200 + SCREEN_TALLADD2))
-						look_shift += 2;
+					if (ram.look_shift != (200 + SCREEN_TALLADD2))
+						ram.look_shift += 2;
 					goto DoFriction;
 				}
-				if (jpad1_hold2 & JPAD_DOWN)
+				if (ram.jpad1_hold2 & JPAD_DOWN)
 				{
 					obj->anim = SonAnimId_Duck;
-					if (look_shift != (8 + SCREEN_TALLADD2))
-						look_shift -= 2;
+					if (ram.look_shift != (8 + SCREEN_TALLADD2))
+						ram.look_shift -= 2;
 					goto DoFriction;
 				}
 			}
@@ -1193,23 +1153,23 @@ static void Sonic_Move(Object *obj)
 		
 		//Reset camera to neutral position
 		Sonic_ResetScr:;
-		if (look_shift < (96 + SCREEN_TALLADD2))
-			look_shift += 2;
-		else if (look_shift > (96 + SCREEN_TALLADD2))
-			look_shift -= 2;
+		if (ram.look_shift < (96 + SCREEN_TALLADD2))
+			ram.look_shift += 2;
+		else if (ram.look_shift > (96 + SCREEN_TALLADD2))
+			ram.look_shift -= 2;
 		
 		//Friction
 		DoFriction:;
-		if (!(jpad1_hold2 & (JPAD_LEFT | JPAD_RIGHT)))
+		if (!(ram.jpad1_hold2 & (JPAD_LEFT | JPAD_RIGHT)))
 		{
 			if (obj->inertia > 0)
 			{
-				if ((obj->inertia -= sonspeed_acc) < 0)
+				if ((obj->inertia -= ram.sonspeed_acc) < 0)
 					obj->inertia = 0;
 			}
 			else if (obj->inertia < 0)
 			{
-				if ((obj->inertia += sonspeed_acc) >= 0)
+				if ((obj->inertia += ram.sonspeed_acc) >= 0)
 					obj->inertia = 0;
 			}
 		}
@@ -1274,9 +1234,9 @@ static void Sonic_ChkRoll(Object *obj)
 static void Sonic_Roll(Object *obj)
 {
 	//Check if we can and are trying to roll
-	if (jump_only || ((obj->inertia < 0) ? -obj->inertia : obj->inertia) < 0x80)
+	if (ram.jump_only || ((obj->inertia < 0) ? -obj->inertia : obj->inertia) < 0x80)
 		return;
-	if ((jpad1_hold2 & (JPAD_LEFT | JPAD_RIGHT)) || !(jpad1_hold2 & JPAD_DOWN))
+	if ((ram.jpad1_hold2 & (JPAD_LEFT | JPAD_RIGHT)) || !(ram.jpad1_hold2 & JPAD_DOWN))
 		return;
 	Sonic_ChkRoll(obj);
 }
@@ -1289,23 +1249,23 @@ static void Sonic_LevelBound(Object *obj)
 	
 	//Prevent us from going off the left or right boundaries
 	int16_t bound;
-	if (x < (bound = limit_left2 + 16) || x > (bound = limit_right2 + (lock_screen ? 290 : 360) + SCREEN_WIDEADD))
+	if (x < (bound = ram.limit_left2 + 16) || x > (bound = ram.limit_right2 + (ram.lock_screen ? 290 : 360) + SCREEN_WIDEADD))
 	{
 		obj->pos.l.x.f.u = bound;
 		obj->pos.l.x.f.l = 0;
 		obj->xsp = 0;
 		obj->inertia = 0;
-	} 
+	}
 	
 	//Fall off the bottom boundary
-	if ((limit_btm2 + SCREEN_HEIGHT) < obj->pos.l.y.f.u)
+	if ((ram.limit_btm2 + SCREEN_HEIGHT) < obj->pos.l.y.f.u)
 	{
-		if (level_id == LEVEL_ID(ZoneId_SBZ, 1) && obj->pos.l.x.f.u >= 0x2000)
+		if (ram.level_id == LEVEL_ID(ZoneId_SBZ, 1) && obj->pos.l.x.f.u >= 0x2000)
 		{
 			//Go to SBZ3 if falling off at the end of SBZ2
-			last_lamp = 0;
-			restart = true;
-			level_id = LEVEL_ID(ZoneId_LZ, 3);
+			ram.last_lamp = 0;
+			ram.restart = true;
+			ram.level_id = LEVEL_ID(ZoneId_LZ, 3);
 		}
 		else
 		{
@@ -1376,7 +1336,7 @@ static void Sonic_RollLeft(Object *obj)
 	else
 	{
 		//Decelerate
-		if ((inertia -= sonspeed_dec >> 2) < 0)
+		if ((inertia -= ram.sonspeed_dec >> 2) < 0)
 			inertia = -0x80;
 		obj->inertia = inertia;
 	}
@@ -1394,7 +1354,7 @@ static void Sonic_RollRight(Object *obj)
 	else
 	{
 		//Decelerate
-		if ((inertia += sonspeed_dec >> 2) >= 0)
+		if ((inertia += ram.sonspeed_dec >> 2) >= 0)
 			inertia = 0x80;
 		obj->inertia = inertia;
 	}
@@ -1404,26 +1364,26 @@ static void Sonic_RollSpeed(Object *obj)
 {
 	Scratch_Sonic *scratch = (Scratch_Sonic*)&obj->scratch;
 	
-	if (!jump_only)
+	if (!ram.jump_only)
 	{
 		if (!scratch->control_lock)
 		{
 			//Move left and right according to held direction
-			if (jpad1_hold2 & JPAD_LEFT)
+			if (ram.jpad1_hold2 & JPAD_LEFT)
 				Sonic_RollLeft(obj);
-			if (jpad1_hold2 & JPAD_RIGHT)
+			if (ram.jpad1_hold2 & JPAD_RIGHT)
 				Sonic_RollRight(obj);
 		}
 		
 		//Friction
 		if (obj->inertia > 0)
 		{
-			if ((obj->inertia -= (sonspeed_acc >> 1)) < 0)
+			if ((obj->inertia -= (ram.sonspeed_acc >> 1)) < 0)
 				obj->inertia = 0;
 		}
 		else
 		{
-			if ((obj->inertia += (sonspeed_acc >> 1)) >= 0)
+			if ((obj->inertia += (ram.sonspeed_acc >> 1)) >= 0)
 				obj->inertia = 0;
 		}
 		
@@ -1490,7 +1450,7 @@ static void Sonic_JumpHeight(Object *obj)
 	{
 		//Get minimum jump speed and apply if ABC isn't held
 		int16_t spd = obj->status.p.f.underwater ? -0x200 : -0x400;
-		if (obj->ysp < spd && !(jpad1_hold2 & (JPAD_A | JPAD_C | JPAD_B)))
+		if (obj->ysp < spd && !(ram.jpad1_hold2 & (JPAD_A | JPAD_C | JPAD_B)))
 			obj->ysp = spd;
 	}
 	else
@@ -1509,19 +1469,19 @@ static void Sonic_JumpDirection(Object *obj)
 		int16_t xsp = obj->xsp;
 		
 		//Accelerate left
-		if (jpad1_hold2 & JPAD_LEFT)
+		if (ram.jpad1_hold2 & JPAD_LEFT)
 		{
 			obj->status.p.f.x_flip = true;
-			if ((xsp -= (sonspeed_acc << 1)) <= -sonspeed_max)
-				xsp = -sonspeed_max;
+			if ((xsp -= (ram.sonspeed_acc << 1)) <= -ram.sonspeed_max)
+				xsp = -ram.sonspeed_max;
 		}
 		
 		//Accelerate right
-		if (jpad1_hold2 & JPAD_RIGHT)
+		if (ram.jpad1_hold2 & JPAD_RIGHT)
 		{
 			obj->status.p.f.x_flip = false;
-			if ((xsp += (sonspeed_acc << 1)) >= sonspeed_max)
-				xsp = sonspeed_max;
+			if ((xsp += (ram.sonspeed_acc << 1)) >= ram.sonspeed_max)
+				xsp = ram.sonspeed_max;
 		}
 		
 		//Apply acceleration
@@ -1529,10 +1489,10 @@ static void Sonic_JumpDirection(Object *obj)
 	}
 	
 	//Reset screen shift
-	if (look_shift < (96 + SCREEN_TALLADD2))
-		look_shift += 2;
-	else if (look_shift > (96 + SCREEN_TALLADD2))
-		look_shift -= 2;
+	if (ram.look_shift < (96 + SCREEN_TALLADD2))
+		ram.look_shift += 2;
+	else if (ram.look_shift > (96 + SCREEN_TALLADD2))
+		ram.look_shift -= 2;
 	
 	//Handle air drag
 	if ((uint16_t)obj->ysp >= (uint16_t)-0x400)
@@ -1578,23 +1538,23 @@ static void Sonic_JumpAngle(Object *obj)
 static void Sonic_Loops(Object *obj)
 {
 	//Make sure we're in SLZ or GHZ
-	if (LEVEL_ZONE(level_id) != ZoneId_SLZ && LEVEL_ZONE(level_id) != ZoneId_GHZ)
+	if (LEVEL_ZONE(ram.level_id) != ZoneId_SLZ && LEVEL_ZONE(ram.level_id) != ZoneId_GHZ)
 		return;
 	
 	//Get chunk we're on
 	int16_t cx = (obj->pos.l.x.f.u >> 8) & 0x3F;
 	int16_t cy = (obj->pos.l.y.f.u >> 8) & 0x7;
-	uint8_t chunk = level_layout[cy][0][cx];
+	uint8_t chunk = ram.level_layout[cy][0][cx];
 	
 	//Handle S-tubes
-	if (chunk == level_schunks[1][0] || chunk == level_schunks[1][1])
+	if (chunk == ram.level_schunks[1][0] || chunk == ram.level_schunks[1][1])
 	{
 		Sonic_ChkRoll(obj);
 		return;
 	}
 	
 	//Handle loops
-	if (chunk == level_schunks[0][0])
+	if (chunk == ram.level_schunks[0][0])
 	{
 		CheckLoop:;
 		//Return to high plane if to the left
@@ -1623,7 +1583,7 @@ static void Sonic_Loops(Object *obj)
 				obj->render.f.player_loop = false;
 		}
 	}
-	else if (chunk == level_schunks[0][1])
+	else if (chunk == ram.level_schunks[0][1])
 	{
 		//Return to high plane if in mid-air
 		if (!obj->status.p.f.in_air)
@@ -1643,27 +1603,27 @@ static void GameOver(Object *obj)
 	Scratch_Sonic *scratch = (Scratch_Sonic*)&obj->scratch;
 	
 	//Have we fallen below the screen?
-	if ((limit_btm2 + 256 + SCREEN_TALLADD) >= obj->pos.l.y.f.u)
+	if ((ram.limit_btm2 + 256 + SCREEN_TALLADD) >= obj->pos.l.y.f.u)
 		return;
 	
 	//Enter respawn state
 	obj->ysp = -0x38; //???
 	obj->routine += 2;
-	time_count = false;
-	life_count++;
+	ram.time_count = false;
+	ram.life_count++;
 	
 	//Check if we've game over'ed
-	if (--lives == 0)
+	if (--ram.lives == 0)
 	{
 		//Set death timer
 		scratch->death_timer = 0;
 		
 		//Load 'GAME OVER' objects
-		objects[2].type = ObjId_GameOverCard; //GAME
-		objects[3].type = ObjId_GameOverCard; //OVER
-		objects[3].frame = 1;
+		ram.objects[2].type = ObjId_GameOverCard; //GAME
+		ram.objects[3].type = ObjId_GameOverCard; //OVER
+		ram.objects[3].frame = 1;
 		
-		time_over = false;
+		ram.time_over = false;
 		//music	bgm_GameOver,0,0,0	; play game over music //TODO
 		AddPLC(PlcId_GameOver);
 	}
@@ -1673,16 +1633,16 @@ static void GameOver(Object *obj)
 		scratch->death_timer = 60;
 		
 		//Check if we've time over'ed
-		if (time_over)
+		if (ram.time_over)
 		{
 			//Set death timer
 			scratch->death_timer = 0;
 			
 			//Load 'TIME OVER' objects
-			objects[2].type = ObjId_GameOverCard; //TIME
-			objects[3].type = ObjId_GameOverCard; //OVER
-			objects[2].frame = 2;
-			objects[3].frame = 3;
+			ram.objects[2].type = ObjId_GameOverCard; //TIME
+			ram.objects[3].type = ObjId_GameOverCard; //OVER
+			ram.objects[2].frame = 2;
+			ram.objects[3].frame = 3;
 			
 			//music	bgm_GameOver,0,0,0	; play game over music //TODO
 			AddPLC(PlcId_GameOver);
@@ -1696,7 +1656,7 @@ void Obj_Sonic(Object *obj)
 	Scratch_Sonic *scratch = (Scratch_Sonic*)&obj->scratch;
 	
 	//Run debug mode code while in debug mode
-	if (debug_use)
+	if (ram.debug_use)
 	{
 		//DebugMode();
 		return;
@@ -1749,10 +1709,10 @@ void Obj_Sonic(Object *obj)
 			},
 		};
 		
-		if ((jpad1_press1 & JPAD_START) && (jpad1_hold1 & JPAD_A))
+		if ((ram.jpad1_press1 & JPAD_START) && (ram.jpad1_hold1 & JPAD_A))
 		{
-			level_id = demo_loc[LEVEL_ZONE(level_id)][LEVEL_ACT(level_id)];
-			restart = true;
+			ram.level_id = demo_loc[LEVEL_ZONE(ram.level_id)][LEVEL_ACT(ram.level_id)];
+			ram.restart = true;
 		}
 	#endif
 	
@@ -1776,28 +1736,28 @@ void Obj_Sonic(Object *obj)
 			obj->render.f.align_fg = true;
 			
 			//Initialize speeds
-			sonspeed_max = 0x600;
-			sonspeed_acc = 0xC;
-			sonspeed_dec = 0x80;
+			ram.sonspeed_max = 0x600;
+			ram.sonspeed_acc = 0xC;
+			ram.sonspeed_dec = 0x80;
 	//Fallthrough
 		case 2: //Regular movement
 			//Enter debug mode
-			if (debug_cheat && (jpad1_press1 & JPAD_B))
+			if (ram.debug_cheat && (ram.jpad1_press1 & JPAD_B))
 			{
-				debug_use = true;
-				lock_ctrl = false;
+				ram.debug_use = true;
+				ram.lock_ctrl = false;
 				break;
 			}
 			
 			//Copy player controls if not locked
-			if (!lock_ctrl)
+			if (!ram.lock_ctrl)
 			{
-				jpad1_hold2  = jpad1_hold1;
-				jpad1_press2 = jpad1_press1;
+				ram.jpad1_hold2  = ram.jpad1_hold1;
+				ram.jpad1_press2 = ram.jpad1_press1;
 			}
 			
 			//Run player routine
-			if (!(lock_multi & 1))
+			if (!(ram.lock_multi & 1))
 			{
 				switch ((obj->status.p.f.in_ball << 2) | (obj->status.p.f.in_air << 1))
 				{
@@ -1851,11 +1811,11 @@ void Obj_Sonic(Object *obj)
 			//Sonic_Water(obj); //TODO
 			
 			//Copy angle buffers
-			scratch->front_angle = angle_buffer0;
-			scratch->back_angle  = angle_buffer1;
+			scratch->front_angle = ram.angle_buffer[0];
+			scratch->back_angle  = ram.angle_buffer[1];
 			
 			//Animate
-			if (tunnel_mode)
+			if (ram.tunnel_mode)
 			{
 				if (!obj->anim)
 					obj->prev_anim = obj->anim;
@@ -1863,7 +1823,7 @@ void Obj_Sonic(Object *obj)
 			Sonic_Animate(obj);
 			
 			//Handle object and loop interaction
-			if (!(lock_multi & 0x80))
+			if (!(ram.lock_multi & 0x80))
 				ReactToItem(obj);
 			Sonic_Loops(obj);
 			
@@ -1909,7 +1869,7 @@ void Obj_Sonic(Object *obj)
 		case 8: //Dead, respawning
 			//Handle death timer
 			if (scratch->death_timer && --scratch->death_timer == 0)
-				restart = true;
+				ram.restart = true;
 			break;
 	}
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Object.h"
+#include "RAM.h"
 
 #include <stdint.h>
 #include "Types.h"
@@ -12,8 +13,6 @@
 #define SONIC_BALL_HEIGHT 14
 #define SONIC_BALL_SHIFT  5
 
-#define SONIC_DPLC_SIZE 0x2E0
-
 //Sonic assets
 extern const uint8_t map_sonic[];
 extern const uint8_t anim_sonic[];
@@ -39,15 +38,6 @@ typedef struct
 	uint16_t control_lock;       //0x3E
 } Scratch_Sonic;
 
-//Sonic globals
-extern int16_t sonspeed_max, sonspeed_acc, sonspeed_dec;
-
-extern uint8_t sonframe_num, sonframe_chg;
-extern uint8_t sgfx_buffer[SONIC_DPLC_SIZE];
-
-extern int16_t track_sonic[0x40][2];
-extern word_u track_pos;
-
 //Sonic types
 typedef enum
 {
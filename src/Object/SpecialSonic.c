@@ -20,9 +20,9 @@ typedef struct
 static void SpecialSonic_FixCamera(Object *obj)
 {
 	if ((uint16_t)obj->pos.l.x.f.u >= (SCREEN_WIDTH >> 1))
-		scrpos_x.f.u = obj->pos.l.x.f.u - (SCREEN_WIDTH >> 1);
+		ram.scrpos_x.f.u = obj->pos.l.x.f.u - (SCREEN_WIDTH >> 1);
 	if ((uint16_t)obj->pos.l.x.f.u >= (SCREEN_HEIGHT >> 1))
-		scrpos_y.f.u = obj->pos.l.y.f.u - (SCREEN_HEIGHT >> 1);
+		ram.scrpos_y.f.u = obj->pos.l.y.f.u - (SCREEN_HEIGHT >> 1);
 }
 
 static void SpecialSonic_Display(Object *obj)
@@ -32,7 +32,7 @@ static void SpecialSonic_Display(Object *obj)
 	SpecialSonic_FixCamera(obj);
 	
 	//Rotate stage
-	ss_angle.v += ss_rotate;
+	ram.ss_angle.v += ram.ss_rotate;
 	
 	//Animate object
 	Sonic_Animate(obj);
@@ -58,7 +58,7 @@ static void SpecialSonic_ChkTile(Object *obj, uint8_t block, uint8_t *addr, int
 static int SpecialSonic_ChkPos(Object *obj, int32_t x, int32_t y)
 {
 	//Get stage layout position
-	const uint8_t *layout = ss_layout;
+	const uint8_t *layout = ram.ss_layout;
 	layout += (((uint16_t)(y >> 16) + 0x44) / 24) * SS_DIM;
 	layout += (((uint16_t)(x >> 16) + 0x14) / 24);
 	
@@ -76,12 +76,12 @@ static int SpecialSonic_ChkPos(Object *obj, int32_t x, int32_t y)
 static void SpecialSonic_Jump(Object *obj)
 {
 	//Don't jump if ABC isn't pressed
-	if (!(jpad1_press2 & (JPAD_A | JPAD_C | JPAD_B)))
+	if (!(ram.jpad1_press2 & (JPAD_A | JPAD_C | JPAD_B)))
 		return;
 	
 	//Get jump speed
 	int16_t sin, cos;
-	CalcSine(-(ss_angle.f.u & 0xFC) - 0x40, &sin, &cos);
+	CalcSine(-(ram.ss_angle.f.u & 0xFC) - 0x40, &sin, &cos);
 	obj->xsp = (cos * 0x680) >> 8;
 	obj->ysp = (sin * 0x680) >> 8;
 	
@@ -102,7 +102,7 @@ static void SpecialSonic_Fall(Object *obj)
 	
 	//Get next move delta
 	int16_t sin, cos;
-	CalcSine(ss_angle.f.u & 0xFC, &sin, &cos);
+	CalcSine(ram.ss_angle.f.u & 0xFC, &sin, &cos);
 	
 	int32_t xa = (sin * 0x2A) + ((int32_t)obj->xsp << 8);
 	int32_t ya = (cos * 0x2A) + ((int32_t)obj->ysp << 8);
@@ -194,13 +194,13 @@ static void SpecialSonic_MoveRight(Object *obj)
 static void SpecialSonic_Move(Object *obj)
 {
 	//Move left and right according to held direction
-	if (jpad1_hold2 & JPAD_LEFT)
+	if (ram.jpad1_hold2 & JPAD_LEFT)
 		SpecialSonic_MoveLeft(obj);
-	if (jpad1_hold2 & JPAD_RIGHT)
+	if (ram.jpad1_hold2 & JPAD_RIGHT)
 		SpecialSonic_MoveRight(obj);
 	
 	//Friction
-	if (!(jpad1_hold2 & (JPAD_LEFT | JPAD_RIGHT)))
+	if (!(ram.jpad1_hold2 & (JPAD_LEFT | JPAD_RIGHT)))
 	{
 		if (obj->inertia > 0)
 		{
@@ -217,7 +217,7 @@ static void SpecialSonic_Move(Object *obj)
 	//Apply inertia
 	int16_t sin, cos;
 	int32_t xa, ya;
-	CalcSine(-((ss_angle.f.u + 0x20) & 0xC0), &sin, &cos);
+	CalcSine(-((ram.ss_angle.f.u + 0x20) & 0xC0), &sin, &cos);
 	xa = cos * obj->inertia;
 	ya = sin * obj->inertia;
 	
@@ -264,8 +264,8 @@ void Obj_SpecialSonic(Object *obj)
 	//Fallthrough
 		case 2: //Moving
 			//Enter debug mode
-			if (debug_cheat && (jpad1_press1 & JPAD_B))
-				debug_use = true;
+			if (ram.debug_cheat && (ram.jpad1_press1 & JPAD_B))
+				ram.debug_use = true;
 			
 			//Run player routine
 			scratch->hit_block = 0;
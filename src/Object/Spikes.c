@@ -35,7 +35,7 @@ static const uint8_t spike_set[][2] = {
 static void Spike_Hurt(Object *obj)
 {
 	//Check if player can be hurt
-	if (invincibility)
+	if (ram.invincibility)
 		return;
 	if (player->routine >= 4)
 		return;
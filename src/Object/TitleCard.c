@@ -57,12 +57,12 @@ void Obj_TitleCard(Object *obj)
 			Object *a1 = obj;
 			
 			//Get title card to render
-			uint8_t d0 = LEVEL_ZONE(level_id);
-			if (level_id == LEVEL_ID(ZoneId_LZ, 3))
+			uint8_t d0 = LEVEL_ZONE(ram.level_id);
+			if (ram.level_id == LEVEL_ID(ZoneId_LZ, 3))
 				d0 = 5;
 			
 			uint16_t d2 = d0;
-			if (level_id == LEVEL_ID(ZoneId_SBZ, 2))
+			if (ram.level_id == LEVEL_ID(ZoneId_SBZ, 2))
 			{
 				d0 = 6;
 				d2 = 11;
@@ -89,8 +89,8 @@ void Obj_TitleCard(Object *obj)
 				//Initialize object graphics
 				if (d0 == 7)
 				{
-					d0 += LEVEL_ACT(level_id);
-					if (LEVEL_ACT(level_id) == 3)
+					d0 += LEVEL_ACT(ram.level_id);
+					if (LEVEL_ACT(ram.level_id) == 3)
 						d0--;
 				}
 				
@@ -131,7 +131,7 @@ void Obj_TitleCard(Object *obj)
 				if (obj->routine == 4)
 				{
 					AddPLC(PlcId_Explode);
-					AddPLC(PlcId_GHZAnimals + LEVEL_ZONE(level_id));
+					AddPLC(PlcId_GHZAnimals + LEVEL_ZONE(ram.level_id));
 				}
 				ObjectDelete(obj);
 				break;
@@ -3,14 +3,18 @@
 #include "PLC.h"
 
 #include "Nemesis.h"
+#include "DecCache.h"
 
 #include "Backend/VDP.h"
+#include "Backend/Thread.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 //PLC constants
 #define PLC_SPEED_1 9 //How many tiles are loaded per frame during a 'loading' state
 #define PLC_SPEED_2 3 //How many tiles are loaded per frame while the game's running
+#define PLC_ASYNC_TILES 0x200 //How many tiles are loaded per frame with plc_async (0x4000 bytes)
 
 //Level art
 const uint8_t art_ghz1[] = {
@@ -549,14 +553,112 @@ static const PLCList *plcs[PlcId_Num] = {
 	/* PlcId_FZBoss      */ NULL,
 };
 
-//PLC state
-PLC plc_buffer[16];
+//PLC staging
+//With plc_async set, art is decompressed on a worker thread as soon as its PLC is queued, then copied to VRAM PLC_ASYNC_TILES at a time
+//Staged art is kept until the next game mode clears the PLCs, as savestates from the current one can point into it
+#define PLC_STAGES 0x80
 
-static NemesisState plc_buffer_regs;
-static uint16_t plc_buffer_reg18;
-static uint16_t plc_buffer_reg1A;
+typedef struct
+{
+	const uint8_t *art;
+	const uint8_t *data; //Decompressed art
+	size_t size;
+	ThreadJob *job; //Worker job, until it's been waited for
+} PLCStage;
+
+bool plc_async;
+
+static PLCStage plc_stages[PLC_STAGES];
+
+static void PLCStage_Work(void *arg)
+{
+	PLCStage *stage = (PLCStage*)arg;
+	uint8_t dictionary[0x200];
+	NemDecToBuffer(stage->art, (uint8_t*)stage->data, dictionary);
+}
+
+static PLCStage *PLCStage_Start(const uint8_t *art)
+{
+	//Find art that's already been started
+	size_t i = 0;
+	for (; i < PLC_STAGES && plc_stages[i].art != NULL; i++)
+		if (plc_stages[i].art == art)
+			return &plc_stages[i];
+	if (i == PLC_STAGES)
+		return NULL;
+	
+	PLCStage *stage = &plc_stages[i];
+	
+	//Raw art is used as is
+	size_t raw_size = NemRawSize(art);
+	if (raw_size != 0)
+	{
+		stage->art = art;
+		stage->data = art + 6;
+		stage->size = raw_size;
+		stage->job = NULL;
+		return stage;
+	}
+	
+	//Start decompressing on a worker
+	size_t size = ((((art[0] << 8) | art[1]) << 3) & 0xFFFF) * 4;
+	uint8_t *data = malloc(size);
+	if (data == NULL)
+		return NULL;
+	
+	stage->art = art;
+	stage->data = data;
+	stage->size = size;
+	stage->job = Thread_StartJob(PLCStage_Work, stage);
+	return stage;
+}
+
+static const PLCStage *PLCStage_Get(const uint8_t *art)
+{
+	//Wait for the art to be decompressed
+	PLCStage *stage = PLCStage_Start(art);
+	if (stage != NULL && stage->job != NULL)
+	{
+		Thread_WaitJob(stage->job);
+		stage->job = NULL;
+	}
+	return stage;
+}
+
+static void PLCStage_StartList(const PLCList *list)
+{
+	if (!plc_async)
+		return;
+	for (size_t i = 0; i < list->plcs; i++)
+		PLCStage_Start(list->plc[i].art);
+}
+
+static void PLCStage_FreeAll()
+{
+	//Wait for workers and free the decompressed art
+	for (size_t i = 0; i < PLC_STAGES && plc_stages[i].art != NULL; i++)
+	{
+		PLCStage *stage = &plc_stages[i];
+		if (stage->job != NULL)
+			Thread_WaitJob(stage->job);
+		if (stage->data != stage->art + 6) //Raw art is used as is
+			free((uint8_t*)stage->data);
+		stage->art = NULL;
+		stage->data = NULL;
+		stage->job = NULL;
+	}
+}
 
 //PLC interface
+const uint8_t *PLC_GetArt(PlcId plc, size_t i)
+{
+	//Get the i-th art of a PLC list
+	const PLCList *list = plcs[plc];
+	if (list == NULL || i >= list->plcs)
+		return NULL;
+	return list->plc[i].art;
+}
+
 void AddPLC(PlcId plc)
 {
 	//Get PLC list to load
@@ -565,13 +667,14 @@ void AddPLC(PlcId plc)
 		return;
 	
 	//Find empty PLC slot
-	PLC *plc_free = plc_buffer;
+	PLC *plc_free = ram.plc_buffer;
 	while (plc_free->art != NULL)
 		plc_free++;
 	
 	//Push PLCs to buffer
 	for (size_t i = 0; i < list->plcs; i++)
 		plc_free[i] = list->plc[i];
+	PLCStage_StartList(list);
 }
 
 void NewPLC(PlcId plc)
@@ -581,44 +684,72 @@ void NewPLC(PlcId plc)
 	if (list == NULL)
 		return;
 	
-	//Clear previous PLCs
-	ClearPLC();
+	//Clear previous PLCs (the staged art is kept, the previous PLCs may have staged the same art)
+	ram.plc_buffer_reg18 = 0;
+	memset(ram.plc_buffer, 0, sizeof(ram.plc_buffer));
 	
 	//Push PLCs to buffer
 	for (size_t i = 0; i < list->plcs; i++)
-		plc_buffer[i] = list->plc[i];
+		ram.plc_buffer[i] = list->plc[i];
+	PLCStage_StartList(list);
 }
 
 void ClearPLC()
 {
 	//Clear PLC buffer
-	plc_buffer_reg18 = 0;
-	memset(plc_buffer, 0, sizeof(plc_buffer));
+	ram.plc_buffer_reg18 = 0;
+	memset(ram.plc_buffer, 0, sizeof(ram.plc_buffer));
+	
+	//Free the art staged by the last game mode (game modes clear the PLCs as they start)
+	PLCStage_FreeAll();
 }
 
 void RunPLC()
 {
-	if (plc_buffer[0].art != NULL && plc_buffer_reg18 == 0)
+	if (ram.plc_buffer[0].art != NULL && ram.plc_buffer_reg18 == 0)
 	{
-		plc_buffer_regs.source = plc_buffer[0].art;
-		plc_buffer_regs.vram_mode = true;
-		plc_buffer_regs.dictionary = nemesis_buffer;
+		ram.plc_buffer_regs.source = ram.plc_buffer[0].art;
+		ram.plc_buffer_regs.vram_mode = true;
+		ram.plc_buffer_regs.dictionary = ram.nemesis_buffer;
 		
-		uint16_t header = (plc_buffer_regs.source[0] << 8) | plc_buffer_regs.source[1];
+		#ifdef SCP_VERIFY_DECOMPRESSION
+			NemDecVerify(ram.plc_buffer_regs.source);
+		#endif
 		
-		plc_buffer_regs.source += 2;
-		plc_buffer_regs.xor_mode = header & 0x8000;
-		plc_buffer_reg18 = header & 0x7FFF;
+		//Copy the art the worker decompressed, like raw art
+		const PLCStage *stage = plc_async ? PLCStage_Get(ram.plc_buffer_regs.source) : NULL;
+		if (stage != NULL)
+		{
+			ram.plc_buffer_regs.source = stage->data;
+			ram.plc_buffer_regs.raw_mode = true;
+			ram.plc_buffer_reg18 = stage->size / 0x20;
+			return;
+		}
+		
+		size_t raw_size = NemRawSize(ram.plc_buffer_regs.source);
+		if ((ram.plc_buffer_regs.raw_mode = (raw_size != 0)))
+		{
+			//Raw art is copied PLC_SPEED tiles at a time, just like it would've been decompressed
+			ram.plc_buffer_regs.source += 6;
+			ram.plc_buffer_reg18 = raw_size / 0x20;
+			return;
+		}
+		
+		uint16_t header = (ram.plc_buffer_regs.source[0] << 8) | ram.plc_buffer_regs.source[1];
+		
+		ram.plc_buffer_regs.source += 2;
+		ram.plc_buffer_regs.xor_mode = header & 0x8000;
+		ram.plc_buffer_reg18 = header & 0x7FFF;
 		
-		NemDecPrepare(&plc_buffer_regs);
+		NemDecPrepare(&ram.plc_buffer_regs);
 		
-		plc_buffer_regs.d5 = (plc_buffer_regs.source[0] << 8) | plc_buffer_regs.source[1];
-		plc_buffer_regs.source += 2;
+		ram.plc_buffer_regs.d5 = (ram.plc_buffer_regs.source[0] << 8) | ram.plc_buffer_regs.source[1];
+		ram.plc_buffer_regs.source += 2;
 		
-		plc_buffer_regs.d0 = 0;
-		plc_buffer_regs.d1 = 0;
-		plc_buffer_regs.d2 = 0;
-		plc_buffer_regs.d6 = 0x10;
+		ram.plc_buffer_regs.d0 = 0;
+		ram.plc_buffer_regs.d1 = 0;
+		ram.plc_buffer_regs.d2 = 0;
+		ram.plc_buffer_regs.d6 = 0x10;
 	}
 }
 
@@ -628,32 +759,38 @@ static void ProcessDPLC_Main(size_t off)
 	
 	do
 	{
-		plc_buffer_regs.remaining = 8;
+		ram.plc_buffer_regs.remaining = 8;
 		
 		//Inlined NemDec_WriteIter
-		plc_buffer_regs.d3 = 8;
-		plc_buffer_regs.d4 = 0;
+		ram.plc_buffer_regs.d3 = 8;
+		ram.plc_buffer_regs.d4 = 0;
 		
-		NemDecRun(&plc_buffer_regs);
+		NemDecRun(&ram.plc_buffer_regs);
 		
-		if (--plc_buffer_reg18 == 0)
+		if (--ram.plc_buffer_reg18 == 0)
 		{
 			//Pop one request off the buffer so that the next one can be filled
-			for (size_t i = 0; i < sizeof(plc_buffer) / sizeof(*plc_buffer) - 1; i++)
-				plc_buffer[i] = plc_buffer[i + 1];
+			for (size_t i = 0; i < sizeof(ram.plc_buffer) / sizeof(*ram.plc_buffer) - 1; i++)
+				ram.plc_buffer[i] = ram.plc_buffer[i + 1];
 			return;
 		}
-	} while (--plc_buffer_reg1A != 0);
+	} while (--ram.plc_buffer_reg1A != 0);
+}
+
+static uint16_t PLC_Speed(uint16_t speed)
+{
+	//Art from workers is copied as fast as the budget allows
+	return (plc_async && ram.plc_buffer_regs.raw_mode) ? PLC_ASYNC_TILES : speed;
 }
 
 void ProcessDPLC()
 {
-	if (plc_buffer_reg18 != 0)
+	if (ram.plc_buffer_reg18 != 0)
 	{
-		plc_buffer_reg1A = PLC_SPEED_1; //Process PLC_SPEED_1 tiles
+		ram.plc_buffer_reg1A = PLC_Speed(PLC_SPEED_1); //Process PLC_SPEED_1 tiles
 		
-		size_t off = plc_buffer[0].off;
-		plc_buffer[0].off += PLC_SPEED_1 * 0x20;
+		size_t off = ram.plc_buffer[0].off;
+		ram.plc_buffer[0].off += ram.plc_buffer_reg1A * 0x20;
 		
 		ProcessDPLC_Main(off);
 	}
@@ -661,12 +798,12 @@ void ProcessDPLC()
 
 void ProcessDPLC2()
 {
-	if (plc_buffer_reg18 != 0)
+	if (ram.plc_buffer_reg18 != 0)
 	{
-		plc_buffer_reg1A = PLC_SPEED_2; //Process PLC_SPEED_2 tiles
+		ram.plc_buffer_reg1A = PLC_Speed(PLC_SPEED_2); //Process PLC_SPEED_2 tiles
 		
-		size_t off = plc_buffer[0].off;
-		plc_buffer[0].off += PLC_SPEED_2 * 0x20;
+		size_t off = ram.plc_buffer[0].off;
+		ram.plc_buffer[0].off += ram.plc_buffer_reg1A * 0x20;
 		
 		ProcessDPLC_Main(off);
 	}
@@ -681,6 +818,6 @@ void QuickPLC(PlcId plc)
 	for (size_t i = 0; i < list->plcs; i++)
 	{
 		VDP_SeekVRAM(list->plc[i].off);
-		NemDec(list->plc[i].art);
+		NemDecCached(list->plc[i].art);
 	}
 }
@@ -1,18 +1,12 @@
 #pragma once
 
+#include "Nemesis.h"
+#include "RAM.h"
+
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 
-//PLC structure
-typedef struct
-{
-	const uint8_t *art;
-	size_t off;
-} PLC;
-
-//PLC buffer
-extern PLC plc_buffer[16];
-
 //PLC IDs
 typedef enum
 {
@@ -60,7 +54,11 @@ extern const uint8_t art_slz[];
 extern const uint8_t art_syz[];
 extern const uint8_t art_sbz[];
 
+//PLC globals
+extern bool plc_async;
+
 //PLC interface
+const uint8_t *PLC_GetArt(PlcId plc, size_t i);
 void AddPLC(PlcId plc);
 void NewPLC(PlcId plc);
 void ClearPLC();
@@ -7,16 +7,6 @@
 
 #include <stdlib.h>
 
-//Palette state
-int16_t pal_chgspeed;
-
-uint16_t dry_palette[4][16];
-uint16_t dry_palette_dup[4][16];
-uint16_t wet_palette[4][16];
-uint16_t wet_palette_dup[4][16];
-
-PaletteFade palette_fade;
-
 //Palettes
 static ALIGNED2 const uint8_t pal_sega_bg[] = {
 	#include "Resource/Palette/SegaBG.h"
@@ -85,26 +75,26 @@ static struct PalettePointer
 	uint16_t *target;
 	size_t colours;
 } palette_pointers[] = {
-	/* PalId_SegaBG    */ {(const uint16_t*)pal_sega_bg,    &dry_palette[0][0], 0x40},
-	/* PalId_Title     */ {(const uint16_t*)pal_title,      &dry_palette[0][0], 0x40},
-	/* PalId_LevelSel  */ {(const uint16_t*)pal_level_sel,  &dry_palette[0][0], 0x40},
-	/* PalId_Sonic     */ {(const uint16_t*)pal_sonic,      &dry_palette[0][0], 0x10},
-	/* PalId_GHZ       */ {(const uint16_t*)pal_ghz,        &dry_palette[1][0], 0x30},
-	/* PalId_LZ        */ {(const uint16_t*)pal_lz,         &dry_palette[1][0], 0x30},
-	/* PalId_MZ        */ {(const uint16_t*)pal_mz,         &dry_palette[1][0], 0x30},
-	/* PalId_SYZ       */ {(const uint16_t*)pal_syz,        &dry_palette[1][0], 0x30},
-	/* PalId_SLZ       */ {(const uint16_t*)pal_slz,        &dry_palette[1][0], 0x30},
-	/* PalId_SBZ1      */ {(const uint16_t*)pal_sbz1,       &dry_palette[1][0], 0x30},
-	/* PalId_Special   */ {(const uint16_t*)pal_special,    &dry_palette[0][0], 0x40},
-	/* PalId_LZWater   */ {(const uint16_t*)pal_lz_water,   &dry_palette[0][0], 0x40},
-	/* PalId_SBZ3      */ {(const uint16_t*)pal_sbz3,       &dry_palette[1][0], 0x30},
-	/* PalId_SBZ3Water */ {(const uint16_t*)pal_sbz3_water, &dry_palette[0][0], 0x40},
-	/* PalId_SBZ2      */ {(const uint16_t*)pal_sbz2,       &dry_palette[1][0], 0x30},
-	/* PalId_SonicLZ   */ {(const uint16_t*)pal_sonic_lz,   &dry_palette[0][0], 0x10},
-	/* PalId_SonicSBZ  */ {(const uint16_t*)pal_sonic_sbz,  &dry_palette[0][0], 0x10},
-	/* PalId_SSResults */ {(const uint16_t*)pal_ss_results, &dry_palette[0][0], 0x40},
-	/* PalId_Continue  */ {(const uint16_t*)pal_continue,   &dry_palette[0][0], 0x20},
-	/* PalId_Ending    */ {(const uint16_t*)pal_ending,     &dry_palette[0][0], 0x40},
+	/* PalId_SegaBG    */ {(const uint16_t*)pal_sega_bg,    &ram.dry_palette[0][0], 0x40},
+	/* PalId_Title     */ {(const uint16_t*)pal_title,      &ram.dry_palette[0][0], 0x40},
+	/* PalId_LevelSel  */ {(const uint16_t*)pal_level_sel,  &ram.dry_palette[0][0], 0x40},
+	/* PalId_Sonic     */ {(const uint16_t*)pal_sonic,      &ram.dry_palette[0][0], 0x10},
+	/* PalId_GHZ       */ {(const uint16_t*)pal_ghz,        &ram.dry_palette[1][0], 0x30},
+	/* PalId_LZ        */ {(const uint16_t*)pal_lz,         &ram.dry_palette[1][0], 0x30},
+	/* PalId_MZ        */ {(const uint16_t*)pal_mz,         &ram.dry_palette[1][0], 0x30},
+	/* PalId_SYZ       */ {(const uint16_t*)pal_syz,        &ram.dry_palette[1][0], 0x30},
+	/* PalId_SLZ       */ {(const uint16_t*)pal_slz,        &ram.dry_palette[1][0], 0x30},
+	/* PalId_SBZ1      */ {(const uint16_t*)pal_sbz1,       &ram.dry_palette[1][0], 0x30},
+	/* PalId_Special   */ {(const uint16_t*)pal_special,    &ram.dry_palette[0][0], 0x40},
+	/* PalId_LZWater   */ {(const uint16_t*)pal_lz_water,   &ram.dry_palette[0][0], 0x40},
+	/* PalId_SBZ3      */ {(const uint16_t*)pal_sbz3,       &ram.dry_palette[1][0], 0x30},
+	/* PalId_SBZ3Water */ {(const uint16_t*)pal_sbz3_water, &ram.dry_palette[0][0], 0x40},
+	/* PalId_SBZ2      */ {(const uint16_t*)pal_sbz2,       &ram.dry_palette[1][0], 0x30},
+	/* PalId_SonicLZ   */ {(const uint16_t*)pal_sonic_lz,   &ram.dry_palette[0][0], 0x10},
+	/* PalId_SonicSBZ  */ {(const uint16_t*)pal_sonic_sbz,  &ram.dry_palette[0][0], 0x10},
+	/* PalId_SSResults */ {(const uint16_t*)pal_ss_results, &ram.dry_palette[0][0], 0x40},
+	/* PalId_Continue  */ {(const uint16_t*)pal_continue,   &ram.dry_palette[0][0], 0x20},
+	/* PalId_Ending    */ {(const uint16_t*)pal_ending,     &ram.dry_palette[0][0], 0x40},
 };
 
 //Palette interface
@@ -113,7 +103,7 @@ void PalLoad1(PaletteId id)
 	//Load given palette
 	struct PalettePointer *palload = &palette_pointers[id];
 	const uint16_t *inp = palload->palette;
-	uint16_t *outp = &dry_palette_dup[0][0] + (palload->target - &dry_palette[0][0]);
+	uint16_t *outp = &ram.dry_palette_dup[0][0] + (palload->target - &ram.dry_palette[0][0]);
 	
 	for (size_t i = 0; i < palload->colours; i++, inp++)
 		*outp++ = LESWAP_16(*inp);
@@ -135,7 +125,7 @@ void PalLoad3_Water(PaletteId id)
 	//Load given palette
 	struct PalettePointer *palload = &palette_pointers[id];
 	const uint16_t *inp = palload->palette;
-	uint16_t *outp = &wet_palette[0][0] + (palload->target - &dry_palette[0][0]);
+	uint16_t *outp = &ram.wet_palette[0][0] + (palload->target - &ram.dry_palette[0][0]);
 	
 	for (size_t i = 0; i < palload->colours; i++, inp++)
 		*outp++ = LESWAP_16(*inp);
@@ -146,7 +136,7 @@ void PalLoad4_Water(PaletteId id)
 	//Load given palette
 	struct PalettePointer *palload = &palette_pointers[id];
 	const uint16_t *inp = palload->palette;
-	uint16_t *outp = &wet_palette_dup[0][0] + (palload->target - &dry_palette[0][0]);
+	uint16_t *outp = &ram.wet_palette_dup[0][0] + (palload->target - &ram.dry_palette[0][0]);
 	
 	for (size_t i = 0; i < palload->colours; i++, inp++)
 		*outp++ = LESWAP_16(*inp);
@@ -172,15 +162,15 @@ void FadeIn_FromBlack()
 	uint16_t *col, *ref;
 	
 	//Fade dry palette
-	col = (&dry_palette[0][0]) + palette_fade.ind;
-	ref = (&dry_palette_dup[0][0]) + palette_fade.ind;
-	for (int i = 0; i < palette_fade.len; i++)
+	col = (&ram.dry_palette[0][0]) + ram.palette_fade.ind;
+	ref = (&ram.dry_palette_dup[0][0]) + ram.palette_fade.ind;
+	for (int i = 0; i < ram.palette_fade.len; i++)
 		FadeIn_AddColour(col++, *ref++);
 	
 	//Fade wet palette
-	col = (&wet_palette[0][0]) + palette_fade.ind;
-	ref = (&wet_palette_dup[0][0]) + palette_fade.ind;
-	for (int i = 0; i < palette_fade.len; i++)
+	col = (&ram.wet_palette[0][0]) + ram.palette_fade.ind;
+	ref = (&ram.wet_palette_dup[0][0]) + ram.palette_fade.ind;
+	for (int i = 0; i < ram.palette_fade.len; i++)
 		FadeIn_AddColour(col++, *ref++);
 }
 
@@ -192,18 +182,18 @@ void PaletteFadeIn()
 void PaletteFadeIn_At(uint8_t ind, uint8_t len)
 {
 	//Initialize fade
-	palette_fade.ind = ind;
-	palette_fade.len = len;
+	ram.palette_fade.ind = ind;
+	ram.palette_fade.len = len;
 	
 	//Fill palette with black
-	uint16_t *col = (&dry_palette[0][0]) + palette_fade.ind;
-	for (int i = 0; i < palette_fade.len; i++)
+	uint16_t *col = (&ram.dry_palette[0][0]) + ram.palette_fade.ind;
+	for (int i = 0; i < ram.palette_fade.len; i++)
 		*col++ = 0x000;
 	
 	//Fade for 22 frames
 	for (int i = 0; i < 22; i++)
 	{
-		vbla_routine = 0x12;
+		ram.vbla_routine = 0x12;
 		WaitForVBla();
 		FadeIn_FromBlack();
 		RunPLC();
@@ -230,13 +220,13 @@ void FadeOut_ToBlack()
 	uint16_t *col;
 	
 	//Fade dry palette
-	col = (&dry_palette[0][0]) + palette_fade.ind;
-	for (int i = 0; i < palette_fade.len; i++)
+	col = (&ram.dry_palette[0][0]) + ram.palette_fade.ind;
+	for (int i = 0; i < ram.palette_fade.len; i++)
 		FadeOut_DecColour(col++);
 	
 	//Fade wet palette
-	col = (&wet_palette[0][0]) + palette_fade.ind;
-	for (int i = 0; i < palette_fade.len; i++)
+	col = (&ram.wet_palette[0][0]) + ram.palette_fade.ind;
+	for (int i = 0; i < ram.palette_fade.len; i++)
 		FadeOut_DecColour(col++);
 }
 
@@ -248,13 +238,13 @@ void PaletteFadeOut()
 void PaletteFadeOut_At(uint8_t ind, uint8_t len)
 {
 	//Initialize fade
-	palette_fade.ind = ind;
-	palette_fade.len = len;
+	ram.palette_fade.ind = ind;
+	ram.palette_fade.len = len;
 	
 	//Fade for 22 frames
 	for (int i = 0; i < 22; i++)
 	{
-		vbla_routine = 0x12;
+		ram.vbla_routine = 0x12;
 		WaitForVBla();
 		FadeOut_ToBlack();
 		RunPLC();
@@ -281,15 +271,15 @@ void WhiteIn_FromWhite()
 	uint16_t *col, *ref;
 	
 	//White dry palette
-	col = (&dry_palette[0][0]) + palette_fade.ind;
-	ref = (&dry_palette_dup[0][0]) + palette_fade.ind;
-	for (int i = 0; i < palette_fade.len; i++)
+	col = (&ram.dry_palette[0][0]) + ram.palette_fade.ind;
+	ref = (&ram.dry_palette_dup[0][0]) + ram.palette_fade.ind;
+	for (int i = 0; i < ram.palette_fade.len; i++)
 		WhiteIn_DecColour(col++, *ref++);
 	
 	//White wet palette
-	col = (&wet_palette[0][0]) + palette_fade.ind;
-	ref = (&wet_palette_dup[0][0]) + palette_fade.ind;
-	for (int i = 0; i < palette_fade.len; i++)
+	col = (&ram.wet_palette[0][0]) + ram.palette_fade.ind;
+	ref = (&ram.wet_palette_dup[0][0]) + ram.palette_fade.ind;
+	for (int i = 0; i < ram.palette_fade.len; i++)
 		WhiteIn_DecColour(col++, *ref++);
 }
 
@@ -301,13 +291,13 @@ void PaletteWhiteIn()
 void PaletteWhiteIn_At(uint8_t ind, uint8_t len)
 {
 	//Initialize fade
-	palette_fade.ind = ind;
-	palette_fade.len = len;
+	ram.palette_fade.ind = ind;
+	ram.palette_fade.len = len;
 	
 	//White for 22 frames
 	for (int i = 0; i < 22; i++)
 	{
-		vbla_routine = 0x12;
+		ram.vbla_routine = 0x12;
 		WaitForVBla();
 		WhiteIn_FromWhite();
 		RunPLC();
@@ -334,13 +324,13 @@ void WhiteOut_ToWhite()
 	uint16_t *col;
 	
 	//White dry palette
-	col = (&dry_palette[0][0]) + palette_fade.ind;
-	for (int i = 0; i < palette_fade.len; i++)
+	col = (&ram.dry_palette[0][0]) + ram.palette_fade.ind;
+	for (int i = 0; i < ram.palette_fade.len; i++)
 		WhiteOut_IncColour(col++);
 	
 	//White wet palette
-	col = (&wet_palette[0][0]) + palette_fade.ind;
-	for (int i = 0; i < palette_fade.len; i++)
+	col = (&ram.wet_palette[0][0]) + ram.palette_fade.ind;
+	for (int i = 0; i < ram.palette_fade.len; i++)
 		WhiteOut_IncColour(col++);
 }
 
@@ -352,13 +342,13 @@ void PaletteWhiteOut()
 void PaletteWhiteOut_At(uint8_t ind, uint8_t len)
 {
 	//Initialize fade
-	palette_fade.ind = ind;
-	palette_fade.len = len;
+	ram.palette_fade.ind = ind;
+	ram.palette_fade.len = len;
 	
 	//White for 22 frames
 	for (int i = 0; i < 22; i++)
 	{
-		vbla_routine = 0x12;
+		ram.vbla_routine = 0x12;
 		WaitForVBla();
 		WhiteOut_ToWhite();
 		RunPLC();
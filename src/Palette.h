@@ -1,5 +1,7 @@
 #pragma once
 
+#include "RAM.h"
+
 #include <stdint.h>
 
 //Palette types
@@ -27,21 +29,6 @@ typedef enum
 	PalId_Ending,
 } PaletteId;
 
-typedef struct
-{
-	uint8_t ind, len;
-} PaletteFade;
-
-//Palette globals
-extern int16_t pal_chgspeed;
-
-extern uint16_t dry_palette[4][16];
-extern uint16_t dry_palette_dup[4][16];
-extern uint16_t wet_palette[4][16];
-extern uint16_t wet_palette_dup[4][16];
-
-extern PaletteFade palette_fade;
-
 //Palette interface
 void PalLoad1(PaletteId id);
 void PalLoad2(PaletteId id);
@@ -4,10 +4,6 @@
 #include "Palette.h"
 #include "Level.h"
 
-//Palette cycle state
-int16_t pcyc_num, pcyc_time;
-uint16_t pcyc_buffer[0x18];
-
 //Palette cycles
 static ALIGNED2 const uint8_t pal_sega1[] = {
 	#include "Resource/Palette/Sega1.h"
@@ -29,15 +25,15 @@ signed int PCycle_Sega()
 	const uint8_t *from;
 	int16_t pal_num, pal_len;
 	
-	if (!(pcyc_time & 0x00FF))
+	if (!(ram.pcyc_time & 0x00FF))
 	{
 		//Get palette pointers to use
-		to = &dry_palette[1][0];
+		to = &ram.dry_palette[1][0];
 		from = pal_sega1;
 		
 		//Get area of palette to copy, clipping at 0
 		pal_len = 6;
-		pal_num = pcyc_num;
+		pal_num = ram.pcyc_num;
 		
 		while (pal_num < 0)
 		{
@@ -50,9 +46,9 @@ signed int PCycle_Sega()
 		to += pal_num >> 1;
 		while (pal_len-- > 0)
 		{
-			if (!((to - &dry_palette[1][0]) & 0xF))
+			if (!((to - &ram.dry_palette[1][0]) & 0xF))
 				to++;
-			if ((to - &dry_palette[0][0]) < 0x40)
+			if ((to - &ram.dry_palette[0][0]) < 0x40)
 			{
 				*to++ = (from[0] << 8) | (from[1] << 0);
 				from += 2;
@@ -62,37 +58,37 @@ signed int PCycle_Sega()
 		}
 		
 		//Handle cycle timer
-		if (!((pal_num = pcyc_num + 2) & 0x1E))
+		if (!((pal_num = ram.pcyc_num + 2) & 0x1E))
 			pal_num += 2;
 		
 		if (pal_num >= 0x64)
 		{
-			pcyc_time = 0x0401;
+			ram.pcyc_time = 0x0401;
 			pal_num = -0xC;
 		}
 		
-		pcyc_num = pal_num;
+		ram.pcyc_num = pal_num;
 		
 		return 1;
 	}
 	else
 	{
 		//Palette timer
-		pcyc_time = (((uint8_t)(pcyc_time >> 8) - 1) << 8) | (pcyc_time & 0x00FF);
-		if (!(pcyc_time & 0x8000))
+		ram.pcyc_time = (((uint8_t)(ram.pcyc_time >> 8) - 1) << 8) | (ram.pcyc_time & 0x00FF);
+		if (!(ram.pcyc_time & 0x8000))
 			return 1;
-		pcyc_time = 0x0400 | (pcyc_time & 0x00FF);
+		ram.pcyc_time = 0x0400 | (ram.pcyc_time & 0x00FF);
 		
 		//Get palette index
-		if ((pal_num = (pcyc_num + 0xC)) >= 0x30)
+		if ((pal_num = (ram.pcyc_num + 0xC)) >= 0x30)
 			return 0;
 		
 		//Get palette to copy
-		pcyc_num = pal_num;
+		ram.pcyc_num = pal_num;
 		from = pal_sega2 + pal_num;
 		
 		//Copy border palette
-		to = &dry_palette[0][2];
+		to = &ram.dry_palette[0][2];
 		for (size_t i = 0; i < 5; i++)
 		{
 			*to++ = (from[0] << 8) | (from[1] << 0);
@@ -100,10 +96,10 @@ signed int PCycle_Sega()
 		}
 		
 		//Copy filled palette
-		to = &dry_palette[1][0];
+		to = &ram.dry_palette[1][0];
 		for (size_t i = 0; i < (0x30 - 3); i++)
 		{
-			if (!((to - &dry_palette[1][0]) & 0xF))
+			if (!((to - &ram.dry_palette[1][0]) & 0xF))
 				to++;
 			*to++ = (from[0] << 8) | (from[1] << 0);
 		}
@@ -115,17 +111,17 @@ signed int PCycle_Sega()
 static void PCycle_Water(const uint8_t *palette)
 {
 	//Wait for cycle timer
-	if (--pcyc_time >= 0)
+	if (--ram.pcyc_time >= 0)
 		return;
 	
 	//Increment cycle
-	pcyc_time = 5;
-	pcyc_num++;
+	ram.pcyc_time = 5;
+	ram.pcyc_num++;
 	
 	//Write palette
-	uint16_t pal_num = pcyc_num & 3;
+	uint16_t pal_num = ram.pcyc_num & 3;
 	const uint8_t *from = palette + (pal_num << 3);
-	uint16_t *to = &dry_palette[2][8];
+	uint16_t *to = &ram.dry_palette[2][8];
 	for (size_t i = 0; i < 4; i++)
 	{
 		*to++ = (from[0] << 8) | (from[1] << 0);
@@ -146,7 +142,7 @@ void PCycle_SS()
 //Palette cycle function
 void PaletteCycle()
 {
-	switch (LEVEL_ZONE(level_id))
+	switch (LEVEL_ZONE(ram.level_id))
 	{
 		case ZoneId_GHZ:
 		case ZoneId_EndZ:
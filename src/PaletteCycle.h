@@ -1,10 +1,8 @@
 #pragma once
 
-#include <stdint.h>
+#include "RAM.h"
 
-//Palette cycle state
-extern int16_t pcyc_num, pcyc_time;
-extern uint16_t pcyc_buffer[0x18];
+#include <stdint.h>
 
 //Palette cycle routines
 signed int PCycle_Sega();
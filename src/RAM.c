@@ -0,0 +1,4 @@
+#include "RAM.h"
+
+//RAM arena
+ALIGNED16 RAM ram;
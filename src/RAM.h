@@ -0,0 +1,292 @@
+#pragma once
+
+#include "Types.h"
+#include "Constants.h"
+#include "Macros.h"
+#include "Object.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//RAM constants
+#define BUFFER_SPRITES_STRICT 0x50
+#ifdef SCP_EXTENDED_OBJECTS
+	#define BUFFER_SPRITES 0x80 //As many as the sprite table can link, and fit below the horizontal scroll table
+#else
+	#define BUFFER_SPRITES BUFFER_SPRITES_STRICT
+#endif
+
+#define SONIC_DPLC_SIZE 0x2E0
+
+#define SS_SRCDIM 64
+#define SS_DIM 128
+
+//RAM types
+typedef struct
+{
+	uint8_t frame;
+	int8_t time;
+} LevelAnim;
+
+typedef struct
+{
+	uint16_t direction;
+	uint16_t state[16][2];
+} Oscillatory;
+
+typedef struct
+{
+	uint8_t pad, min, sec, frame;
+} LevelTime;
+
+typedef struct
+{
+	uint8_t ind, len;
+} PaletteFade;
+
+typedef struct
+{
+	const uint8_t *art;
+	size_t off;
+} PLC;
+
+typedef struct NemesisState
+{
+	const uint8_t *source; // a0
+	uint8_t *dictionary;   // a1
+	bool xor_mode;         // a3
+	bool vram_mode;        // a3
+	bool raw_mode;
+	uint8_t *destination;  // a4
+	uint16_t remaining;    // a5
+	uint8_t d0;            // d0
+	uint8_t d1;            // d1
+	uint32_t d2;           // d2
+	uint16_t d3;           // d3
+	uint32_t d4;           // d4
+	uint16_t d5;           // d5
+	uint16_t d6;           // d6
+} NemesisState;
+
+typedef struct
+{
+	uint16_t x;     //X position
+	uint16_t w1;    //Y position and flip flags
+	uint8_t b4;     //Object type and respawn flag
+	uint8_t subtype;
+} OPLEntry;
+
+#ifdef SCP_RING_MANAGER
+	#define RING_PARTICLES 0x40
+	
+	typedef struct
+	{
+		int32_t x[RING_PARTICLES], y[RING_PARTICLES]; //Position (16.16 fixed point)
+		int16_t xsp[RING_PARTICLES], ysp[RING_PARTICLES]; //Speed
+		uint8_t phase[RING_PARTICLES];     //Frame phase of the floor checks
+		uint8_t on_screen[RING_PARTICLES]; //Set if the particle was drawn last frame
+		uint16_t num;
+	} RingParticles;
+#endif
+
+//RAM arena
+//Everything the game keeps across frames lives here, so that savestates (and anything else that wants the whole machine state) are a single copy
+//Game code accesses it directly as ram.x
+//The sections follow the order of the original's 68k RAM map, but not its addresses or sizes
+typedef struct
+{
+	//General buffer (level chunks)
+	ALIGNED4 uint8_t buffer0000[0xA400];
+	
+	//Level layout
+	uint8_t level_layout[8][2][0x40];
+	
+	//Background scroll buffer
+	ALIGNED4 uint8_t bgscroll_buffer[0x200];
+	
+	//Nemesis decompression buffer
+	uint8_t nemesis_buffer[0x200];
+	
+	//Sprite queue
+	SpriteQueue sprite_queue[8];
+	
+	//Level blocks
+	ALIGNED2 uint8_t level_map16[0x1800];
+	
+	//Sonic's graphics buffer and position tracking
+	uint8_t sgfx_buffer[SONIC_DPLC_SIZE];
+	int16_t track_sonic[0x40][2];
+	
+	//Horizontal scroll buffer
+	int16_t hscroll_buffer[SCREEN_HEIGHT][2];
+	
+	//Objects
+	Object objects[OBJECTS];
+	int ExecuteObjects_i;
+	uint32_t objects_used[(LEVEL_OBJECTS + 31) / 32]; //Occupied level object slots
+	
+	//Game state
+	uint8_t gamemode; //MSB acts as a title card flag
+	uint8_t jpad2_hold,  jpad2_press; //Joypad 2 state
+	uint8_t jpad1_hold1, jpad1_press1; //Joypad 1 state
+	uint8_t jpad1_hold2, jpad1_press2; //Sonic controls
+	
+	uint8_t vbla_routine;
+	uint8_t sprite_count;
+	uint8_t hbla_pal;
+	int16_t hbla_pos;
+	int16_t vid_scrpos_y_dup, vid_bg_scrpos_y_dup, vid_scrpos_x_dup, vid_bg_scrpos_x_dup, vid_bg3_scrpos_y_dup, vid_bg3_scrpos_x_dup;
+	
+	int16_t pcyc_num, pcyc_time;
+	dword_u random_seed;
+	uint16_t pause;
+	uint16_t demo_length;
+	
+	int16_t wtr_pos1, wtr_pos2, wtr_pos3;
+	uint8_t water;
+	uint8_t wtr_routine;
+	uint8_t wtr_state;
+	
+	PaletteFade palette_fade;
+	int16_t pal_chgspeed;
+	uint16_t pcyc_buffer[0x18];
+	
+	//Pattern load cues
+	PLC plc_buffer[16];
+	NemesisState plc_buffer_regs;
+	uint16_t plc_buffer_reg18;
+	uint16_t plc_buffer_reg1A;
+	
+	//Level scrolling
+	dword_s scrpos_x,     scrpos_y,     bg_scrpos_x,     bg_scrpos_y,     bg2_scrpos_x,     bg2_scrpos_y,     bg3_scrpos_x,     bg3_scrpos_y;
+	
+	uint16_t limit_left1, limit_right1, limit_top1, limit_btm1;
+	uint16_t limit_left2, limit_right2, limit_top2, limit_btm2;
+	uint16_t limit_left3;
+	
+	int16_t scrshift_x, scrshift_y;
+	int16_t look_shift;
+	uint8_t dle_routine;
+	uint8_t nobgscroll, bgscrollvert;
+	
+	uint8_t fg_xblock, bg1_xblock, bg2_xblock, bg3_xblock;
+	uint8_t fg_yblock, bg1_yblock, bg2_yblock, bg3_yblock;
+	
+	uint16_t fg_scroll_flags, bg1_scroll_flags, bg2_scroll_flags, bg3_scroll_flags;
+	
+	int16_t sonspeed_max, sonspeed_acc, sonspeed_dec;
+	uint8_t sonframe_num, sonframe_chg;
+	uint8_t angle_buffer[2]; //Angles found by the last pair of sensors
+	
+	uint16_t opl_routine;
+	int16_t opl_screen;
+	const OPLEntry *opl_ptr0;
+	const OPLEntry *opl_ptr4;
+	const uint8_t *opl_ptr8;
+	const uint8_t *opl_ptrC;
+	const OPLEntry *opl_layout;
+	#ifdef SCP_RING_MANAGER
+		const OPLEntry *ring_layout;    //Layout the ring manager's rings were loaded from (NULL if none)
+		uint16_t ring_left, ring_right; //Ring manager's visible window
+		RingParticles ring_particles;   //Scattered rings
+	#endif
+	
+	word_u ss_angle;
+	uint16_t ss_rotate;
+	uint16_t btn_pushtime1;
+	uint8_t btn_pushtime2;
+	uint16_t palss_num, palss_time;
+	const uint8_t *coll_index;
+	
+	int16_t obj31_ypos;
+	uint8_t boss_status;
+	word_u track_pos;
+	uint8_t lock_screen;
+	uint8_t level_schunks[2][2];
+	uint16_t gfx_big_ring;
+	uint8_t convey_rev;
+	uint8_t obj63[6];
+	uint8_t tunnel_mode;
+	uint8_t lock_multi;
+	uint8_t tunnel_allow;
+	uint8_t jump_only;
+	uint8_t obj6B;
+	uint8_t lock_ctrl;
+	uint8_t big_ring;
+	uint16_t item_bonus;
+	uint16_t time_bonus;
+	uint16_t ring_bonus;
+	uint8_t endact_bonus;
+	uint8_t sonicend;
+	uint16_t lz_deform;
+	uint8_t f_switch[0x10];
+	
+	LevelAnim level_anim[6];
+	int16_t scroll_block1_size, scroll_block2_size, scroll_block3_size, scroll_block4_size;
+	
+	//Sprite table buffer
+	uint16_t sprite_buffer[BUFFER_SPRITES][4]; //Apparently the last 16 entries of this intrude other memory in the original
+	
+	//Palettes
+	uint16_t wet_palette_dup[4][16];
+	uint16_t wet_palette[4][16];
+	uint16_t dry_palette[4][16];
+	uint16_t dry_palette_dup[4][16];
+	
+	//Object respawn state
+	uint8_t objstate_left;
+	uint8_t objstate_right;
+	uint8_t objstate[0x100];
+	
+	//Player and level state
+	uint16_t restart;
+	uint16_t frame_count;
+	uint8_t debug_use;
+	uint8_t last_special;
+	uint8_t lives;
+	uint8_t life_count;
+	uint8_t life_num;
+	uint8_t continues;
+	uint8_t time_over;
+	uint8_t ring_count;
+	uint8_t time_count;
+	uint8_t score_count;
+	uint16_t rings;
+	LevelTime time;
+	uint32_t score;
+	uint8_t shield;
+	uint8_t invincibility;
+	uint8_t shoes;
+	uint8_t last_lamp;
+	uint16_t air;
+	uint32_t score_life;
+	uint16_t level_id;
+	
+	Oscillatory oscillatory;
+	LevelAnim sprite_anim[4];
+	uint16_t sprite_anim_3buf;
+	uint16_t limit_top_db, limit_btm_db;
+	
+	//Scroll duplicates
+	dword_s scrpos_x_dup, scrpos_y_dup, bg_scrpos_x_dup, bg_scrpos_y_dup, bg2_scrpos_x_dup, bg2_scrpos_y_dup, bg3_scrpos_x_dup, bg3_scrpos_y_dup;
+	uint16_t fg_scroll_flags_dup, bg1_scroll_flags_dup, bg2_scroll_flags_dup, bg3_scroll_flags_dup;
+	
+	//Game flags
+	uint8_t emeralds;
+	uint8_t emerald_list[8];
+	uint8_t demo_num;
+	uint16_t credits_num;
+	int16_t demo;
+	uint8_t credits_cheat;
+	uint8_t debug_cheat, debug_mode;
+	uint8_t dbg_ang0, dbg_ang1, dbg_ang2, dbg_ang3;
+	uint32_t vbla_count;
+	
+	//Special Stage buffers (these overlap the general buffer in the original)
+	uint8_t ss_layout[SS_DIM * SS_DIM]; //SS_DIM x SS_DIM (128x128)
+	uint8_t ss_layout_tmp[SS_SRCDIM * SS_SRCDIM]; //SS_SRCDIM x SS_SRCDIM (64x64)
+	int16_t ss_drawtable[16 * 16 * 2];
+	uint8_t ss_collected[0x100];
+} RAM;
+
+extern RAM ram;
@@ -0,0 +1,326 @@
+#include "Rollback.h"
+
+#include "State.h"
+#include "Game.h"
+#include "Level.h"
+
+#include "Backend/VDP.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//Rollback constants
+#define ROLLBACK_WINDOW  8      //Frames we're allowed to run ahead of the peer's confirmed input
+#define ROLLBACK_INPUTS  0x100  //Input history length (must be a power of 2)
+#define ROLLBACK_TIMEOUT 10000  //Milliseconds without a packet before the peer is dropped
+#define ROLLBACK_WAIT    4      //Milliseconds to wait for a packet when stalled
+
+#define ROLLBACK_PACKET_INPUTS 0xF0
+
+//Rollback state
+bool rollback_active;
+
+static NetTransport *rollback_net;
+static unsigned int rollback_player, rollback_delay;
+static bool rollback_predict; //Set while running level frames, which can be rolled back
+
+static uint32_t rollback_frame;  //Next frame to be simulated
+static uint32_t rollback_head;   //Next frame to sample local input on
+static uint32_t rollback_remote; //Remote input is confirmed for all frames before this
+static uint32_t rollback_acked;  //The peer has confirmed our input for all frames before this
+static uint32_t rollback_checked; //Predictions have been checked for all frames before this
+
+static uint8_t rollback_local[ROLLBACK_INPUTS];     //Local input by frame
+static uint8_t rollback_confirmed[ROLLBACK_INPUTS]; //Confirmed remote input by frame
+static uint8_t rollback_used[ROLLBACK_INPUTS];      //Remote input the frame was simulated with
+
+static uint32_t rollback_recv_time;
+
+//Savestates of the last few level frames
+static struct
+{
+	uint32_t frame;
+	void *state;
+} rollback_states[ROLLBACK_WINDOW + 1];
+
+//Rollback statistics
+static unsigned long rollback_stat_frames, rollback_stat_rollbacks, rollback_stat_resim, rollback_stat_stalls;
+static unsigned int rollback_stat_depth;
+static uint32_t rollback_stat_time;
+
+//Packets
+//Both peers send their local input for every frame the other hasn't confirmed yet, so lost datagrams are covered by the next one
+//u32 first frame, u32 ack (remote frames received), u8 count, u8 input[count]
+static void Rollback_Write32(uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)(v >> 0);
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t Rollback_Read32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void Rollback_Send()
+{
+	uint8_t packet[9 + ROLLBACK_PACKET_INPUTS];
+	uint32_t known = rollback_head + rollback_delay;
+	uint32_t count = known - rollback_acked;
+	if (count > ROLLBACK_PACKET_INPUTS)
+		count = ROLLBACK_PACKET_INPUTS;
+	
+	Rollback_Write32(&packet[0], rollback_acked);
+	Rollback_Write32(&packet[4], rollback_remote);
+	packet[8] = (uint8_t)count;
+	for (uint32_t i = 0; i < count; i++)
+		packet[9 + i] = rollback_local[(rollback_acked + i) & (ROLLBACK_INPUTS - 1)];
+	
+	rollback_net->send(rollback_net, packet, 9 + count);
+}
+
+static void Rollback_Poll(int timeout)
+{
+	uint8_t packet[9 + ROLLBACK_PACKET_INPUTS];
+	long got;
+	while ((got = rollback_net->recv(rollback_net, packet, sizeof(packet), timeout)) > 0)
+	{
+		timeout = 0;
+		if (got < 9 || got < 9 + packet[8])
+			continue;
+		rollback_recv_time = Net_Ticks();
+		
+		//Update what the peer has confirmed
+		uint32_t ack = Rollback_Read32(&packet[4]);
+		if ((int32_t)(ack - rollback_acked) > 0 && (int32_t)(ack - (rollback_head + rollback_delay)) <= 0)
+			rollback_acked = ack;
+		
+		//Take any new input that follows on from what we already have
+		uint32_t first = Rollback_Read32(&packet[0]);
+		if ((int32_t)(first - rollback_remote) > 0)
+			continue;
+		for (uint32_t i = rollback_remote - first; i < packet[8]; i++)
+			rollback_confirmed[rollback_remote++ & (ROLLBACK_INPUTS - 1)] = packet[9 + i];
+	}
+}
+
+static void Rollback_Disconnect()
+{
+	puts("Rollback: Peer timed out, continuing alone");
+	rollback_active = false;
+}
+
+//Waits until the remote input for every frame before 'frame' is confirmed
+static void Rollback_Wait(uint32_t frame)
+{
+	Rollback_Poll(0);
+	if ((int32_t)(rollback_remote - frame) >= 0)
+		return;
+	
+	rollback_stat_stalls++;
+	while (rollback_active && (int32_t)(rollback_remote - frame) < 0)
+	{
+		Rollback_Send();
+		Rollback_Poll(ROLLBACK_WAIT);
+		if ((Net_Ticks() - rollback_recv_time) > ROLLBACK_TIMEOUT)
+			Rollback_Disconnect();
+	}
+}
+
+//Returns the first frame that was simulated with a mispredicted remote input, or 'rollback_frame' if there's none
+static uint32_t Rollback_Check()
+{
+	uint32_t end = ((int32_t)(rollback_remote - rollback_frame) < 0) ? rollback_remote : rollback_frame;
+	for (; rollback_checked != end; rollback_checked++)
+		if (rollback_used[rollback_checked & (ROLLBACK_INPUTS - 1)] != rollback_confirmed[rollback_checked & (ROLLBACK_INPUTS - 1)])
+			return rollback_checked;
+	return rollback_frame;
+}
+
+static void Rollback_SaveState()
+{
+	static size_t slot;
+	slot = (slot + 1) % (ROLLBACK_WINDOW + 1);
+	rollback_states[slot].frame = rollback_frame;
+	State_Save(rollback_states[slot].state);
+}
+
+//Loads the state from before 'from' and simulates the frames up to the current frame again, with corrected input
+//Returns true if a frame couldn't continue (level restart or gamemode change), the timeline is then cut short there
+static bool Rollback_Resimulate(uint32_t from, bool (*frame)(), bool *result)
+{
+	//Find the latest savestate from before the frame (a level frame can read input more than once, e.g. when paused)
+	size_t slot = ROLLBACK_WINDOW + 1;
+	for (size_t i = 0; i < ROLLBACK_WINDOW + 1; i++)
+	{
+		if (rollback_states[i].frame == UINT32_MAX || (int32_t)(from - rollback_states[i].frame) < 0)
+			continue;
+		if (slot == ROLLBACK_WINDOW + 1 || (int32_t)(rollback_states[i].frame - rollback_states[slot].frame) > 0)
+			slot = i;
+	}
+	if (slot == ROLLBACK_WINDOW + 1 || (rollback_frame - rollback_states[slot].frame) > ROLLBACK_INPUTS / 2)
+	{
+		printf("Rollback: No savestate for frame %lu, desynced\n", (unsigned long)from);
+		rollback_checked = from + 1;
+		return false;
+	}
+	from = rollback_states[slot].frame;
+	
+	//Load state
+	uint32_t to = rollback_frame;
+	State_Load(rollback_states[slot].state);
+	rollback_frame = from;
+	
+	rollback_stat_rollbacks++;
+	if ((to - from) > rollback_stat_depth)
+		rollback_stat_depth = to - from;
+	
+	//Simulate frames again (hidden)
+	VDP_SetFrameFlags(0);
+	
+	bool stop = false;
+	while ((int32_t)(rollback_frame - to) < 0)
+	{
+		Rollback_SaveState();
+		rollback_stat_resim++;
+		if ((*result = frame()) || ram.restart || ram.gamemode != GameMode_Level)
+		{
+			stop = true;
+			break;
+		}
+	}
+	
+	//Everything up to the peer's input has now been simulated with confirmed input
+	rollback_checked = ((int32_t)(rollback_remote - rollback_frame) < 0) ? rollback_remote : rollback_frame;
+	VDP_SetFrameFlags(VDP_FRAME_DRAW | VDP_FRAME_EVENTS);
+	return stop;
+}
+
+//Rollback interface
+//'player' 0 controls joypad 1 and 1 controls joypad 2, both peers run the same game
+//'delay' frames of input delay cut down on how often frames have to be rolled back
+int Rollback_Open(NetTransport *net, unsigned int player, unsigned int delay)
+{
+	//Allocate savestates
+	for (size_t i = 0; i < ROLLBACK_WINDOW + 1; i++)
+	{
+		rollback_states[i].frame = UINT32_MAX;
+		if ((rollback_states[i].state = malloc(State_Size())) == NULL)
+		{
+			puts("Rollback_Open: Failed to allocate savestates");
+			Rollback_Close();
+			return -1;
+		}
+	}
+	
+	//Initialize session
+	rollback_net = net;
+	rollback_player = player;
+	rollback_delay = (delay < ROLLBACK_INPUTS / 2) ? delay : (ROLLBACK_INPUTS / 2);
+	rollback_frame = rollback_head = 0;
+	rollback_remote = rollback_acked = rollback_checked = 0;
+	memset(rollback_local, 0, sizeof(rollback_local));
+	rollback_recv_time = Net_Ticks();
+	rollback_active = true;
+	return 0;
+}
+
+void Rollback_Close()
+{
+	if (rollback_net != NULL)
+	{
+		printf("Rollback: %lu frames, %lu stalls, %lu rollbacks (%lu frames resimulated, %u deepest), %lums slowest frame\n",
+			rollback_stat_frames, rollback_stat_stalls, rollback_stat_rollbacks, rollback_stat_resim, rollback_stat_depth, (unsigned long)rollback_stat_time);
+		rollback_net->close(rollback_net);
+		rollback_net = NULL;
+	}
+	for (size_t i = 0; i < ROLLBACK_WINDOW + 1; i++)
+	{
+		free(rollback_states[i].state);
+		rollback_states[i].state = NULL;
+	}
+	rollback_active = false;
+}
+
+//Called when the game reads the joypads, replaces their state with the session's input for this frame
+void Rollback_Input(uint8_t *state1, uint8_t *state2)
+{
+	if (!rollback_active)
+		return;
+	
+	uint32_t frame = rollback_frame++;
+	
+	//Sample local input, it's used 'rollback_delay' frames from now
+	if (frame == rollback_head)
+	{
+		rollback_local[(rollback_head + rollback_delay) & (ROLLBACK_INPUTS - 1)] = *state1;
+		rollback_head++;
+		Rollback_Send();
+	}
+	
+	//Get remote input, predicting it from the last confirmed input if we're allowed to
+	if (!rollback_predict)
+		Rollback_Wait(frame + 1);
+	else
+		Rollback_Poll(0);
+	
+	uint8_t remote;
+	if ((int32_t)(frame - rollback_remote) < 0)
+		remote = rollback_confirmed[frame & (ROLLBACK_INPUTS - 1)];
+	else if (rollback_remote != 0)
+		remote = rollback_confirmed[(rollback_remote - 1) & (ROLLBACK_INPUTS - 1)];
+	else
+		remote = 0;
+	rollback_used[frame & (ROLLBACK_INPUTS - 1)] = remote;
+	
+	if (!rollback_predict)
+		rollback_checked = rollback_frame;
+	
+	//Give input to the joypads
+	uint8_t local = rollback_local[frame & (ROLLBACK_INPUTS - 1)];
+	*state1 = (rollback_player == 0) ? local : remote;
+	*state2 = (rollback_player == 0) ? remote : local;
+}
+
+//Runs a level frame, rolling back and simulating earlier frames again first if their remote input was mispredicted
+//'frame' runs a single frame, and returns true if the level restarted
+bool Rollback_Frame(bool (*frame)())
+{
+	uint32_t start = Net_Ticks();
+	bool result = false;
+	rollback_predict = true;
+	rollback_stat_frames++;
+	
+	//Stall if we're too far ahead of the peer
+	Rollback_Wait(rollback_frame - ROLLBACK_WINDOW + 1);
+	
+	//Roll back mispredicted frames
+	uint32_t mispredict = Rollback_Check();
+	if (mispredict != rollback_frame && Rollback_Resimulate(mispredict, frame, &result))
+	{
+		//The corrected timeline left the level, show the last frame again
+		VDP_Present();
+	}
+	else
+	{
+		//Run frame
+		Rollback_SaveState();
+		result = frame();
+		
+		//Everything has to be confirmed before leaving the level, as frames outside of it can't be rolled back
+		if (result || ram.restart || ram.gamemode != GameMode_Level)
+		{
+			Rollback_Wait(rollback_frame);
+			if ((mispredict = Rollback_Check()) != rollback_frame)
+				Rollback_Resimulate(mispredict, frame, &result);
+		}
+	}
+	
+	rollback_predict = false;
+	if ((Net_Ticks() - start) > rollback_stat_time)
+		rollback_stat_time = Net_Ticks() - start;
+	return result;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Backend/Net.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Rollback globals
+extern bool rollback_active;
+
+//Rollback interface
+int Rollback_Open(NetTransport *net, unsigned int player, unsigned int delay);
+void Rollback_Close();
+void Rollback_Input(uint8_t *state1, uint8_t *state2);
+bool Rollback_Frame(bool (*frame)());
@@ -0,0 +1,56 @@
+#include "RunAhead.h"
+
+#include "State.h"
+
+#include "Backend/VDP.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//Run-ahead state
+unsigned int runahead_frames; //Frames to run ahead of the real frame (0 to disable)
+
+static void *runahead_state;
+
+//Run-ahead interface
+//Call after a hidden real frame, runs 'runahead_frames' frames ahead with the same input, presents the last one, then restores the real state
+//'frame' runs a single frame, and returns true if the game can't continue speculating (level restart, gamemode change)
+void RunAhead(bool (*frame)(), bool speculate)
+{
+	//Allocate savestate
+	if (speculate && runahead_state == NULL && (runahead_state = malloc(State_Size())) == NULL)
+	{
+		puts("RunAhead: Failed to allocate savestate");
+		runahead_frames = 0;
+		speculate = false;
+	}
+	
+	if (speculate)
+	{
+		//Save real state
+		State_Save(runahead_state);
+		
+		//Run ahead, only the last frame is drawn
+		for (unsigned int i = 1; i <= runahead_frames; i++)
+		{
+			VDP_SetFrameFlags((i == runahead_frames) ? VDP_FRAME_DRAW : 0);
+			if (frame() && i != runahead_frames)
+			{
+				//Show the previous frame again, we can't get any further
+				VDP_Present();
+				break;
+			}
+		}
+		
+		//Restore real state
+		State_Load(runahead_state);
+	}
+	else
+	{
+		//Show the previous frame again, the real frame was hidden
+		VDP_Present();
+	}
+	
+	//Draw real frames again
+	VDP_SetFrameFlags(VDP_FRAME_DRAW | VDP_FRAME_EVENTS);
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdbool.h>
+
+//Run-ahead globals
+extern unsigned int runahead_frames;
+
+//Run-ahead interface
+void RunAhead(bool (*frame)(), bool speculate);
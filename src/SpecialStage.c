@@ -179,23 +179,6 @@ static const struct SS_SrcMapping
 	{0, map_ss_glass, TILE_MAP(0, 2, 0, 0, 0x5F0)},
 };
 
-//Special Stage state
-word_u ss_angle;
-uint16_t ss_rotate;
-uint16_t palss_num, palss_time;
-
-// uint8_t last_special;
-
-uint8_t emeralds;
-uint8_t emerald_list[8];
-
-int16_t ss_drawtable[16 * 16 * 2];
-
-uint8_t ss_collected[0x100];
-
-uint8_t ss_layout[SS_DIM * SS_DIM]; //SS_DIM x SS_DIM (128x128)
-uint8_t ss_layout_tmp[SS_SRCDIM * SS_SRCDIM]; //SS_SRCDIM x SS_SRCDIM (64x64)
-
 //Special Stage mappings
 struct SS_Mapping
 {
@@ -204,55 +187,57 @@ struct SS_Mapping
 	uint16_t tile;
 } ss_mappings[1 + SS_MAPPINGS];
 
+static MapSet *ss_map_sets[1 + SS_MAPPINGS]; //Native mappings of each ss_mappings entry
+
 //Special Stage functions
 void SS_AniWallsRings()
 {
 	//Update wall angle
-	uint8_t angle = (ss_angle.f.u >> 2) & 0xF;
+	uint8_t angle = (ram.ss_angle.f.u >> 2) & 0xF;
 	for (int i = 0; i < 36; i++)
 		ss_mappings[1 + i].frame = angle;
 	
 	//Animate rings
-	if (--sprite_anim[1].time < 0)
+	if (--ram.sprite_anim[1].time < 0)
 	{
-		sprite_anim[1].time = 7;
-		sprite_anim[1].frame = (sprite_anim[1].frame + 1) & 0x3;
+		ram.sprite_anim[1].time = 7;
+		ram.sprite_anim[1].frame = (ram.sprite_anim[1].frame + 1) & 0x3;
 	}
-	ss_mappings[58].frame = sprite_anim[1].frame;
+	ss_mappings[58].frame = ram.sprite_anim[1].frame;
 	
 	//Animate various blocks
-	if (--sprite_anim[2].time < 0)
+	if (--ram.sprite_anim[2].time < 0)
 	{
-		sprite_anim[2].time = 7;
-		sprite_anim[2].frame = (sprite_anim[2].frame + 1) & 0x1;
+		ram.sprite_anim[2].time = 7;
+		ram.sprite_anim[2].frame = (ram.sprite_anim[2].frame + 1) & 0x1;
 	}
-	ss_mappings[39].frame = sprite_anim[2].frame;
-	ss_mappings[44].frame = sprite_anim[2].frame;
-	ss_mappings[41].frame = sprite_anim[2].frame;
-	ss_mappings[42].frame = sprite_anim[2].frame;
-	ss_mappings[59].frame = sprite_anim[2].frame;
-	ss_mappings[39].frame = sprite_anim[2].frame;
-	ss_mappings[60].frame = sprite_anim[2].frame;
-	ss_mappings[61].frame = sprite_anim[2].frame;
-	ss_mappings[62].frame = sprite_anim[2].frame;
-	ss_mappings[63].frame = sprite_anim[2].frame;
+	ss_mappings[39].frame = ram.sprite_anim[2].frame;
+	ss_mappings[44].frame = ram.sprite_anim[2].frame;
+	ss_mappings[41].frame = ram.sprite_anim[2].frame;
+	ss_mappings[42].frame = ram.sprite_anim[2].frame;
+	ss_mappings[59].frame = ram.sprite_anim[2].frame;
+	ss_mappings[39].frame = ram.sprite_anim[2].frame;
+	ss_mappings[60].frame = ram.sprite_anim[2].frame;
+	ss_mappings[61].frame = ram.sprite_anim[2].frame;
+	ss_mappings[62].frame = ram.sprite_anim[2].frame;
+	ss_mappings[63].frame = ram.sprite_anim[2].frame;
 	
 	//Animate more blocks
-	if (--sprite_anim[3].time < 0)
+	if (--ram.sprite_anim[3].time < 0)
 	{
-		sprite_anim[3].time = 4;
-		sprite_anim[3].frame = (sprite_anim[3].frame + 1) & 0x3;
+		ram.sprite_anim[3].time = 4;
+		ram.sprite_anim[3].frame = (ram.sprite_anim[3].frame + 1) & 0x3;
 	}
-	ss_mappings[45].frame = sprite_anim[3].frame;
-	ss_mappings[46].frame = sprite_anim[3].frame;
-	ss_mappings[47].frame = sprite_anim[3].frame;
-	ss_mappings[48].frame = sprite_anim[3].frame;
+	ss_mappings[45].frame = ram.sprite_anim[3].frame;
+	ss_mappings[46].frame = ram.sprite_anim[3].frame;
+	ss_mappings[47].frame = ram.sprite_anim[3].frame;
+	ss_mappings[48].frame = ram.sprite_anim[3].frame;
 	
 	//Animate wall blocks
-	if (--sprite_anim[0].time < 0)
+	if (--ram.sprite_anim[0].time < 0)
 	{
-		sprite_anim[0].time = 7;
-		sprite_anim[0].frame = (sprite_anim[0].frame + 1) & 0x7;
+		ram.sprite_anim[0].time = 7;
+		ram.sprite_anim[0].frame = (ram.sprite_anim[0].frame + 1) & 0x7;
 	}
 	
 	#define BTILE0 TILE_MAP(0, 0, 0, 0, 0x142)
@@ -274,13 +259,13 @@ void SS_AniWallsRings()
 	for (int i = 0; i < 4; i++, mapping += 9)
 	{
 		for (int j = 0; j < 8; j++)
-			mapping[j].tile = block_tile[i][sprite_anim[0].frame + j];
+			mapping[j].tile = block_tile[i][ram.sprite_anim[0].frame + j];
 	}
 }
 
 void SS_AniItems()
 {
-	
+
 }
 
 void SS_ShowLayout(uint8_t sprite_i)
@@ -291,14 +276,14 @@ void SS_ShowLayout(uint8_t sprite_i)
 	
 	//Get rotation
 	int16_t sin, cos;
-	CalcSine(ss_angle.f.u & 0xFC, &sin, &cos); //Remove this AND for smooth rotation
+	CalcSine(ram.ss_angle.f.u & 0xFC, &sin, &cos); //Remove this AND for smooth rotation
 	
-	int16_t d2 = -((uint16_t)scrpos_x.f.u % 24) - 180;
-	int16_t d3 = -((uint16_t)scrpos_y.f.u % 24) - 180;
+	int16_t d2 = -((uint16_t)ram.scrpos_x.f.u % 24) - 180;
+	int16_t d3 = -((uint16_t)ram.scrpos_y.f.u % 24) - 180;
 	int16_t d4 = sin * 24;
 	int16_t d5 = cos * 24;
 	
-	int16_t *to = ss_drawtable;
+	int16_t *to = ram.ss_drawtable;
 	for (int i = 0; i < 16; i++)
 	{
 		int32_t d2b = (d2 * cos) + (d3 * -sin);
@@ -314,13 +299,13 @@ void SS_ShowLayout(uint8_t sprite_i)
 	}
 	
 	//Get layout offset
-	uint16_t ly = ((uint16_t)scrpos_y.f.u / 24) * SS_DIM;
-	uint16_t lx = (uint16_t)scrpos_x.f.u / 24;
+	uint16_t ly = ((uint16_t)ram.scrpos_y.f.u / 24) * SS_DIM;
+	uint16_t lx = (uint16_t)ram.scrpos_x.f.u / 24;
 	
 	//Draw sprites
-	uint8_t *layout = &ss_layout[lx + ly];
-	const int16_t *pos = ss_drawtable;
-	uint16_t *sprite = &sprite_buffer[sprite_i][0];
+	uint8_t *layout = &ram.ss_layout[lx + ly];
+	const int16_t *pos = ram.ss_drawtable;
+	uint16_t *sprite = &ram.sprite_buffer[sprite_i][0];
 	
 	for (int i = 0; i < 16; i++, layout += SS_DIM - 16)
 	{
@@ -337,21 +322,19 @@ void SS_ShowLayout(uint8_t sprite_i)
 				{
 					//Get block mapping
 					struct SS_Mapping *mapping = &ss_mappings[block];
-					const uint8_t *mapping_ind = mapping->mapping + (mapping->frame << 1);
-					const uint8_t *mapping_data = mapping->mapping + ((mapping_ind[0] << 8) | (mapping_ind[1] << 0));
+					if (ss_map_sets[block] == NULL)
+						continue;
 					
 					//Draw block mapping
-					uint8_t pieces = *mapping_data++;
-					if (pieces)
-						BuildSpr_Normal(&sprite, &sprite_i, x, y, mapping->tile, mapping_data, pieces - 1);
+					BuildSpr_Frame(&sprite, &sprite_i, x, y, mapping->tile, ss_map_sets[block], mapping->frame, 0);
 				}
 			}
 		}
 	}
 	
 	//Terminate end of sprite list
-	sprite_count = sprite_i;
-	if (sprite_i >= BUFFER_SPRITES)
+	ram.sprite_count = sprite_i;
+	if (sprite_i >= buffer_sprites_num)
 	{
 		sprite[-3] &= 0xFF00; //Clear link byte
 	}
@@ -366,19 +349,19 @@ void SS_Load()
 {
 	SS_Load_Branch:;
 	//Get special stage to load
-	uint8_t stage = last_special;
-	if (++last_special >= 6)
-		last_special = 0;
+	uint8_t stage = ram.last_special;
+	if (++ram.last_special >= 6)
+		ram.last_special = 0;
 	
 	//Check if stage is available
-	if (emeralds != 6)
+	if (ram.emeralds != 6)
 	{
 		int i;
-		if ((i = emeralds - 1) >= 0)
+		if ((i = ram.emeralds - 1) >= 0)
 		{
 			do
 			{
-				if (emerald_list[i] == stage)
+				if (ram.emerald_list[i] == stage)
 					goto SS_Load_Branch;
 			} while (i-- > 0);
 		}
@@ -389,11 +372,11 @@ void SS_Load()
 	player->pos.l.y.f.u = ss_startpos[stage][1];
 	
 	//Read layout
-	memcpy(ss_layout_tmp, ss_layouts[stage], SS_SRCDIM * SS_SRCDIM);
+	memcpy(ram.ss_layout_tmp, ss_layouts[stage], SS_SRCDIM * SS_SRCDIM);
 	
 	//Copy layout from 64x64 temp buffer to 128x128 buffer
-	uint8_t *tol = &ss_layout[(SS_PAD2 * SS_DIM) + SS_PAD2];
-	const uint8_t *froml = ss_layout_tmp;
+	uint8_t *tol = &ram.ss_layout[(SS_PAD2 * SS_DIM) + SS_PAD2];
+	const uint8_t *froml = ram.ss_layout_tmp;
 	
 	for (int i = 0; i < SS_SRCDIM; i++)
 	{
@@ -412,8 +395,9 @@ void SS_Load()
 		tom->pad = 0;
 		tom->frame = fromm->frame;
 		tom->tile = fromm->tile;
+		ss_map_sets[1 + i] = Map_Set(fromm->mapping);
 	}
 	
 	//Clear collected array
-	memset(ss_collected, 0, sizeof(ss_collected));
+	memset(ram.ss_collected, 0, sizeof(ram.ss_collected));
 }
@@ -0,0 +1,42 @@
+#include "State.h"
+
+#include "RAM.h"
+#include "Object.h"
+#include "LevelCollision.h"
+#include "Object/Ring.h"
+
+#include "Backend/VDP.h"
+
+#include <string.h>
+
+//Savestate interface
+size_t State_Size()
+{
+	return VDP_StateSize() + sizeof(ram);
+}
+
+void State_Save(void *to)
+{
+	//Save VDP state (first, so that it's aligned)
+	VDP_SaveState(to);
+	
+	//Save game state
+	memcpy((uint8_t*)to + VDP_StateSize(), &ram, sizeof(ram));
+}
+
+void State_Load(const void *from)
+{
+	//Load VDP state
+	VDP_LoadState(from);
+	
+	//Load game state
+	memcpy(&ram, (const uint8_t*)from + VDP_StateSize(), sizeof(ram));
+	
+	//Rebuild what's derived from the game state
+	Touch_Build();
+	if (ram.coll_index != NULL)
+		LoadCollBlocks();
+	#ifdef SCP_RING_MANAGER
+		Rings_Restore();
+	#endif
+}
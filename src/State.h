@@ -0,0 +1,8 @@
+#pragma once
+
+#include <stddef.h>
+
+//Savestate interface
+size_t State_Size();
+void State_Save(void *to);
+void State_Load(const void *from);
@@ -7,18 +7,8 @@
 #include <string.h>
 
 //Video state
-uint8_t vbla_routine;
 
-uint8_t sprite_count;
-
-uint8_t hbla_pal;
-int16_t hbla_pos;
-
-int16_t vid_scrpos_y_dup, vid_bg_scrpos_y_dup, vid_scrpos_x_dup, vid_bg_scrpos_x_dup, vid_bg3_scrpos_y_dup, vid_bg3_scrpos_x_dup;
-
-uint16_t sprite_buffer[BUFFER_SPRITES][4]; //Apparently the last 16 entries of this intrude other memory in the original
                                            //... now how would I emulate that?
-int16_t hscroll_buffer[SCREEN_HEIGHT][2];
 
 //Video interface
 void VDPSetupGame()
@@ -38,10 +28,10 @@ void VDPSetupGame()
 	VDP_FillCRAM(0x0000, COLOURS);
 	
 	//Clear internal palette
-	memset(dry_palette, 0, sizeof(dry_palette));
-	memset(dry_palette_dup, 0, sizeof(dry_palette_dup));
-	memset(wet_palette, 0, sizeof(wet_palette));
-	memset(wet_palette_dup, 0, sizeof(wet_palette_dup));
+	memset(ram.dry_palette, 0, sizeof(ram.dry_palette));
+	memset(ram.dry_palette_dup, 0, sizeof(ram.dry_palette_dup));
+	memset(ram.wet_palette, 0, sizeof(ram.wet_palette));
+	memset(ram.wet_palette_dup, 0, sizeof(ram.wet_palette_dup));
 }
 
 void WaitForVBla()
@@ -59,14 +49,14 @@ void ClearScreen()
 	VDP_FillVRAM(0x00, (PLANE_WIDTH * PLANE_HEIGHT) << 1);
 	
 	//Reset screen position duplicates
-	vid_scrpos_y_dup = 0;
-	vid_bg_scrpos_y_dup = 0;
-	vid_scrpos_x_dup = 0;
-	vid_bg_scrpos_x_dup = 0;
+	ram.vid_scrpos_y_dup = 0;
+	ram.vid_bg_scrpos_y_dup = 0;
+	ram.vid_scrpos_x_dup = 0;
+	ram.vid_bg_scrpos_x_dup = 0;
 	
 	//Clear sprite buffer and hscroll buffer
-	memset(sprite_buffer, 0, sizeof(sprite_buffer));
-	memset(hscroll_buffer, 0, sizeof(hscroll_buffer));
+	memset(ram.sprite_buffer, 0, sizeof(ram.sprite_buffer));
+	memset(ram.hscroll_buffer, 0, sizeof(ram.hscroll_buffer));
 }
 
 void CopyTilemap(const uint8_t *tilemap, size_t offset, size_t width, size_t height)